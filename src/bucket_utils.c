@@ -1,39 +1,164 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <math.h>
 #include "bucket_utils.h"
 
-// Function to initialize the BucketsArray
-void initializeBuckets(BucketsArray *bucketsArray) {
-    bucketsArray->buckets = NULL;
-    bucketsArray->bucketSizes = NULL;
-    bucketsArray->numBuckets = 0;
+#define INITIAL_BUCKET_CAPACITY 16  // Number of entries every slot can hold before it grows the first time
+
+// Function to allocate the slots of the window, every slot starts with INITIAL_BUCKET_CAPACITY entries
+static void allocateSlots(BucketsArray *bucketsArray, const int windowSize) {
+    bucketsArray->buckets = (int **)malloc(windowSize * sizeof(int *));
+    bucketsArray->bucketSizes = (int *)calloc(windowSize, sizeof(int));
+    bucketsArray->bucketCapacities = (int *)malloc(windowSize * sizeof(int));
+    if (bucketsArray->buckets == NULL || bucketsArray->bucketSizes == NULL || bucketsArray->bucketCapacities == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the buckets.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < windowSize; i++) {
+        bucketsArray->buckets[i] = (int *)malloc(INITIAL_BUCKET_CAPACITY * sizeof(int));
+        if (bucketsArray->buckets[i] == NULL) {
+            fprintf(stderr, "Error: Unable to allocate memory for the buckets.\n");
+            exit(EXIT_FAILURE);
+        }
+        bucketsArray->bucketCapacities[i] = INITIAL_BUCKET_CAPACITY;
+    }
+    bucketsArray->windowSize = windowSize;
 }
 
-// Function to resize the outer buckets array
-void resizeBuckets(BucketsArray *bucketsArray, const int newSize) {
-    bucketsArray->buckets = (int **)realloc(bucketsArray->buckets, newSize * sizeof(int *));
-    bucketsArray->bucketSizes = (int *)realloc(bucketsArray->bucketSizes, newSize * sizeof(int));
-    for (int i = bucketsArray->numBuckets; i < newSize; i++) {
-        bucketsArray->buckets[i] = NULL;    // Initialize new buckets to NULL
-        bucketsArray->bucketSizes[i] = 0;   // Initialize sizes to 0
+// Function to initialize the BucketsArray for a graph whose longest edge is max_weight
+void initializeBuckets(BucketsArray *bucketsArray, const int vertices, const float max_weight, const float delta) {
+    int windowSize = (int)ceilf(max_weight / delta) + 1;
+    if (windowSize < 2) {
+        windowSize = 2;
+    }
+    allocateSlots(bucketsArray, windowSize);
+
+    bucketsArray->nodeBucket = (int *)malloc(vertices * sizeof(int));
+    if (bucketsArray->nodeBucket == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the buckets.\n");
+        exit(EXIT_FAILURE);
     }
-    bucketsArray->numBuckets = newSize;
+    for (int i = 0; i < vertices; i++) {
+        bucketsArray->nodeBucket[i] = -1;
+    }
+    bucketsArray->currentBucket = 0;
+    bucketsArray->pendingNodes = 0;
 }
 
-// Function to add a node to a specific bucket, resizing if necessary
-void addNodeToBucket(BucketsArray *bucketsArray, const int bucketIndex, const int node_id) {
-    // Resize buckets array if needed
-    if (bucketIndex >= bucketsArray->numBuckets) {
-        resizeBuckets(bucketsArray, bucketIndex + 1);
+// Function to empty all buckets so the BucketsArray can be used for another search, the slots keep their memory
+void resetBuckets(BucketsArray *bucketsArray, const int vertices) {
+    for (int i = 0; i < bucketsArray->windowSize; i++) {
+        bucketsArray->bucketSizes[i] = 0;
+    }
+    for (int i = 0; i < vertices; i++) {
+        bucketsArray->nodeBucket[i] = -1;
     }
+    bucketsArray->currentBucket = 0;
+    bucketsArray->pendingNodes = 0;
+}
 
-    // Get the current size of the bucket
-    int currentSize = bucketsArray->bucketSizes[bucketIndex];
+// Function to enlarge the window if a bucket lies beyond it, which only rounding of the distances can cause.
+// The slots are moved so every bucket ends up at its index modulo the new window size.
+static void growWindow(BucketsArray *bucketsArray, const int bucketIndex) {
+    const int oldSize = bucketsArray->windowSize;
+    int newSize = oldSize * 2;
+    if (newSize < bucketIndex - bucketsArray->currentBucket + 1) {
+        newSize = bucketIndex - bucketsArray->currentBucket + 1;
+    }
 
-    // Resize the specific bucket to add another node
-    bucketsArray->buckets[bucketIndex] = (int *)realloc(bucketsArray->buckets[bucketIndex], (currentSize + 1) * sizeof(int));
-    bucketsArray->buckets[bucketIndex][currentSize] = node_id; // Add the new node
-    bucketsArray->bucketSizes[bucketIndex]++;  // Update the size
+    int **oldBuckets = bucketsArray->buckets;
+    int *oldSizes = bucketsArray->bucketSizes;
+    int *oldCapacities = bucketsArray->bucketCapacities;
+    allocateSlots(bucketsArray, newSize);
+
+    for (int offset = 0; offset < oldSize; offset++) {
+        const int bucket = bucketsArray->currentBucket + offset;
+        const int oldSlot = bucket % oldSize;
+        const int newSlot = bucket % newSize;
+        free(bucketsArray->buckets[newSlot]);
+        bucketsArray->buckets[newSlot] = oldBuckets[oldSlot];
+        bucketsArray->bucketSizes[newSlot] = oldSizes[oldSlot];
+        bucketsArray->bucketCapacities[newSlot] = oldCapacities[oldSlot];
+    }
+
+    free(oldBuckets);
+    free(oldSizes);
+    free(oldCapacities);
+}
+
+// Function to add a node to a specific bucket, growing the slot geometrically if necessary.
+// A node that already waits in this bucket is not added twice, an entry of the node in another bucket becomes stale.
+void addNodeToBucket(BucketsArray *bucketsArray, int bucketIndex, const int node_id) {
+    // buckets before the current one are done, their nodes belong into the current one
+    if (bucketIndex < bucketsArray->currentBucket) {
+        bucketIndex = bucketsArray->currentBucket;
+    }
+
+    const int previousBucket = bucketsArray->nodeBucket[node_id];
+    if (previousBucket == bucketIndex) {
+        return;
+    }
+    if (previousBucket == -1) {
+        bucketsArray->pendingNodes++;
+    }
+    bucketsArray->nodeBucket[node_id] = bucketIndex;
+
+    if (bucketIndex - bucketsArray->currentBucket >= bucketsArray->windowSize) {
+        growWindow(bucketsArray, bucketIndex);
+    }
+
+    // Get the slot of the bucket and double its capacity if it is full
+    const int slot = bucketIndex % bucketsArray->windowSize;
+    if (bucketsArray->bucketSizes[slot] == bucketsArray->bucketCapacities[slot]) {
+        bucketsArray->bucketCapacities[slot] *= 2;
+        bucketsArray->buckets[slot] = (int *)realloc(
+            bucketsArray->buckets[slot], bucketsArray->bucketCapacities[slot] * sizeof(int));
+        if (bucketsArray->buckets[slot] == NULL) {
+            fprintf(stderr, "Error: Unable to reallocate memory for the buckets.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    bucketsArray->buckets[slot][bucketsArray->bucketSizes[slot]++] = node_id;
+}
+
+// Function to move the nodes waiting in the current bucket into nodes and empty the bucket.
+// Stale entries are skipped, the number of nodes is returned.
+int takeBucketNodes(BucketsArray *bucketsArray, int *nodes) {
+    const int current = bucketsArray->currentBucket;
+    const int slot = current % bucketsArray->windowSize;
+
+    int count = 0;
+    for (int i = 0; i < bucketsArray->bucketSizes[slot]; i++) {
+        const int node = bucketsArray->buckets[slot][i];
+        if (bucketsArray->nodeBucket[node] == current) {
+            bucketsArray->nodeBucket[node] = -1;
+            nodes[count++] = node;
+        }
+    }
+    bucketsArray->bucketSizes[slot] = 0;  // keep the memory for the bucket that reuses this slot
+    bucketsArray->pendingNodes -= count;
+    return count;
+}
+
+// Function to move on to the next bucket that has entries, once takeBucketNodes found the current one empty.
+// Returns its index, or -1 if no node waits in any bucket anymore.
+int nextBucket(BucketsArray *bucketsArray) {
+    // empty the slot of the finished bucket, only stale entries can be left in it
+    bucketsArray->bucketSizes[bucketsArray->currentBucket % bucketsArray->windowSize] = 0;
+
+    if (bucketsArray->pendingNodes == 0) {
+        return -1;
+    }
+
+    // every waiting node lies within the window, so one pass over the slots finds the next bucket
+    for (int step = 1; step < bucketsArray->windowSize; step++) {
+        const int bucket = bucketsArray->currentBucket + step;
+        if (bucketsArray->bucketSizes[bucket % bucketsArray->windowSize] > 0) {
+            bucketsArray->currentBucket = bucket;
+            return bucket;
+        }
+    }
+    return -1;
 }
 
 // Function to free the bucket memory
@@ -42,13 +167,16 @@ void freeBuckets(BucketsArray *bucketsArray) {
         return; // Nothing to free if the pointer is NULL
     }
 
-    // Free each bucket's allocated memory
-    for (int i = 0; i < bucketsArray->numBuckets; i++) {
+    // Free each slot's allocated memory
+    for (int i = 0; i < bucketsArray->windowSize; i++) {
         free(bucketsArray->buckets[i]);
     }
 
-    // Free the array of buckets
+    // Free the array of buckets and the bookkeeping arrays
     free(bucketsArray->buckets);
+    free(bucketsArray->bucketSizes);
+    free(bucketsArray->bucketCapacities);
+    free(bucketsArray->nodeBucket);
     bucketsArray->buckets = NULL; // Set to NULL to avoid dangling pointers
 }
 
@@ -1,17 +1,26 @@
 #ifndef BUCKET_UTILS_H
 #define BUCKET_UTILS_H
 
-// Define a struct to manage dynamic buckets used in delta stepping
+// Define a struct to manage the buckets used in delta stepping.
+// Only the buckets from currentBucket to currentBucket + windowSize - 1 can hold nodes at the same time, because no
+// edge is longer than the maximum weight. They are stored in a cyclic window, bucket b lives in slot b % windowSize,
+// and the slots keep their memory when the window moves on.
 typedef struct {
-    int **buckets;  // Array of integer arrays (each array is a bucket)
-    int *bucketSizes;  // Array to store the size (number of nodes) in each bucket
-    int numBuckets;  // Number of buckets currently allocated
+    int **buckets;  // Array of integer arrays (each array is the slot of a bucket)
+    int *bucketSizes;  // Array to store the size (number of entries) in each slot
+    int *bucketCapacities;  // Array to store the allocated size of each slot
+    int windowSize;  // Number of slots, ceil(max_weight / delta) + 1
+    int currentBucket;  // Index of the bucket that is processed at the moment
+    int *nodeBucket;  // nodeBucket[i] holds the bucket node i waits in, -1 if it waits in none
+    int pendingNodes;  // Number of nodes waiting in any bucket
 } BucketsArray;
 
 // Bucket functions
-void initializeBuckets(BucketsArray *bucketsArray);
-void resizeBuckets(BucketsArray *bucketsArray, const int newSize);
-void addNodeToBucket(BucketsArray *bucketsArray, const int bucketIndex, const int node_id);
+void initializeBuckets(BucketsArray *bucketsArray, const int vertices, const float max_weight, const float delta);
+void resetBuckets(BucketsArray *bucketsArray, const int vertices);
+void addNodeToBucket(BucketsArray *bucketsArray, int bucketIndex, const int node_id);
+int takeBucketNodes(BucketsArray *bucketsArray, int *nodes);
+int nextBucket(BucketsArray *bucketsArray);
 void freeBuckets(BucketsArray *bucketsArray);
 
 // Debug functions
@@ -0,0 +1,89 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <sys/stat.h>
+
+#include "cache_utils.h"
+
+#define FNV_OFFSET_BASIS 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+
+// Function to extend a 64-bit FNV-1a hash with the given bytes, pass 0 to start a new hash
+uint64_t hashBytes(uint64_t hash, const void *data, const size_t length) {
+    if (hash == 0) {
+        hash = FNV_OFFSET_BASIS;
+    }
+    const unsigned char *bytes = data;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= FNV_PRIME;
+    }
+    return hash;
+}
+
+// Function to identify a graph by its nodes, their coordinates, the edge structure and the edge weights,
+// so preprocessed data can be matched to the graph it was built for. A node that moved changes the weights of its
+// edges, so its cached distances are not reused.
+uint64_t graphFingerprint(
+        const Node* nodes,
+        const int nodeCount,
+        const int* edges_start,
+        const int* edge_destinations,
+        const float* edge_weights,
+        const int edge_count) {
+    uint64_t hash = hashBytes(0, &nodeCount, sizeof(int));
+    hash = hashBytes(hash, &edge_count, sizeof(int));
+    for (int i = 0; i < nodeCount; i++) {
+        hash = hashBytes(hash, &nodes[i].id, sizeof(int64_t));
+        hash = hashBytes(hash, &nodes[i].lat, sizeof(float));
+        hash = hashBytes(hash, &nodes[i].lon, sizeof(float));
+    }
+    hash = hashBytes(hash, edges_start, nodeCount * sizeof(int));
+    hash = hashBytes(hash, edge_destinations, edge_count * sizeof(int));
+    hash = hashBytes(hash, edge_weights, edge_count * sizeof(float));
+    return hash;
+}
+
+// Function to create a directory if it doesn't exist yet
+static int ensureDirectory(const char *path) {
+    if (mkdir(path, 0755) != 0 && errno != EEXIST) {
+        return -1;
+    }
+    return 0;
+}
+
+// Function to build the path of a cache file and create the cache directory if needed.
+// The directory is taken from OPENPATHCL_CACHE_DIR, $XDG_CACHE_HOME/openpathcl or ~/.cache/openpathcl.
+int getCachePath(char *path, const size_t path_size, const char *prefix, const uint64_t key, const char *extension) {
+    char directory[1024];
+    const char *cache_dir = getenv("OPENPATHCL_CACHE_DIR");
+    const char *xdg_cache = getenv("XDG_CACHE_HOME");
+    const char *home = getenv("HOME");
+
+    if (cache_dir != NULL && cache_dir[0] != '\0') {
+        snprintf(directory, sizeof(directory), "%s", cache_dir);
+    } else if (xdg_cache != NULL && xdg_cache[0] != '\0') {
+        snprintf(directory, sizeof(directory), "%s/openpathcl", xdg_cache);
+        ensureDirectory(xdg_cache);
+    } else if (home != NULL && home[0] != '\0') {
+        char parent[1024];
+        snprintf(parent, sizeof(parent), "%s/.cache", home);
+        ensureDirectory(parent);
+        snprintf(directory, sizeof(directory), "%s/openpathcl", parent);
+    } else {
+        return -1;
+    }
+
+    if (ensureDirectory(directory) != 0) {
+        fprintf(stderr, "Error: Could not create cache directory %s.\n", directory);
+        return -1;
+    }
+
+    const int written = snprintf(path, path_size, "%s/%s_%016llx.%s",
+                                 directory, prefix, (unsigned long long) key, extension);
+    if (written < 0 || (size_t) written >= path_size) {
+        return -1;
+    }
+    return 0;
+}
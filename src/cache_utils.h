@@ -0,0 +1,22 @@
+#ifndef CACHE_UTILS_H
+#define CACHE_UTILS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "graph_utils.h"  // For Node struct
+
+// Hash functions
+uint64_t hashBytes(uint64_t hash, const void *data, const size_t length);
+uint64_t graphFingerprint(
+    const Node* nodes,
+    const int nodeCount,
+    const int* edges_start,
+    const int* edge_destinations,
+    const float* edge_weights,
+    const int edge_count);
+
+// Cache file functions
+int getCachePath(char *path, const size_t path_size, const char *prefix, const uint64_t key, const char *extension);
+
+#endif //CACHE_UTILS_H
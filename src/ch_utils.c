@@ -0,0 +1,681 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>  // For FLT_MAX
+
+#include "ch_utils.h"
+#include "heap_utils.h"  // Include MinHeap functions
+#include "task_utils.h"  // Include parallelFor function
+
+#define INF FLT_MAX
+
+#define WITNESS_SETTLE_LIMIT 500  // Maximum number of nodes a witness search settles before giving up
+#define CH_FILE_MAGIC 0x48434C4F  // "OLCH"
+#define CH_FILE_VERSION 2
+
+// Define a struct for the adjacency of a node in the remaining graph during the contraction
+typedef struct {
+    int *to;  // Neighbouring node of each edge
+    float *weight;  // Weight of each edge
+    int *middle;  // Contracted node a shortcut skips, -1 for original edges
+    int count;  // Number of edges
+    int capacity;  // Number of edges that fit into the allocated arrays
+} ChAdjacency;
+
+// Define a struct for a shortcut that has to be added when a node is contracted
+typedef struct {
+    int from;
+    int to;
+    float weight;
+} Shortcut;
+
+// Define a struct for a growing list of shortcuts
+typedef struct {
+    Shortcut *shortcuts;
+    int count;
+    int capacity;
+} ShortcutList;
+
+// Define a struct holding the reusable state of a witness search
+typedef struct {
+    float *dist;  // Tentative distances, INF for untouched nodes
+    int *touched;  // Nodes whose distance has to be reset after the search
+    int touched_count;
+    int *target_mark;  // target_mark[v] equals search_id if v is a target of the current search
+    int search_id;  // Incremented for every search, so the target marks never need to be reset
+    MinHeap heap;
+} WitnessSearch;
+
+// Define a struct holding the state of the contraction
+typedef struct {
+    int vertices;
+    ChAdjacency *adjacency;  // Remaining graph including shortcuts, contracted nodes keep their upward edges
+    char *contracted;  // contracted[v] is 1 once v is contracted
+    int *deleted_neighbors;  // Number of already contracted neighbours of each node
+    float *priority;  // Current priority of each node
+} ChBuilder;
+
+// Define a struct holding the arguments of the parallel priority calculation
+typedef struct {
+    ChBuilder *builder;
+    const int *nodes;  // Nodes whose priority has to be calculated
+    WitnessSearch *searches;  // One witness search per thread of the task pool
+    char *search_ready;  // search_ready[t] is set once thread t initialized its witness search
+} PriorityTask;
+
+// Function to add an edge to the adjacency of a node, or to shorten an existing one
+static void addAdjacency(ChAdjacency *adjacency, const int to, const float weight, const int middle) {
+    for (int i = 0; i < adjacency->count; i++) {
+        if (adjacency->to[i] == to) {
+            if (weight < adjacency->weight[i]) {
+                adjacency->weight[i] = weight;
+                adjacency->middle[i] = middle;
+            }
+            return;
+        }
+    }
+
+    if (adjacency->count >= adjacency->capacity) {
+        adjacency->capacity = adjacency->capacity > 0 ? adjacency->capacity * 2 : 4;
+        adjacency->to = realloc(adjacency->to, adjacency->capacity * sizeof(int));
+        adjacency->weight = realloc(adjacency->weight, adjacency->capacity * sizeof(float));
+        adjacency->middle = realloc(adjacency->middle, adjacency->capacity * sizeof(int));
+        if (adjacency->to == NULL || adjacency->weight == NULL || adjacency->middle == NULL) {
+            fprintf(stderr, "Error: Unable to allocate memory for the contraction.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    adjacency->to[adjacency->count] = to;
+    adjacency->weight[adjacency->count] = weight;
+    adjacency->middle[adjacency->count] = middle;
+    adjacency->count++;
+}
+
+// Function to remove the edge to a node from an adjacency
+static void removeAdjacency(ChAdjacency *adjacency, const int to) {
+    for (int i = 0; i < adjacency->count; i++) {
+        if (adjacency->to[i] == to) {
+            adjacency->count--;
+            adjacency->to[i] = adjacency->to[adjacency->count];
+            adjacency->weight[i] = adjacency->weight[adjacency->count];
+            adjacency->middle[i] = adjacency->middle[adjacency->count];
+            return;
+        }
+    }
+}
+
+// Function to add a shortcut to the list
+static void addShortcut(ShortcutList *list, const int from, const int to, const float weight) {
+    if (list->count >= list->capacity) {
+        list->capacity = list->capacity > 0 ? list->capacity * 2 : 16;
+        list->shortcuts = realloc(list->shortcuts, list->capacity * sizeof(Shortcut));
+        if (list->shortcuts == NULL) {
+            fprintf(stderr, "Error: Unable to allocate memory for shortcuts.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    list->shortcuts[list->count++] = (Shortcut) {from, to, weight};
+}
+
+// Function to allocate the state of a witness search
+static void initializeWitnessSearch(WitnessSearch *search, const int vertices) {
+    search->dist = malloc(vertices * sizeof(float));
+    search->touched = malloc(vertices * sizeof(int));
+    search->target_mark = calloc(vertices, sizeof(int));
+    if (search->dist == NULL || search->touched == NULL || search->target_mark == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the witness search.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < vertices; i++) {
+        search->dist[i] = INF;
+    }
+    search->touched_count = 0;
+    search->search_id = 0;
+    initializeHeap(&search->heap, 64);
+}
+
+// Function to free the state of a witness search
+static void freeWitnessSearch(WitnessSearch *search) {
+    free(search->dist);
+    free(search->touched);
+    free(search->target_mark);
+    freeHeap(&search->heap);
+}
+
+// Function to search the remaining graph from source without passing the contracted node.
+// The search stops once all targets are settled, max_dist is exceeded or too many nodes were settled.
+static void witnessSearch(
+        const ChBuilder *builder,
+        WitnessSearch *search,
+        const int source,
+        const int skipped,
+        const float max_dist,
+        int target_count) {
+    // Reset the distances of the previous search
+    for (int i = 0; i < search->touched_count; i++) {
+        search->dist[search->touched[i]] = INF;
+    }
+    search->touched_count = 0;
+    clearHeap(&search->heap);
+
+    search->dist[source] = 0;
+    search->touched[search->touched_count++] = source;
+    pushHeap(&search->heap, source, 0);
+
+    int settled = 0;
+    int node;
+    float key;
+    while (popHeap(&search->heap, &node, &key)) {
+        if (key > search->dist[node]) {
+            continue;  // Outdated heap entry
+        }
+        if (key > max_dist || ++settled > WITNESS_SETTLE_LIMIT) {
+            break;
+        }
+        if (search->target_mark[node] == search->search_id && --target_count == 0) {
+            break;
+        }
+
+        const ChAdjacency *adjacency = &builder->adjacency[node];
+        for (int i = 0; i < adjacency->count; i++) {
+            const int next = adjacency->to[i];
+            if (next == skipped) {
+                continue;
+            }
+            const float new_dist = key + adjacency->weight[i];
+            if (new_dist < search->dist[next]) {
+                if (search->dist[next] == INF) {
+                    search->touched[search->touched_count++] = next;
+                }
+                search->dist[next] = new_dist;
+                pushHeap(&search->heap, next, new_dist);
+            }
+        }
+    }
+}
+
+// Function to find the shortcuts the contraction of node would need.
+// Returns the priority of the node: twice the edge difference plus the number of contracted neighbours,
+// the second term spreads the contraction evenly over the graph.
+static float simulateContraction(const ChBuilder *builder, WitnessSearch *search, const int node, ShortcutList *shortcuts) {
+    const ChAdjacency *adjacency = &builder->adjacency[node];
+    int degree = 0;
+    int shortcut_count = 0;
+
+    for (int i = 0; i < adjacency->count; i++) {
+        const int from = adjacency->to[i];
+        degree++;
+
+        if (i + 1 == adjacency->count) {
+            continue;  // The last neighbour has no pair left
+        }
+
+        // The longest path over node starting at from determines how far the witness search has to go
+        search->search_id++;
+        float max_via = 0;
+        for (int j = i + 1; j < adjacency->count; j++) {
+            search->target_mark[adjacency->to[j]] = search->search_id;
+            if (adjacency->weight[j] > max_via) {
+                max_via = adjacency->weight[j];
+            }
+        }
+
+        witnessSearch(builder, search, from, node, adjacency->weight[i] + max_via, adjacency->count - i - 1);
+
+        // A shortcut is needed if no path avoiding node is as short as the path over node
+        for (int j = i + 1; j < adjacency->count; j++) {
+            const int to = adjacency->to[j];
+            const float via = adjacency->weight[i] + adjacency->weight[j];
+            if (search->dist[to] > via) {
+                shortcut_count++;
+                if (shortcuts != NULL) {
+                    addShortcut(shortcuts, from, to, via);
+                }
+            }
+        }
+    }
+
+    return (float) (2 * (shortcut_count - degree) + builder->deleted_neighbors[node]);
+}
+
+// Function to calculate the priorities of the nodes begin to end - 1 of a priority task
+static void calculatePriorities(void *context, const int begin, const int end, const int worker_id) {
+    const PriorityTask *task = context;
+    ChBuilder *builder = task->builder;
+
+    WitnessSearch *search = &task->searches[worker_id];
+    if (!task->search_ready[worker_id]) {
+        initializeWitnessSearch(search, builder->vertices);
+        task->search_ready[worker_id] = 1;
+    }
+    for (int i = begin; i < end; i++) {
+        const int node = task->nodes[i];
+        builder->priority[node] = simulateContraction(builder, search, node, NULL);
+    }
+}
+
+// Function to calculate the priorities of the given nodes, the witness searches run on the threads of the task pool.
+// The witness searches of nodes with many neighbours take much longer, which the pool balances by stealing.
+static void updatePriorities(ChBuilder *builder, const int *nodes, const int node_count) {
+    const int thread_count = taskThreadCount();
+    WitnessSearch searches[thread_count];
+    char search_ready[thread_count];
+    for (int t = 0; t < thread_count; t++) {
+        search_ready[t] = 0;
+    }
+
+    PriorityTask task = {builder, nodes, searches, search_ready};
+    parallelFor(0, node_count, 1, calculatePriorities, &task);
+
+    for (int t = 0; t < thread_count; t++) {
+        if (search_ready[t]) freeWitnessSearch(&searches[t]);
+    }
+}
+
+// Function to refill the queue with all remaining nodes after their priorities were recalculated
+static int rebuildQueue(ChBuilder *builder, MinHeap *queue, int *remaining) {
+    int remaining_count = 0;
+    for (int v = 0; v < builder->vertices; v++) {
+        if (!builder->contracted[v]) remaining[remaining_count++] = v;
+    }
+
+    updatePriorities(builder, remaining, remaining_count);
+
+    clearHeap(queue);
+    for (int i = 0; i < remaining_count; i++) {
+        pushHeap(queue, remaining[i], builder->priority[remaining[i]]);
+    }
+    return remaining_count;
+}
+
+// Function to contract all nodes in the order of their edge difference and to build the upward graph
+void buildContractionHierarchy(
+        ContractionHierarchy *ch,
+        const int vertices,
+        const int edge_count,
+        const int* edges_start,
+        const int* edge_destinations,
+        const float* edge_weights) {
+
+    ChBuilder builder;
+    builder.vertices = vertices;
+    builder.adjacency = calloc(vertices, sizeof(ChAdjacency));
+    builder.contracted = calloc(vertices, sizeof(char));
+    builder.deleted_neighbors = calloc(vertices, sizeof(int));
+    builder.priority = malloc(vertices * sizeof(float));
+    int *remaining = malloc(vertices * sizeof(int));
+    if (builder.adjacency == NULL || builder.contracted == NULL || builder.deleted_neighbors == NULL ||
+        builder.priority == NULL || remaining == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the contraction.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Copy the graph into the adjacency, dropping loops and keeping the shortest of parallel edges
+    for (int node = 0; node < vertices; node++) {
+        const int edge_end = (node == vertices - 1) ? edge_count : edges_start[node + 1];
+        for (int edge = edges_start[node]; edge < edge_end; edge++) {
+            if (edge_destinations[edge] != node) {
+                addAdjacency(&builder.adjacency[node], edge_destinations[edge], edge_weights[edge], -1);
+            }
+        }
+    }
+
+    ch->vertices = vertices;
+    ch->rank = malloc(vertices * sizeof(int));
+    if (ch->rank == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the contraction.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Calculate the initial order
+    MinHeap queue;
+    initializeHeap(&queue, vertices);
+    int remaining_count = rebuildQueue(&builder, &queue, remaining);
+    int next_update = remaining_count / 2;  // Recalculate all priorities each time the remaining graph halves
+
+    WitnessSearch search;
+    initializeWitnessSearch(&search, vertices);
+    ShortcutList shortcuts = {NULL, 0, 0};
+
+    int next_rank = 0;
+    int node;
+    float key;
+    while (popHeap(&queue, &node, &key)) {
+        if (builder.contracted[node] || key != builder.priority[node]) {
+            continue;  // Outdated queue entry
+        }
+
+        // Lazy update: the priority may have changed since neighbours were contracted
+        shortcuts.count = 0;
+        const float priority = simulateContraction(&builder, &search, node, &shortcuts);
+        if (priority > key && queue.size > 0 && priority > queue.entries[0].key) {
+            builder.priority[node] = priority;
+            pushHeap(&queue, node, priority);
+            continue;
+        }
+
+        // Contract the node and add the shortcuts between its neighbours
+        builder.contracted[node] = 1;
+        ch->rank[node] = next_rank++;
+        for (int i = 0; i < shortcuts.count; i++) {
+            const Shortcut *shortcut = &shortcuts.shortcuts[i];
+            addAdjacency(&builder.adjacency[shortcut->from], shortcut->to, shortcut->weight, node);
+            addAdjacency(&builder.adjacency[shortcut->to], shortcut->from, shortcut->weight, node);
+        }
+
+        // Remove the node from the remaining graph, its own edges now all lead to higher ranked nodes
+        const ChAdjacency *adjacency = &builder.adjacency[node];
+        for (int i = 0; i < adjacency->count; i++) {
+            removeAdjacency(&builder.adjacency[adjacency->to[i]], node);
+            builder.deleted_neighbors[adjacency->to[i]]++;
+        }
+
+        remaining_count--;
+        if (remaining_count > 0 && remaining_count <= next_update) {
+            remaining_count = rebuildQueue(&builder, &queue, remaining);
+            next_update = remaining_count / 2;
+        }
+    }
+
+    freeWitnessSearch(&search);
+    free(shortcuts.shortcuts);
+    freeHeap(&queue);
+
+    // The edges left at each node lead to higher ranked nodes and become its upward edges
+    ch->up_start = malloc((vertices + 1) * sizeof(int));
+    if (ch->up_start == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the contraction.\n");
+        exit(EXIT_FAILURE);
+    }
+    ch->up_count = 0;
+    for (int v = 0; v < vertices; v++) {
+        ch->up_start[v] = ch->up_count;
+        ch->up_count += builder.adjacency[v].count;
+    }
+    ch->up_start[vertices] = ch->up_count;
+
+    const int capacity = ch->up_count > 0 ? ch->up_count : 1;
+    ch->up_destinations = malloc(capacity * sizeof(int));
+    ch->up_weights = malloc(capacity * sizeof(float));
+    ch->up_middle = malloc(capacity * sizeof(int));
+    if (ch->up_destinations == NULL || ch->up_weights == NULL || ch->up_middle == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the contraction.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int v = 0; v < vertices; v++) {
+        int edge = ch->up_start[v];
+        const ChAdjacency *adjacency = &builder.adjacency[v];
+        for (int i = 0; i < adjacency->count; i++) {
+            ch->up_destinations[edge] = adjacency->to[i];
+            ch->up_weights[edge] = adjacency->weight[i];
+            ch->up_middle[edge] = adjacency->middle[i];
+            edge++;
+        }
+        free(adjacency->to);
+        free(adjacency->weight);
+        free(adjacency->middle);
+    }
+
+    free(builder.adjacency);
+    free(builder.contracted);
+    free(builder.deleted_neighbors);
+    free(builder.priority);
+    free(remaining);
+}
+
+// Function to find the upward edge between two nodes, it is stored at the lower ranked one
+static int findUpwardEdge(const ContractionHierarchy *ch, const int a, const int b) {
+    const int lower = ch->rank[a] < ch->rank[b] ? a : b;
+    const int upper = lower == a ? b : a;
+    for (int edge = ch->up_start[lower]; edge < ch->up_start[lower + 1]; edge++) {
+        if (ch->up_destinations[edge] == upper) {
+            return edge;
+        }
+    }
+    return -1;
+}
+
+// Function to replace the shortcuts between consecutive hierarchy nodes with the original nodes.
+// Returns the new path length.
+static int unpackPath(const ContractionHierarchy *ch, const int *hierarchy_path, const int hierarchy_length, int *path) {
+    int length = 0;
+    int stack_capacity = 64;
+    int *stack = malloc(stack_capacity * 2 * sizeof(int));
+    if (stack == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for unpacking the path.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    path[length++] = hierarchy_path[0];
+    for (int i = 0; i + 1 < hierarchy_length; i++) {
+        int stack_size = 0;
+        stack[0] = hierarchy_path[i];
+        stack[1] = hierarchy_path[i + 1];
+        stack_size++;
+
+        while (stack_size > 0) {
+            stack_size--;
+            const int from = stack[2 * stack_size];
+            const int to = stack[2 * stack_size + 1];
+            const int edge = findUpwardEdge(ch, from, to);
+            const int middle = edge == -1 ? -1 : ch->up_middle[edge];
+
+            if (middle == -1) {
+                if (length < ch->vertices) path[length++] = to;  // Original edge
+                continue;
+            }
+
+            // Replace the shortcut by its two halves, the first half is processed first
+            if (stack_size + 2 > stack_capacity) {
+                stack_capacity *= 2;
+                stack = realloc(stack, stack_capacity * 2 * sizeof(int));
+                if (stack == NULL) {
+                    fprintf(stderr, "Error: Unable to allocate memory for unpacking the path.\n");
+                    exit(EXIT_FAILURE);
+                }
+            }
+            stack[2 * stack_size] = middle;
+            stack[2 * stack_size + 1] = to;
+            stack_size++;
+            stack[2 * stack_size] = from;
+            stack[2 * stack_size + 1] = middle;
+            stack_size++;
+        }
+    }
+
+    free(stack);
+    return length;
+}
+
+// Bidirectional search in the upward graph from both the start and the destination.
+// Stores the unpacked path from start to destination and returns its length, INF if unreachable.
+float queryContractionHierarchy(
+        const ContractionHierarchy *ch,
+        const int start_index,
+        const int dest_index,
+        int *path,
+        int *path_length) {
+
+    const int vertices = ch->vertices;
+    float *dist[2];
+    int *prev[2];
+    for (int d = 0; d < 2; d++) {
+        dist[d] = malloc(vertices * sizeof(float));
+        prev[d] = malloc(vertices * sizeof(int));
+        if (dist[d] == NULL || prev[d] == NULL) {
+            fprintf(stderr, "Error: Unable to allocate memory for the query.\n");
+            exit(EXIT_FAILURE);
+        }
+        for (int i = 0; i < vertices; i++) {
+            dist[d][i] = INF;
+            prev[d][i] = -1;
+        }
+    }
+
+    // Direction 0 searches from the start, direction 1 from the destination
+    MinHeap heap[2];
+    initializeHeap(&heap[0], 256);
+    initializeHeap(&heap[1], 256);
+    dist[0][start_index] = 0;
+    dist[1][dest_index] = 0;
+    pushHeap(&heap[0], start_index, 0);
+    pushHeap(&heap[1], dest_index, 0);
+
+    float best = INF;
+    int meeting = -1;
+    while (1) {
+        // Continue with the direction whose next node is closer, stop once neither can improve the best path
+        const float top_forward = heap[0].size > 0 ? heap[0].entries[0].key : INF;
+        const float top_backward = heap[1].size > 0 ? heap[1].entries[0].key : INF;
+        if ((top_forward >= best && top_backward >= best) || (top_forward == INF && top_backward == INF)) {
+            break;
+        }
+        const int d = top_forward <= top_backward ? 0 : 1;
+
+        int node;
+        float key;
+        popHeap(&heap[d], &node, &key);
+        if (key > dist[d][node]) {
+            continue;  // Outdated heap entry
+        }
+
+        // Check if both searches met at this node
+        if (dist[1 - d][node] != INF && key + dist[1 - d][node] < best) {
+            best = key + dist[1 - d][node];
+            meeting = node;
+        }
+
+        for (int edge = ch->up_start[node]; edge < ch->up_start[node + 1]; edge++) {
+            const int next = ch->up_destinations[edge];
+            const float new_dist = key + ch->up_weights[edge];
+            if (new_dist < dist[d][next]) {
+                dist[d][next] = new_dist;
+                prev[d][next] = node;
+                pushHeap(&heap[d], next, new_dist);
+            }
+        }
+    }
+
+    *path_length = 0;
+    if (meeting != -1) {
+        // Collect the hierarchy path: start up to the meeting node, then down to the destination
+        int *hierarchy_path = malloc(vertices * sizeof(int));
+        if (hierarchy_path == NULL) {
+            fprintf(stderr, "Error: Unable to allocate memory for the query.\n");
+            exit(EXIT_FAILURE);
+        }
+        int hierarchy_length = 0;
+        for (int current = meeting; current != -1; current = prev[0][current]) {
+            hierarchy_path[hierarchy_length++] = current;
+        }
+        for (int i = 0; i < hierarchy_length / 2; i++) {
+            const int temp = hierarchy_path[i];
+            hierarchy_path[i] = hierarchy_path[hierarchy_length - 1 - i];
+            hierarchy_path[hierarchy_length - 1 - i] = temp;
+        }
+        for (int current = prev[1][meeting]; current != -1; current = prev[1][current]) {
+            hierarchy_path[hierarchy_length++] = current;
+        }
+
+        *path_length = unpackPath(ch, hierarchy_path, hierarchy_length, path);
+        free(hierarchy_path);
+    }
+
+    for (int d = 0; d < 2; d++) {
+        free(dist[d]);
+        free(prev[d]);
+        freeHeap(&heap[d]);
+    }
+    return best;
+}
+
+// Function to write the hierarchy to a file, so later queries on the same graph can skip the contraction
+int saveContractionHierarchy(const ContractionHierarchy *ch, const char *path, const uint64_t fingerprint) {
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) {
+        fprintf(stderr, "Error: Could not open %s for writing.\n", path);
+        return -1;
+    }
+
+    const int header[4] = {CH_FILE_MAGIC, CH_FILE_VERSION, ch->vertices, ch->up_count};
+    const size_t vertices = ch->vertices;
+    const size_t up_count = ch->up_count;
+    int ok = fwrite(header, sizeof(int), 4, file) == 4 &&
+             fwrite(&fingerprint, sizeof(uint64_t), 1, file) == 1 &&
+             fwrite(ch->rank, sizeof(int), vertices, file) == vertices &&
+             fwrite(ch->up_start, sizeof(int), vertices + 1, file) == vertices + 1 &&
+             fwrite(ch->up_destinations, sizeof(int), up_count, file) == up_count &&
+             fwrite(ch->up_weights, sizeof(float), up_count, file) == up_count &&
+             fwrite(ch->up_middle, sizeof(int), up_count, file) == up_count;
+
+    ok = fclose(file) == 0 && ok;
+    if (!ok) {
+        fprintf(stderr, "Error: Could not write the contraction hierarchy to %s.\n", path);
+        remove(path);
+        return -1;
+    }
+    return 0;
+}
+
+// Function to read a hierarchy written by saveContractionHierarchy, returns -1 if the file doesn't match the graph
+int loadContractionHierarchy(ContractionHierarchy *ch, const char *path, const int vertices, const uint64_t fingerprint) {
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        return -1;
+    }
+
+    int header[4];
+    uint64_t file_fingerprint;
+    if (fread(header, sizeof(int), 4, file) != 4 ||
+        fread(&file_fingerprint, sizeof(uint64_t), 1, file) != 1 ||
+        header[0] != CH_FILE_MAGIC || header[1] != CH_FILE_VERSION ||
+        header[2] != vertices || header[3] < 0 || file_fingerprint != fingerprint) {
+        fclose(file);
+        return -1;
+    }
+
+    ch->vertices = vertices;
+    ch->up_count = header[3];
+    const size_t up_count = ch->up_count;
+    const size_t capacity = up_count > 0 ? up_count : 1;
+    ch->rank = malloc(vertices * sizeof(int));
+    ch->up_start = malloc((vertices + 1) * sizeof(int));
+    ch->up_destinations = malloc(capacity * sizeof(int));
+    ch->up_weights = malloc(capacity * sizeof(float));
+    ch->up_middle = malloc(capacity * sizeof(int));
+    if (ch->rank == NULL || ch->up_start == NULL || ch->up_destinations == NULL ||
+        ch->up_weights == NULL || ch->up_middle == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the contraction hierarchy.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    const int ok = fread(ch->rank, sizeof(int), vertices, file) == (size_t) vertices &&
+                   fread(ch->up_start, sizeof(int), vertices + 1, file) == (size_t) vertices + 1 &&
+                   fread(ch->up_destinations, sizeof(int), up_count, file) == up_count &&
+                   fread(ch->up_weights, sizeof(float), up_count, file) == up_count &&
+                   fread(ch->up_middle, sizeof(int), up_count, file) == up_count;
+    fclose(file);
+
+    if (!ok) {
+        freeContractionHierarchy(ch);
+        return -1;
+    }
+    return 0;
+}
+
+// Function to free the hierarchy memory
+void freeContractionHierarchy(ContractionHierarchy *ch) {
+    if (ch == NULL) {
+        return;
+    }
+    free(ch->rank);
+    free(ch->up_start);
+    free(ch->up_destinations);
+    free(ch->up_weights);
+    free(ch->up_middle);
+    ch->rank = NULL;
+    ch->up_start = NULL;
+    ch->up_destinations = NULL;
+    ch->up_weights = NULL;
+    ch->up_middle = NULL;
+}
@@ -0,0 +1,36 @@
+#ifndef CH_UTILS_H
+#define CH_UTILS_H
+
+#include <stdint.h>
+
+// Define a struct to store a contraction hierarchy.
+// Every edge is stored once at its lower ranked end node, so the upward graph serves both search directions.
+typedef struct {
+    int vertices;  // Number of vertices in the graph
+    int up_count;  // Number of upward edges including shortcuts
+    int *rank;  // rank[v] holds the position of v in the contraction order
+    int *up_start;  // Starting index of the upward edges of each node (vertices + 1 entries)
+    int *up_destinations;  // Higher ranked end node of each upward edge
+    float *up_weights;  // Weight of each upward edge
+    int *up_middle;  // Contracted node a shortcut skips, -1 for original edges
+} ContractionHierarchy;
+
+// Contraction Hierarchy functions
+void buildContractionHierarchy(
+    ContractionHierarchy *ch,
+    const int vertices,
+    const int edge_count,
+    const int* edges_start,
+    const int* edge_destinations,
+    const float* edge_weights);
+float queryContractionHierarchy(
+    const ContractionHierarchy *ch,
+    const int start_index,
+    const int dest_index,
+    int *path,
+    int *path_length);
+int saveContractionHierarchy(const ContractionHierarchy *ch, const char *path, const uint64_t fingerprint);
+int loadContractionHierarchy(ContractionHierarchy *ch, const char *path, const int vertices, const uint64_t fingerprint);
+void freeContractionHierarchy(ContractionHierarchy *ch);
+
+#endif //CH_UTILS_H
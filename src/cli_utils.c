@@ -1,8 +1,30 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <time.h>  // For clock_gettime
+
+// Function to drop the "--name=value" arguments the program didn't extract, so they are not taken for coordinates.
+// Returns the number of remaining arguments.
+int skipUnknownOptions(const int argc, char* argv[]) {
+    int count = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--", 2) == 0 && strchr(argv[i], '=') != NULL) {
+            fprintf(stderr, "Ignoring unknown option '%s'\n", argv[i]);
+            continue;
+        }
+        argv[count++] = argv[i];
+    }
+    if (count < argc) {
+        argv[count] = NULL;
+    }
+    return count;
+}
 
 // Function to parse command-line arguments
-int parseArguments(const int argc, char* argv[], float start[2], float dest[2], float** bbox, int* bbox_size) {
+int parseArguments(int argc, char* argv[], float start[2], float dest[2], float** bbox, int* bbox_size) {
+    argc = skipUnknownOptions(argc, argv);
+
     // Check for the required number of arguments
     if (argc < 10 || (argc - 6) % 2 != 1) {
         fprintf(stderr, "Invalid Arguments\n "
@@ -34,4 +56,144 @@ int parseArguments(const int argc, char* argv[], float start[2], float dest[2],
     }
 
     return 0; // Successful parsing
-}
\ No newline at end of file
+}
+// Function to parse command-line arguments that only hold the bounding box, for the modes without start and destination
+int parseBoundingBox(int argc, char* argv[], float** bbox, int* bbox_size) {
+    *bbox = NULL;
+    argc = skipUnknownOptions(argc, argv);
+
+    // Check for at least three (lat, lon) pairs
+    if (argc < 7 || (argc - 1) % 2 != 0) {
+        fprintf(stderr, "Invalid Arguments\n "
+                        "Usage: bbox_lat1 bbox_lon1 bbox_lat2 bbox_lon2 bbox_lat3 bbox_lon3 ...\n");
+        return -1; // Indicate an error
+    }
+
+    *bbox_size = argc - 1;
+    *bbox = (float*)malloc(*bbox_size * sizeof(float));
+    if (*bbox == NULL) {
+        fprintf(stderr, "Memory allocation failed for bounding box.\n");
+        return -1; // Indicate an error
+    }
+    for (int i = 0; i < *bbox_size; ++i) {
+        (*bbox)[i] = strtof(argv[1 + i], NULL);
+    }
+    return 0;
+}
+
+// Function to parse a list of points written as "lat,lon;lat,lon;...", the coordinates are stored as pairs
+int parsePoints(const char* list, float** points, int* point_count) {
+    *points = NULL;
+    *point_count = 0;
+    if (list == NULL || *list == '\0') {
+        fprintf(stderr, "Invalid point list, expected lat,lon;lat,lon;...\n");
+        return -1;
+    }
+
+    // every point is separated by a semicolon
+    int capacity = 1;
+    for (const char* c = list; *c != '\0'; c++) {
+        if (*c == ';') capacity++;
+    }
+    *points = malloc(2 * capacity * sizeof(float));
+    if (*points == NULL) {
+        fprintf(stderr, "Memory allocation failed for points.\n");
+        return -1;
+    }
+
+    const char* position = list;
+    while (*position != '\0') {
+        char* end;
+        const float lat = strtof(position, &end);
+        if (end == position || *end != ',') {
+            break;
+        }
+        position = end + 1;
+        const float lon = strtof(position, &end);
+        if (end == position || (*end != ';' && *end != '\0')) {
+            break;
+        }
+        (*points)[2 * *point_count] = lat;
+        (*points)[2 * *point_count + 1] = lon;
+        (*point_count)++;
+        position = *end == ';' ? end + 1 : end;
+    }
+
+    if (*position != '\0' || *point_count == 0) {
+        fprintf(stderr, "Invalid point list '%s', expected lat,lon;lat,lon;...\n", list);
+        free(*points);
+        *points = NULL;
+        *point_count = 0;
+        return -1;
+    }
+    return 0;
+}
+
+// Function to read an optional "--name=value" argument and remove it from argv, so the positional arguments stay intact.
+// If the argument is missing the environment variable OPENPATHCL_<NAME> is used instead, NULL if neither is set.
+const char* extractOption(int* argc, char* argv[], const char* name) {
+    const size_t name_length = strlen(name);
+    const char* value = NULL;
+
+    // look for the option on the command line
+    for (int i = 1; i < *argc; i++) {
+        if (strncmp(argv[i], "--", 2) == 0 &&
+            strncmp(argv[i] + 2, name, name_length) == 0 &&
+            argv[i][2 + name_length] == '=') {
+            value = argv[i] + 3 + name_length;
+
+            // shift the remaining arguments to the front
+            for (int j = i; j < *argc - 1; j++) {
+                argv[j] = argv[j + 1];
+            }
+            (*argc)--;
+            argv[*argc] = NULL;
+            return value;
+        }
+    }
+
+    // fall back to the environment, OPENPATHCL_ followed by the upper case name
+    char variable[64];
+    snprintf(variable, sizeof(variable), "OPENPATHCL_%s", name);
+    for (char* c = variable; *c != '\0'; c++) {
+        *c = (char) toupper((unsigned char) *c);
+    }
+    value = getenv(variable);
+    if (value != NULL && value[0] == '\0') {
+        value = NULL;
+    }
+    return value;
+}
+
+// Function to get the elapsed wall-clock time in milliseconds, clock() would add up the time of all threads
+double wallTimeMs(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double) now.tv_sec * 1000 + (double) now.tv_nsec / 1000000;
+}
+
+// Function to read a positive number from an option, fallback if the option is not set or invalid
+int positiveOption(const char* option, const char* name, const int fallback) {
+    if (option != NULL) {
+        char* end;
+        const long value = strtol(option, &end, 10);
+        if (end != option && *end == '\0' && value > 0) {
+            return (int) value;
+        }
+        fprintf(stderr, "Ignoring invalid %s '%s', using %d instead\n", name, option, fallback);
+    }
+    return fallback;
+}
+
+// Function to read the number of threads from the threads option, 0 lets the task pool use one thread per core
+int threadCount(const char* option) {
+    if (option != NULL) {
+        char* end;
+        const long count = strtol(option, &end, 10);
+        if (end != option && *end == '\0' && count > 0) {
+            return (int) count;
+        }
+        fprintf(stderr, "Ignoring invalid thread count '%s', using one thread per core instead\n", option);
+    }
+    return 0;
+}
@@ -2,5 +2,14 @@
 #define CLI_UTILS_H
 
 int parseArguments(int argc, char* argv[], float start[2], float dest[2], float** bbox, int* bbox_size);
+int parseBoundingBox(int argc, char* argv[], float** bbox, int* bbox_size);
+int parsePoints(const char* list, float** points, int* point_count);
+const char* extractOption(int* argc, char* argv[], const char* name);
+int skipUnknownOptions(const int argc, char* argv[]);
+int positiveOption(const char* option, const char* name, const int fallback);
+int threadCount(const char* option);
+
+// Timing functions
+double wallTimeMs(void);
 
 #endif //CLI_UTILS_H
\ No newline at end of file
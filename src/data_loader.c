@@ -5,6 +5,7 @@
 #include <cjson/cJSON.h>
 
 #include "graph_utils.h"  // for Node and Road Struct
+#include "task_utils.h"  // Include parallelFor function
 
 // Define a struct to hold the response data
 struct MemoryStruct {
@@ -12,7 +13,82 @@ struct MemoryStruct {
     size_t size;
 };
 
-// Function to extract the Nodes from the JSON Response
+// Define a struct holding the arguments of the parallel element conversion
+typedef struct {
+    const cJSON** elements;  // The node and way elements of the response
+    const int* slots;  // slots[i] is the index of element i inside the nodes or the roads array
+    Node* nodes;
+    Road* roads;
+} ElementConversion;
+
+// Function to check if an element is a node with an ID and coordinates
+static int isNodeElement(const cJSON *element) {
+    const cJSON *type = cJSON_GetObjectItemCaseSensitive(element, "type");
+    return cJSON_IsString(type) && (strcmp(type->valuestring, "node") == 0)
+        && cJSON_IsNumber(cJSON_GetObjectItemCaseSensitive(element, "id"))
+        && cJSON_IsNumber(cJSON_GetObjectItemCaseSensitive(element, "lat"))
+        && cJSON_IsNumber(cJSON_GetObjectItemCaseSensitive(element, "lon"));
+}
+
+// Function to check if an element is a way with an ID and a list of nodes
+static int isWayElement(const cJSON *element) {
+    const cJSON *type = cJSON_GetObjectItemCaseSensitive(element, "type");
+    return cJSON_IsString(type) && (strcmp(type->valuestring, "way") == 0)
+        && cJSON_IsNumber(cJSON_GetObjectItemCaseSensitive(element, "id"))
+        && cJSON_IsArray(cJSON_GetObjectItemCaseSensitive(element, "nodes"));
+}
+
+// Function to convert the elements begin to end - 1 into their node or road
+static void convertElements(void *context, const int begin, const int end, const int worker_id) {
+    const ElementConversion *conversion = context;
+
+    for (int i = begin; i < end; i++) {
+        const cJSON *element = conversion->elements[i];
+        const cJSON *id = cJSON_GetObjectItemCaseSensitive(element, "id");
+
+        // Handle "node" elements
+        if (isNodeElement(element)) {
+            const cJSON *lat = cJSON_GetObjectItemCaseSensitive(element, "lat");
+            const cJSON *lon = cJSON_GetObjectItemCaseSensitive(element, "lon");
+
+            Node node;
+            node.id = (int64_t) id->valuedouble;
+            node.lat = (float) lat->valuedouble;
+            node.lon = (float) lon->valuedouble;
+            node.head = NULL;
+            conversion->nodes[conversion->slots[i]] = node;
+        }
+        // Handle "way" elements (Roads)
+        else {
+            const cJSON *nodesArray = cJSON_GetObjectItemCaseSensitive(element, "nodes");
+
+            Road road;
+            road.id = (int64_t) id->valuedouble;
+            road.nodeCount = cJSON_GetArraySize(nodesArray);
+
+            // Allocate memory for the node IDs in this road
+            road.nodes = (int64_t*)malloc((road.nodeCount > 0 ? road.nodeCount : 1) * sizeof(int64_t));
+            if (road.nodes == NULL) {
+                perror("Memory allocation failed for road nodes");
+                exit(EXIT_FAILURE);
+            }
+
+            int nodeIndex = 0;
+            const cJSON *nodeId = NULL;
+            cJSON_ArrayForEach(nodeId, nodesArray) {
+                if (cJSON_IsNumber(nodeId)) {
+                    road.nodes[nodeIndex] = (int64_t) nodeId->valuedouble;
+                    nodeIndex++;
+                }
+            }
+            conversion->roads[conversion->slots[i]] = road;
+        }
+    }
+}
+
+// Function to extract the Nodes from the JSON Response.
+// The elements are numbered in their order first, then converted in parallel, because the ways differ a lot in length
+// the task pool balances them by stealing.
 void parseAndStoreJSON(const char* jsonResponse, Node** nodes, int* nodeCount, Road** roads, int* roadCount) {
     // Parse the JSON response
     cJSON *root = cJSON_Parse(jsonResponse);
@@ -22,115 +98,59 @@ void parseAndStoreJSON(const char* jsonResponse, Node** nodes, int* nodeCount, R
     }
 
     *nodeCount = 0;
-    int nodeCapacity = 10;
-    *nodes = (Node*)malloc(nodeCapacity * sizeof(Node));
-    if (*nodes == NULL) {
-        perror("Initial memory allocation failed for nodes");
-        cJSON_Delete(root);
-        exit(EXIT_FAILURE);
-    }
-
     *roadCount = 0;
-    int roadCapacity = 10;
-    *roads = (Road*)malloc(roadCapacity * sizeof(Road));
-    if (*roads == NULL) {
-        perror("Initial memory allocation failed for roads");
-        free(*nodes);
-        cJSON_Delete(root);
-        exit(EXIT_FAILURE);
-    }
 
-    // Retrieve and iterate through the JSON array of elements
+    // Retrieve the JSON array of elements
     const cJSON *elements = cJSON_GetObjectItemCaseSensitive(root, "elements");
     if (!cJSON_IsArray(elements)) {
         fprintf(stderr, "\"elements\" is missing or not an array\n");
-        free(*nodes);
-        free(*roads);
         cJSON_Delete(root);
         return;
     }
 
-    cJSON *element = NULL;
-    cJSON_ArrayForEach(element, elements) {
-        const cJSON *type = cJSON_GetObjectItemCaseSensitive(element, "type");
-
-        // Handle "node" elements
-        if (cJSON_IsString(type) && (strcmp(type->valuestring, "node") == 0)) {
-            const cJSON *id = cJSON_GetObjectItemCaseSensitive(element, "id");
-            const cJSON *lat = cJSON_GetObjectItemCaseSensitive(element, "lat");
-            const cJSON *lon = cJSON_GetObjectItemCaseSensitive(element, "lon");
+    // Collect the nodes and ways and give every one its index inside the nodes or roads array
+    const int elementCount = cJSON_GetArraySize(elements);
+    const cJSON **convertible = malloc((elementCount > 0 ? elementCount : 1) * sizeof(cJSON *));
+    int *slots = malloc((elementCount > 0 ? elementCount : 1) * sizeof(int));
+    if (convertible == NULL || slots == NULL) {
+        perror("Memory allocation failed for the elements");
+        cJSON_Delete(root);
+        exit(EXIT_FAILURE);
+    }
 
-            if (cJSON_IsNumber(id) && cJSON_IsNumber(lat) && cJSON_IsNumber(lon)) {
-                Node node;
-                node.id = (int64_t) id->valuedouble;
-                node.lat = (float) lat->valuedouble;
-                node.lon = (float) lon->valuedouble;
-                node.head = NULL;
-
-                (*nodes)[*nodeCount] = node;
-                (*nodeCount)++;
-
-                // Resize the nodes array if necessary
-                if (*nodeCount >= nodeCapacity) {
-                    nodeCapacity *= 2;  // Double the size
-                    *nodes = (Node*)realloc(*nodes, nodeCapacity * sizeof(Node));
-                    if (*nodes == NULL) {
-                        perror("Memory reallocation failed for nodes");
-                        free(*roads);
-                        cJSON_Delete(root);
-                        exit(EXIT_FAILURE);
-                    }
-                }
-            }
+    int convertibleCount = 0;
+    const cJSON *element = NULL;
+    cJSON_ArrayForEach(element, elements) {
+        if (isNodeElement(element)) {
+            slots[convertibleCount] = (*nodeCount)++;
+            convertible[convertibleCount++] = element;
+        } else if (isWayElement(element)) {
+            slots[convertibleCount] = (*roadCount)++;
+            convertible[convertibleCount++] = element;
         }
-        // Handle "way" elements (Roads)
-        else if (cJSON_IsString(type) && (strcmp(type->valuestring, "way") == 0)) {
-            const cJSON *id = cJSON_GetObjectItemCaseSensitive(element, "id");
-            const cJSON *nodesArray = cJSON_GetObjectItemCaseSensitive(element, "nodes");
+    }
 
-            if (cJSON_IsNumber(id) && cJSON_IsArray(nodesArray)) {
-                Road road;
-                road.id = (int64_t) id->valuedouble;
-                road.nodeCount = cJSON_GetArraySize(nodesArray);
-
-                // Allocate memory for the node IDs in this road
-                road.nodes = (int64_t*)malloc(road.nodeCount * sizeof(int64_t));
-                if (road.nodes == NULL) {
-                    perror("Memory allocation failed for road nodes");
-                    free(*nodes);
-                    free(*roads);
-                    cJSON_Delete(root);
-                    exit(EXIT_FAILURE);
-                }
+    *nodes = (Node*)malloc((*nodeCount > 0 ? *nodeCount : 1) * sizeof(Node));
+    if (*nodes == NULL) {
+        perror("Memory allocation failed for nodes");
+        cJSON_Delete(root);
+        exit(EXIT_FAILURE);
+    }
+    *roads = (Road*)malloc((*roadCount > 0 ? *roadCount : 1) * sizeof(Road));
+    if (*roads == NULL) {
+        perror("Memory allocation failed for roads");
+        free(*nodes);
+        cJSON_Delete(root);
+        exit(EXIT_FAILURE);
+    }
 
-                int nodeIndex = 0;
-                const cJSON *nodeId = NULL;
-                cJSON_ArrayForEach(nodeId, nodesArray) {
-                    if (cJSON_IsNumber(nodeId)) {
-                        road.nodes[nodeIndex] = (int64_t) nodeId->valuedouble;
-                        nodeIndex++;
-                    }
-                }
+    // Convert the elements on the threads of the task pool
+    ElementConversion conversion = {convertible, slots, *nodes, *roads};
+    parallelFor(0, convertibleCount, 64, convertElements, &conversion);
 
-                // Add the road to the roads array
-                (*roads)[*roadCount] = road;
-                (*roadCount)++;
-
-                // Resize the roads array if necessary
-                if (*roadCount >= roadCapacity) {
-                    roadCapacity *= 2;  // Double the size
-                    *roads = (Road*)realloc(*roads, roadCapacity * sizeof(Road));
-                    if (*roads == NULL) {
-                        perror("Memory reallocation failed for roads");
-                        free(*nodes);
-                        cJSON_Delete(root);
-                        exit(EXIT_FAILURE);
-                    }
-                }
-            }
-        }
-    }
     // Clean up
+    free(convertible);
+    free(slots);
     cJSON_Delete(root);
 
     // Print results
@@ -0,0 +1,244 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>  // For FLT_MAX
+#include <limits.h>  // For INT_MAX
+
+#include "delta_utils.h"
+#include "bucket_utils.h"  // Include Bucket functions
+
+#define INF FLT_MAX
+
+#define PROBE_SETTLE_LIMIT 2048  // Number of nodes a probe settles before its cost is compared
+
+// Factors applied to the heuristic delta to get the candidates of the probe
+static const float probe_factors[] = {0.25f, 0.5f, 1.0f, 2.0f, 4.0f, 8.0f};
+
+// Function to collect the edge weight and degree statistics of the flattened graph
+void computeGraphStats(GraphStats *stats, const int vertices, const int edge_count, const float* edge_weights) {
+    double weight_sum = 0;
+    float max_weight = 0;
+    float min_weight = 0;
+    for (int edge = 0; edge < edge_count; edge++) {
+        weight_sum += edge_weights[edge];
+        if (edge_weights[edge] > max_weight) {
+            max_weight = edge_weights[edge];
+        }
+        if (edge_weights[edge] > 0 && (min_weight == 0 || edge_weights[edge] < min_weight)) {
+            min_weight = edge_weights[edge];
+        }
+    }
+
+    stats->average_weight = edge_count > 0 ? (float) (weight_sum / edge_count) : 0;
+    stats->max_weight = max_weight;
+    stats->min_weight = min_weight;
+    stats->average_degree = vertices > 0 ? (float) edge_count / (float) vertices : 0;
+}
+
+// Function to derive the bucket width from the graph statistics.
+// Meyer and Sanders choose delta as the maximum weight divided by the degree, so a bucket holds about one hop
+// of light edges. It is kept at least at the average weight, otherwise most edges would be heavy and the buckets
+// would be mostly empty.
+float heuristicDelta(const GraphStats *stats) {
+    float delta = stats->average_degree > 0 ? stats->max_weight / stats->average_degree : stats->max_weight;
+    if (delta < stats->average_weight) {
+        delta = stats->average_weight;
+    }
+    if (delta > stats->max_weight) {
+        delta = stats->max_weight;
+    }
+    if (delta <= 0) {
+        delta = 1;  // graph without weighted edges, any positive width works
+    }
+    return delta;
+}
+
+// Function to get the smallest useful bucket width. A bucket narrower than the shortest edge can't hold more nodes
+// than one of that width, and with max_weight / vertices the window of the buckets never needs more slots than
+// there are nodes. No shortest path is longer than the sum of all edge weights, so the last bound keeps every
+// bucket index within the range of an int.
+float minimumDelta(const GraphStats *stats, const int vertices) {
+    float minimum = stats->min_weight;
+    if (vertices > 0 && stats->max_weight / (float) vertices > minimum) {
+        minimum = stats->max_weight / (float) vertices;
+    }
+    const double weight_sum = (double) stats->average_weight * stats->average_degree * vertices;
+    if (weight_sum / (INT_MAX / 2) > minimum) {
+        minimum = (float) (weight_sum / (INT_MAX / 2));
+    }
+    return minimum > 0 ? minimum : 1;
+}
+
+// Function to run a short delta-stepping from the start node and count its work.
+// The cost is the number of relaxed edges plus phase_cost for every phase, a phase being one pass over the nodes
+// that wait in the current bucket.
+static double probeCost(
+    const float delta,
+    const float max_weight,
+    const int vertices,
+    const int edge_count,
+    const int* edges_start,
+    const int* edge_destinations,
+    const float* edge_weights,
+    const int start_index,
+    const float phase_cost,
+    float* dist,
+    int* settled,
+    int* phase_nodes,
+    int* settled_nodes) {
+
+    for (int i = 0; i < vertices; i++) {
+        dist[i] = INF;
+        settled[i] = 0;
+    }
+    dist[start_index] = 0;
+
+    BucketsArray bucketsArray;
+    initializeBuckets(&bucketsArray, vertices, max_weight, delta);
+    addNodeToBucket(&bucketsArray, 0, start_index);
+
+    long relaxations = 0;
+    long phases = 0;
+    int settled_total = 0;
+
+    int bucket_id = 0;
+    while (bucket_id != -1 && settled_total < PROBE_SETTLE_LIMIT) {
+        // light phases until the bucket stays empty
+        int settled_count = 0;
+        int phase_size;
+        while ((phase_size = takeBucketNodes(&bucketsArray, phase_nodes)) > 0) {
+            phases++;
+            for (int i = 0; i < phase_size; i++) {
+                const int node = phase_nodes[i];
+                if (!settled[node]) {
+                    settled[node] = 1;
+                    settled_nodes[settled_count++] = node;
+                }
+
+                const int edge_end = (node == vertices - 1) ? edge_count : edges_start[node + 1];
+                for (int edge = edges_start[node]; edge < edge_end; edge++) {
+                    if (edge_weights[edge] > delta) {
+                        continue;
+                    }
+                    relaxations++;
+                    const float new_dist = dist[node] + edge_weights[edge];
+                    if (new_dist < dist[edge_destinations[edge]]) {
+                        dist[edge_destinations[edge]] = new_dist;
+                        addNodeToBucket(&bucketsArray, (int) (new_dist / delta), edge_destinations[edge]);
+                    }
+                }
+            }
+        }
+
+        // one heavy phase over the nodes settled in this bucket
+        if (settled_count > 0) {
+            phases++;
+        }
+        for (int i = 0; i < settled_count; i++) {
+            const int node = settled_nodes[i];
+            const int edge_end = (node == vertices - 1) ? edge_count : edges_start[node + 1];
+            for (int edge = edges_start[node]; edge < edge_end; edge++) {
+                if (edge_weights[edge] <= delta) {
+                    continue;
+                }
+                relaxations++;
+                const float new_dist = dist[node] + edge_weights[edge];
+                if (new_dist < dist[edge_destinations[edge]]) {
+                    dist[edge_destinations[edge]] = new_dist;
+                    addNodeToBucket(&bucketsArray, (int) (new_dist / delta), edge_destinations[edge]);
+                }
+            }
+        }
+        settled_total += settled_count;
+
+        bucket_id = nextBucket(&bucketsArray);
+    }
+
+    freeBuckets(&bucketsArray);
+    return (double) relaxations + (double) phases * phase_cost;
+}
+
+// Function to pick the cheapest of several candidate widths around the heuristic by probing them from the start node
+float probeDelta(
+    const GraphStats *stats,
+    const int vertices,
+    const int edge_count,
+    const int* edges_start,
+    const int* edge_destinations,
+    const float* edge_weights,
+    const int start_index,
+    const float phase_cost) {
+
+    const float heuristic = heuristicDelta(stats);
+
+    float* dist = malloc(vertices * sizeof(float));
+    int* settled = malloc(vertices * sizeof(int));
+    int* phase_nodes = malloc(vertices * sizeof(int));
+    int* settled_nodes = malloc(vertices * sizeof(int));
+    if (dist == NULL || settled == NULL || phase_nodes == NULL || settled_nodes == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the delta probe.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // start with the heuristic itself, another candidate has to be strictly cheaper
+    float best_delta = heuristic;
+    double best_cost = probeCost(
+        heuristic, stats->max_weight, vertices, edge_count, edges_start, edge_destinations, edge_weights,
+        start_index, phase_cost, dist, settled, phase_nodes, settled_nodes);
+
+    for (size_t i = 0; i < sizeof(probe_factors) / sizeof(probe_factors[0]); i++) {
+        const float delta = heuristic * probe_factors[i];
+        if (probe_factors[i] == 1.0f || delta <= 0) {
+            continue;
+        }
+        const double cost = probeCost(
+            delta, stats->max_weight, vertices, edge_count, edges_start, edge_destinations, edge_weights,
+            start_index, phase_cost, dist, settled, phase_nodes, settled_nodes);
+        if (cost < best_cost) {
+            best_cost = cost;
+            best_delta = delta;
+        }
+    }
+
+    free(dist);
+    free(settled);
+    free(phase_nodes);
+    free(settled_nodes);
+    return best_delta;
+}
+
+// Function to determine the bucket width for delta-stepping from the statistics of the graph.
+// option is the value of the delta option: a width in meters, "probe" to probe candidates from the start node,
+// or NULL / "auto" for the heuristic. phase_cost weighs one phase against one edge relaxation for the probe.
+float selectDelta(
+    const char *option,
+    const GraphStats *stats,
+    const int vertices,
+    const int edge_count,
+    const int* edges_start,
+    const int* edge_destinations,
+    const float* edge_weights,
+    const int start_index,
+    const float phase_cost) {
+
+    // a fixed width given with the request, infinity and NaN fail the range check
+    if (option != NULL && option[0] != '\0' && strcmp(option, "auto") != 0 && strcmp(option, "probe") != 0) {
+        char* end;
+        const float delta = strtof(option, &end);
+        if (end != option && *end == '\0' && delta > 0 && delta <= FLT_MAX) {
+            const float minimum = minimumDelta(stats, vertices);
+            if (delta < minimum) {
+                fprintf(stderr, "Raising delta %g to the smallest useful width %g\n", delta, minimum);
+                return minimum;
+            }
+            return delta;
+        }
+        fprintf(stderr, "Ignoring invalid delta '%s', using the graph statistics instead\n", option);
+    }
+
+    if (option != NULL && strcmp(option, "probe") == 0) {
+        return probeDelta(
+            stats, vertices, edge_count, edges_start, edge_destinations, edge_weights, start_index, phase_cost);
+    }
+    return heuristicDelta(stats);
+}
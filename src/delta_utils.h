@@ -0,0 +1,36 @@
+#ifndef DELTA_UTILS_H
+#define DELTA_UTILS_H
+
+// Define a struct holding the statistics of the flattened graph that the bucket width is derived from
+typedef struct {
+    float average_weight;  // Average weight of all edges
+    float max_weight;  // Weight of the longest edge
+    float min_weight;  // Weight of the shortest edge that is longer than 0, 0 if there is none
+    float average_degree;  // Average number of outgoing edges per node
+} GraphStats;
+
+// Delta functions
+void computeGraphStats(GraphStats *stats, const int vertices, const int edge_count, const float* edge_weights);
+float heuristicDelta(const GraphStats *stats);
+float minimumDelta(const GraphStats *stats, const int vertices);
+float probeDelta(
+    const GraphStats *stats,
+    const int vertices,
+    const int edge_count,
+    const int* edges_start,
+    const int* edge_destinations,
+    const float* edge_weights,
+    const int start_index,
+    const float phase_cost);
+float selectDelta(
+    const char *option,
+    const GraphStats *stats,
+    const int vertices,
+    const int edge_count,
+    const int* edges_start,
+    const int* edge_destinations,
+    const float* edge_weights,
+    const int start_index,
+    const float phase_cost);
+
+#endif //DELTA_UTILS_H
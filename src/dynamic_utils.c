@@ -0,0 +1,292 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <float.h>  // For FLT_MAX
+
+#include "dynamic_utils.h"
+#include "task_utils.h"  // Include parallelFor function
+
+#define INF FLT_MAX
+
+// Define a struct holding the arguments of the parallel tree repair
+typedef struct {
+    DynamicGraph* graph;
+    const EdgeUpdate* updates;
+    const float* old_weights;  // old_weights[i] holds the weight the edge of update i had before
+    int update_count;
+    ShortestPathTree* trees;
+    int* repaired;  // repaired[t] receives the number of nodes tree t had to recompute
+} RepairTask;
+
+// Function to create a dynamic graph on top of the flattened arrays and collect the incoming edges of every node.
+// The arrays are not copied and have to stay valid until the graph is freed, edge_weights is changed by the updates.
+void createDynamicGraph(
+    DynamicGraph* graph,
+    const int vertices,
+    const int edge_count,
+    const int* edges_start,
+    const int* edge_destinations,
+    float* edge_weights) {
+
+    graph->vertices = vertices;
+    graph->edge_count = edge_count;
+    graph->edges_start = edges_start;
+    graph->edge_destinations = edge_destinations;
+    graph->edge_weights = edge_weights;
+
+    graph->edge_sources = malloc((edge_count > 0 ? edge_count : 1) * sizeof(int));
+    graph->in_start = calloc(vertices + 1, sizeof(int));
+    graph->in_edges = malloc((edge_count > 0 ? edge_count : 1) * sizeof(int));
+    if (graph->edge_sources == NULL || graph->in_start == NULL || graph->in_edges == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the incoming edges.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // count the incoming edges of every node and turn the counts into start indices
+    for (int v = 0; v < vertices; v++) {
+        const int edge_end = (v == vertices - 1) ? edge_count : edges_start[v + 1];
+        for (int edge = edges_start[v]; edge < edge_end; edge++) {
+            graph->edge_sources[edge] = v;
+            graph->in_start[edge_destinations[edge] + 1]++;
+        }
+    }
+    for (int v = 0; v < vertices; v++) {
+        graph->in_start[v + 1] += graph->in_start[v];
+    }
+
+    // fill the incoming edges, in_start[v] is moved back to its place afterwards
+    for (int edge = 0; edge < edge_count; edge++) {
+        graph->in_edges[graph->in_start[edge_destinations[edge]]++] = edge;
+    }
+    for (int v = vertices; v > 0; v--) {
+        graph->in_start[v] = graph->in_start[v - 1];
+    }
+    graph->in_start[0] = 0;
+
+    // allocate the repair state of every thread, no stamp matches a repair before the first one
+    graph->state_count = taskThreadCount();
+    graph->states = malloc(graph->state_count * sizeof(RepairState));
+    if (graph->states == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the repair states.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < graph->state_count; i++) {
+        graph->states[i].stamp = calloc(vertices > 0 ? vertices : 1, sizeof(int));
+        graph->states[i].affected = malloc((vertices > 0 ? vertices : 1) * sizeof(int));
+        graph->states[i].repair = 0;
+        if (graph->states[i].stamp == NULL || graph->states[i].affected == NULL) {
+            fprintf(stderr, "Error: Unable to allocate memory for the repair states.\n");
+            exit(EXIT_FAILURE);
+        }
+        initializeHeap(&graph->states[i].heap, 1024);
+    }
+}
+
+// Function to free the incoming edges and the repair states, the flattened arrays belong to the caller
+void freeDynamicGraph(DynamicGraph* graph) {
+    for (int i = 0; i < graph->state_count; i++) {
+        free(graph->states[i].stamp);
+        free(graph->states[i].affected);
+        freeHeap(&graph->states[i].heap);
+    }
+    free(graph->states);
+    free(graph->edge_sources);
+    free(graph->in_start);
+    free(graph->in_edges);
+    graph->states = NULL;
+    graph->edge_sources = NULL;
+    graph->in_start = NULL;
+    graph->in_edges = NULL;
+}
+
+// Function to settle the nodes inside the heap and everything they improve, the labels of the tree are upper bounds.
+// A closed edge has a weight of INF, so a path over it is never shorter than any label.
+static void settleTree(const DynamicGraph* graph, ShortestPathTree* tree, MinHeap* heap) {
+    int node;
+    float key;
+    while (popHeap(heap, &node, &key)) {
+        // Skip outdated heap entries
+        if (key > tree->dist[node]) {
+            continue;
+        }
+
+        const int edge_end = (node == graph->vertices - 1) ? graph->edge_count : graph->edges_start[node + 1];
+        for (int edge = graph->edges_start[node]; edge < edge_end; edge++) {
+            const int destination = graph->edge_destinations[edge];
+            const float new_dist = key + graph->edge_weights[edge];
+            if (new_dist < tree->dist[destination]) {
+                tree->dist[destination] = new_dist;
+                tree->prev[destination] = node;
+                tree->prev_edge[destination] = edge;
+                pushHeap(heap, destination, new_dist);
+            }
+        }
+    }
+}
+
+// Function to calculate the shortest-path tree of source with Dijkstra's algorithm
+void computeShortestPathTree(ShortestPathTree* tree, const DynamicGraph* graph, const int source) {
+    const int vertices = graph->vertices;
+    tree->source = source;
+    tree->dist = malloc((vertices > 0 ? vertices : 1) * sizeof(float));
+    tree->prev = malloc((vertices > 0 ? vertices : 1) * sizeof(int));
+    tree->prev_edge = malloc((vertices > 0 ? vertices : 1) * sizeof(int));
+    if (tree->dist == NULL || tree->prev == NULL || tree->prev_edge == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the shortest-path tree.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Initialize all distances as INFINITE and previous as -1
+    for (int i = 0; i < vertices; i++) {
+        tree->dist[i] = INF;
+        tree->prev[i] = -1;
+        tree->prev_edge[i] = -1;
+    }
+    tree->dist[source] = 0;
+
+    MinHeap heap;
+    initializeHeap(&heap, 1024);
+    pushHeap(&heap, source, 0);
+    settleTree(graph, tree, &heap);
+    freeHeap(&heap);
+}
+
+// Function to repair a tree after the weights of the updated edges changed, following Ramalingam and Reps.
+// Only the subtrees below edges that got longer lose their distances, they are seeded from their unaffected
+// neighbours and settled again together with the nodes that edges which got shorter improve.
+// Returns the number of nodes whose distance was recalculated.
+static int repairTree(
+    const DynamicGraph* graph,
+    ShortestPathTree* tree,
+    RepairState* state,
+    const EdgeUpdate* updates,
+    const float* old_weights,
+    const int update_count) {
+
+    state->repair++;
+    int* affected = state->affected;
+    int affected_count = 0;
+
+    // collect the nodes that hang directly below a tree edge that got longer
+    for (int i = 0; i < update_count; i++) {
+        const int edge = updates[i].edge;
+        const int destination = graph->edge_destinations[edge];
+        if (updates[i].weight > old_weights[i] && tree->prev_edge[destination] == edge &&
+            state->stamp[destination] != state->repair) {
+            state->stamp[destination] = state->repair;
+            affected[affected_count++] = destination;
+        }
+    }
+
+    // add their subtrees, a child is reached over the tree edge stored for it
+    for (int i = 0; i < affected_count; i++) {
+        const int node = affected[i];
+        const int edge_end = (node == graph->vertices - 1) ? graph->edge_count : graph->edges_start[node + 1];
+        for (int edge = graph->edges_start[node]; edge < edge_end; edge++) {
+            const int child = graph->edge_destinations[edge];
+            if (tree->prev_edge[child] == edge && state->stamp[child] != state->repair) {
+                state->stamp[child] = state->repair;
+                affected[affected_count++] = child;
+            }
+        }
+    }
+
+    // the distances of the affected nodes are no longer valid, all other distances still are
+    for (int i = 0; i < affected_count; i++) {
+        tree->dist[affected[i]] = INF;
+        tree->prev[affected[i]] = -1;
+        tree->prev_edge[affected[i]] = -1;
+    }
+
+    // seed every affected node with its best incoming edge from an unaffected node
+    MinHeap* heap = &state->heap;
+    clearHeap(heap);
+    for (int i = 0; i < affected_count; i++) {
+        const int node = affected[i];
+        for (int j = graph->in_start[node]; j < graph->in_start[node + 1]; j++) {
+            const int edge = graph->in_edges[j];
+            const int source = graph->edge_sources[edge];
+            const float new_dist = tree->dist[source] + graph->edge_weights[edge];
+            if (new_dist < tree->dist[node]) {
+                tree->dist[node] = new_dist;
+                tree->prev[node] = source;
+                tree->prev_edge[node] = edge;
+            }
+        }
+        if (tree->dist[node] != INF) {
+            pushHeap(heap, node, tree->dist[node]);
+        }
+    }
+
+    // seed the nodes that edges which got shorter improve
+    int improved_count = 0;
+    for (int i = 0; i < update_count; i++) {
+        const int edge = updates[i].edge;
+        const int source = graph->edge_sources[edge];
+        const int destination = graph->edge_destinations[edge];
+        const float new_dist = tree->dist[source] + graph->edge_weights[edge];
+        if (updates[i].weight < old_weights[i] && new_dist < tree->dist[destination]) {
+            tree->dist[destination] = new_dist;
+            tree->prev[destination] = source;
+            tree->prev_edge[destination] = edge;
+            pushHeap(heap, destination, new_dist);
+            improved_count++;
+        }
+    }
+
+    settleTree(graph, tree, heap);
+    return affected_count + improved_count;
+}
+
+// Function to repair the trees begin to end - 1 of a repair task
+static void repairTreeRange(void *context, const int begin, const int end, const int worker_id) {
+    const RepairTask *task = context;
+    for (int t = begin; t < end; t++) {
+        task->repaired[t] = repairTree(
+            task->graph, &task->trees[t], &task->graph->states[worker_id], task->updates, task->old_weights,
+            task->update_count);
+    }
+}
+
+// Function to change the weights of the updated edges and repair the shortest-path trees on the threads of the
+// task pool, instead of calculating them again. Returns the number of nodes whose distance was recalculated.
+int applyEdgeUpdates(
+    DynamicGraph* graph,
+    const EdgeUpdate* updates,
+    const int update_count,
+    ShortestPathTree* trees,
+    const int tree_count) {
+
+    // change the weights, an edge updated twice keeps the last weight
+    float* old_weights = malloc((update_count > 0 ? update_count : 1) * sizeof(float));
+    int* repaired = malloc((tree_count > 0 ? tree_count : 1) * sizeof(int));
+    if (old_weights == NULL || repaired == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the edge updates.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < update_count; i++) {
+        old_weights[i] = graph->edge_weights[updates[i].edge];
+        graph->edge_weights[updates[i].edge] = updates[i].weight;
+    }
+
+    // Repair the trees in parallel, every tree only touches its own arrays
+    RepairTask task = {graph, updates, old_weights, update_count, trees, repaired};
+    parallelFor(0, tree_count, 1, repairTreeRange, &task);
+
+    int repaired_nodes = 0;
+    for (int t = 0; t < tree_count; t++) {
+        repaired_nodes += repaired[t];
+    }
+    free(old_weights);
+    free(repaired);
+    return repaired_nodes;
+}
+
+// Function to free the arrays of a shortest-path tree
+void freeShortestPathTree(ShortestPathTree* tree) {
+    free(tree->dist);
+    free(tree->prev);
+    free(tree->prev_edge);
+    tree->dist = NULL;
+    tree->prev = NULL;
+    tree->prev_edge = NULL;
+}
@@ -0,0 +1,62 @@
+#ifndef DYNAMIC_UTILS_H
+#define DYNAMIC_UTILS_H
+
+#include "heap_utils.h"  // For MinHeap struct
+
+// Define the state one thread needs to repair a tree, reused by every repair of the thread
+typedef struct {
+    int *stamp;  // stamp[v] holds the number of the repair that found node v affected
+    int repair;  // number of the current repair, counted from 1
+    int *affected;  // the affected nodes of the current repair
+    MinHeap heap;
+} RepairState;
+
+// Define a flattened graph whose edge weights can change, together with the incoming edges of every node
+typedef struct {
+    int vertices;
+    int edge_count;
+    const int* edges_start;
+    const int* edge_destinations;
+    float* edge_weights;  // updated in place, a closed edge has a weight of INF
+
+    int* edge_sources;  // edge_sources[e] holds the node edge e leaves
+    int* in_start;  // the incoming edges of node v are in_edges[in_start[v]] to in_edges[in_start[v + 1] - 1]
+    int* in_edges;  // index of every incoming edge inside the flattened edge arrays
+
+    int state_count;
+    RepairState* states;  // one state per thread of the task pool
+} DynamicGraph;
+
+// Define a shortest-path tree that is kept up to date while the weights change
+typedef struct {
+    int source;
+    float* dist;  // dist[v] holds the distance from the source to v, INF if unreachable
+    int* prev;  // prev[v] holds the previous node on the path, -1 for the source and unreachable nodes
+    int* prev_edge;  // prev_edge[v] holds the edge that reaches v inside the tree, -1 if there is none
+} ShortestPathTree;
+
+// Define a change of the weight of a single edge
+typedef struct {
+    int edge;  // index of the edge inside the flattened edge arrays
+    float weight;  // new weight of the edge, INF closes it
+} EdgeUpdate;
+
+// Dynamic graph functions
+void createDynamicGraph(
+    DynamicGraph* graph,
+    const int vertices,
+    const int edge_count,
+    const int* edges_start,
+    const int* edge_destinations,
+    float* edge_weights);
+void freeDynamicGraph(DynamicGraph* graph);
+void computeShortestPathTree(ShortestPathTree* tree, const DynamicGraph* graph, const int source);
+int applyEdgeUpdates(
+    DynamicGraph* graph,
+    const EdgeUpdate* updates,
+    const int update_count,
+    ShortestPathTree* trees,
+    const int tree_count);
+void freeShortestPathTree(ShortestPathTree* tree);
+
+#endif //DYNAMIC_UTILS_H
@@ -5,20 +5,34 @@
 #include <stdlib.h>
 
 #include "haversine.h"
-
-// Function to fill the graph with the data from the roads
-void createGraph(Node* nodes, const int nodeCount, const Road* roads, const int roadCount) {
-    // Iterate through each road
-    for (int i = 0; i < roadCount; i++) {
-
+#include "task_utils.h"  // Include parallelFor function
+
+// Define a struct holding the arguments of the parallel road lookup
+typedef struct {
+    const Node* nodes;
+    int nodeCount;
+    const Road* roads;
+    const int* segmentStart;  // Index of the first segment of every road
+    int* segmentFrom;  // Index of the first node of every segment, -1 if a node was not found
+    int* segmentTo;  // Index of the second node of every segment
+    float* segmentDistance;  // Length of every segment
+} RoadLookup;
+
+// Function to find the nodes of every segment of the roads begin to end - 1 and calculate the segment lengths
+static void lookupRoads(void* context, const int begin, const int end, const int worker_id) {
+    const RoadLookup* lookup = context;
+    const Node* nodes = lookup->nodes;
+
+    for (int i = begin; i < end; i++) {
         // Go through each pair of consecutive nodes in the road
-        for (int j = 0; j < roads[i].nodeCount - 1; j++) {
-            const int64_t nodeId1 = roads[i].nodes[j];
-            const int64_t nodeId2 = roads[i].nodes[j + 1];
+        for (int j = 0; j < lookup->roads[i].nodeCount - 1; j++) {
+            const int64_t nodeId1 = lookup->roads[i].nodes[j];
+            const int64_t nodeId2 = lookup->roads[i].nodes[j + 1];
+            const int segment = lookup->segmentStart[i] + j;
 
             // Find the indexes of nodeId1 and nodeId2 in the nodes array
             int index1 = -1, index2 = -1;
-            for (int k = 0; k < nodeCount; k++) {
+            for (int k = 0; k < lookup->nodeCount; k++) {
                 if (nodes[k].id == nodeId1) index1 = k;
                 if (nodes[k].id == nodeId2) index2 = k;
                 if (index1 != -1 && index2 != -1) break;
@@ -26,8 +40,58 @@ void createGraph(Node* nodes, const int nodeCount, const Road* roads, const int
 
             // If both nodes are found, calculate the distance between them
             if (index1 != -1 && index2 != -1) {
-                const float distance = haversine(nodes[index1].lat, nodes[index1].lon,
-                                                  nodes[index2].lat, nodes[index2].lon);
+                lookup->segmentFrom[segment] = index1;
+                lookup->segmentTo[segment] = index2;
+                lookup->segmentDistance[segment] = haversine(nodes[index1].lat, nodes[index1].lon,
+                                                             nodes[index2].lat, nodes[index2].lon);
+            } else {
+                lookup->segmentFrom[segment] = -1;
+            }
+        }
+    }
+}
+
+// Function to fill the graph with the data from the roads.
+// The nodes of the road segments are looked up in parallel, since roads differ a lot in length the task pool balances
+// them by stealing. The edges are linked afterwards in the order of the roads.
+void createGraph(Node* nodes, const int nodeCount, const Road* roads, const int roadCount) {
+    // Number the segments of all roads
+    int* segmentStart = malloc((roadCount + 1) * sizeof(int));
+    if (segmentStart == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the road segments.\n");
+        exit(EXIT_FAILURE);
+    }
+    segmentStart[0] = 0;
+    for (int i = 0; i < roadCount; i++) {
+        segmentStart[i + 1] = segmentStart[i] + (roads[i].nodeCount > 1 ? roads[i].nodeCount - 1 : 0);
+    }
+    const int segmentCount = segmentStart[roadCount];
+
+    RoadLookup lookup = {nodes, nodeCount, roads, segmentStart, NULL, NULL, NULL};
+    lookup.segmentFrom = malloc((segmentCount > 0 ? segmentCount : 1) * sizeof(int));
+    lookup.segmentTo = malloc((segmentCount > 0 ? segmentCount : 1) * sizeof(int));
+    lookup.segmentDistance = malloc((segmentCount > 0 ? segmentCount : 1) * sizeof(float));
+    if (lookup.segmentFrom == NULL || lookup.segmentTo == NULL || lookup.segmentDistance == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the road segments.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    parallelFor(0, roadCount, 1, lookupRoads, &lookup);
+
+    // Iterate through each road
+    for (int i = 0; i < roadCount; i++) {
+
+        // Go through each pair of consecutive nodes in the road
+        for (int j = 0; j < roads[i].nodeCount - 1; j++) {
+            const int64_t nodeId1 = roads[i].nodes[j];
+            const int64_t nodeId2 = roads[i].nodes[j + 1];
+            const int segment = segmentStart[i] + j;
+
+            // If both nodes are found, connect them
+            if (lookup.segmentFrom[segment] != -1) {
+                const int index1 = lookup.segmentFrom[segment];
+                const int index2 = lookup.segmentTo[segment];
+                const float distance = lookup.segmentDistance[segment];
 
                 // Add edge from index1 to index2
                 Edge* newEdge1 = malloc(sizeof(Edge));
@@ -55,11 +119,22 @@ void createGraph(Node* nodes, const int nodeCount, const Road* roads, const int
             }
         }
     }
+
+    free(segmentStart);
+    free(lookup.segmentFrom);
+    free(lookup.segmentTo);
+    free(lookup.segmentDistance);
 }
 
 
 // Function to free the nodes memory
 void freeNodes(Node* nodes, const int nodeCount) {
+    freeEdges(nodes, nodeCount);
+    free(nodes); // Finally, free the array of nodes itself
+}
+
+// Function to free the edge lists of the nodes but keep their IDs and coordinates
+void freeEdges(Node* nodes, const int nodeCount) {
     for (int i = 0; i < nodeCount; i++) {
         Edge* current = nodes[i].head;
         while (current != NULL) {
@@ -69,7 +144,6 @@ void freeNodes(Node* nodes, const int nodeCount) {
         }
         nodes[i].head = NULL; // Set head to NULL after freeing
     }
-    free(nodes); // Finally, free the array of nodes itself
 }
 
 // Debug Print to retrieve Nodes
@@ -27,6 +27,7 @@ typedef struct Road {
 // Graph functions
 void createGraph(Node* nodes, const int nodeCount, const Road* roads, const int roadCount);
 void freeNodes(Node* nodes, const int nodeCount);
+void freeEdges(Node* nodes, const int nodeCount);
 
 // Debug functions
 void printNodes(const Node* nodes, const int nodeCount);
@@ -0,0 +1,173 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "heap_utils.h"
+
+// Function to initialize the MinHeap with a starting capacity
+void initializeHeap(MinHeap *heap, const int capacity) {
+    heap->capacity = capacity > 0 ? capacity : 16;
+    heap->size = 0;
+    heap->entries = (HeapEntry *)malloc(heap->capacity * sizeof(HeapEntry));
+    if (heap->entries == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the heap.\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+// Function to insert a node into the heap.
+// Decrease-key is handled lazily: a node may be pushed multiple times and outdated entries are skipped by the caller.
+void pushHeap(MinHeap *heap, const int node, const float key) {
+    // Grow the heap geometrically if it is full
+    if (heap->size >= heap->capacity) {
+        heap->capacity *= 2;
+        heap->entries = (HeapEntry *)realloc(heap->entries, heap->capacity * sizeof(HeapEntry));
+        if (heap->entries == NULL) {
+            fprintf(stderr, "Error: Unable to reallocate memory for the heap.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    // Sift the new entry up from the last position
+    int index = heap->size++;
+    while (index > 0) {
+        const int parent = (index - 1) / 2;
+        if (heap->entries[parent].key <= key) {
+            break;
+        }
+        heap->entries[index] = heap->entries[parent];
+        index = parent;
+    }
+    heap->entries[index].key = key;
+    heap->entries[index].node = node;
+}
+
+// Function to remove the entry with the smallest key, returns 0 if the heap is empty
+int popHeap(MinHeap *heap, int *node, float *key) {
+    if (heap->size == 0) {
+        return 0;
+    }
+
+    *node = heap->entries[0].node;
+    *key = heap->entries[0].key;
+
+    // Move the last entry to the root and sift it down
+    const HeapEntry last = heap->entries[--heap->size];
+    int index = 0;
+    while (1) {
+        int child = 2 * index + 1;
+        if (child >= heap->size) {
+            break;
+        }
+        if (child + 1 < heap->size && heap->entries[child + 1].key < heap->entries[child].key) {
+            child++;
+        }
+        if (last.key <= heap->entries[child].key) {
+            break;
+        }
+        heap->entries[index] = heap->entries[child];
+        index = child;
+    }
+    if (heap->size > 0) {
+        heap->entries[index] = last;
+    }
+    return 1;
+}
+
+// Function to remove all entries while keeping the allocated memory for reuse
+void clearHeap(MinHeap *heap) {
+    heap->size = 0;
+}
+
+// Function to free the heap memory
+void freeHeap(MinHeap *heap) {
+    if (heap == NULL) {
+        return;
+    }
+    free(heap->entries);
+    heap->entries = NULL;
+    heap->size = 0;
+    heap->capacity = 0;
+}
+
+// Function to initialize an empty RadixHeap, the buckets allocate their memory on the first push
+void initializeRadixHeap(RadixHeap *heap) {
+    for (int i = 0; i < RADIX_BUCKETS; i++) {
+        heap->buckets[i] = NULL;
+        heap->size[i] = 0;
+        heap->capacity[i] = 0;
+    }
+    heap->last = 0;
+}
+
+// Function to get the bucket of a key, 0 if it equals the last popped key
+static int radixBucket(const RadixHeap *heap, const uint32_t key) {
+    return key == heap->last ? 0 : 32 - __builtin_clz(key ^ heap->last);
+}
+
+// Function to append an entry to a bucket, growing the bucket geometrically if necessary
+static void addRadixEntry(RadixHeap *heap, const int bucket, const RadixEntry entry) {
+    if (heap->size[bucket] == heap->capacity[bucket]) {
+        heap->capacity[bucket] = heap->capacity[bucket] > 0 ? heap->capacity[bucket] * 2 : 16;
+        heap->buckets[bucket] = (RadixEntry *)realloc(heap->buckets[bucket], heap->capacity[bucket] * sizeof(RadixEntry));
+        if (heap->buckets[bucket] == NULL) {
+            fprintf(stderr, "Error: Unable to reallocate memory for the radix heap.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    heap->buckets[bucket][heap->size[bucket]++] = entry;
+}
+
+// Function to insert a node into the radix heap, the key must not be smaller than the last popped key.
+// Decrease-key is handled lazily like in the MinHeap, outdated entries are skipped by the caller.
+void pushRadixHeap(RadixHeap *heap, const int node, const uint32_t key) {
+    const RadixEntry entry = {key, node};
+    addRadixEntry(heap, radixBucket(heap, key), entry);
+}
+
+// Function to remove an entry with the smallest key, returns 0 if the heap is empty.
+// If bucket 0 is empty, the smallest key of the first filled bucket becomes the last key and that bucket is spread
+// over the lower buckets, every entry moves down at least one bucket, so each entry is moved at most 32 times.
+int popRadixHeap(RadixHeap *heap, int *node, uint32_t *key) {
+    if (heap->size[0] == 0) {
+        int bucket = 1;
+        while (bucket < RADIX_BUCKETS && heap->size[bucket] == 0) {
+            bucket++;
+        }
+        if (bucket == RADIX_BUCKETS) {
+            return 0;
+        }
+
+        uint32_t smallest = heap->buckets[bucket][0].key;
+        for (int i = 1; i < heap->size[bucket]; i++) {
+            if (heap->buckets[bucket][i].key < smallest) {
+                smallest = heap->buckets[bucket][i].key;
+            }
+        }
+        heap->last = smallest;
+
+        const int count = heap->size[bucket];
+        heap->size[bucket] = 0;
+        for (int i = 0; i < count; i++) {
+            const RadixEntry entry = heap->buckets[bucket][i];
+            addRadixEntry(heap, radixBucket(heap, entry.key), entry);
+        }
+    }
+
+    const RadixEntry entry = heap->buckets[0][--heap->size[0]];
+    *node = entry.node;
+    *key = entry.key;
+    return 1;
+}
+
+// Function to free the radix heap memory
+void freeRadixHeap(RadixHeap *heap) {
+    if (heap == NULL) {
+        return;
+    }
+    for (int i = 0; i < RADIX_BUCKETS; i++) {
+        free(heap->buckets[i]);
+        heap->buckets[i] = NULL;
+        heap->size[i] = 0;
+        heap->capacity[i] = 0;
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef HEAP_UTILS_H
+#define HEAP_UTILS_H
+
+#include <stdint.h>
+
+#define RADIX_BUCKETS 33  // One bucket for the last popped key and one for every bit a key can differ in
+
+// Define a struct for a single entry of the priority queue
+typedef struct {
+    float key;  // Priority of the entry (smallest key is popped first)
+    int node;  // Index of the node the entry belongs to
+} HeapEntry;
+
+// Define a struct to manage a binary min-heap used as priority queue
+typedef struct {
+    HeapEntry *entries;  // Array holding the heap ordered entries
+    int size;  // Number of entries currently inside the heap
+    int capacity;  // Number of entries that fit into the allocated array
+} MinHeap;
+
+// Define a struct for a single entry of the radix heap
+typedef struct {
+    uint32_t key;  // Fixed-point priority of the entry
+    int node;  // Index of the node the entry belongs to
+} RadixEntry;
+
+// Define a struct to manage a monotone radix heap for integer keys, no key pushed may be smaller than the last popped.
+// Bucket 0 holds the keys equal to the last popped key, bucket i the keys whose highest bit different from it is i - 1.
+typedef struct {
+    RadixEntry *buckets[RADIX_BUCKETS];
+    int size[RADIX_BUCKETS];
+    int capacity[RADIX_BUCKETS];
+    uint32_t last;  // Last popped key
+} RadixHeap;
+
+// Heap functions
+void initializeHeap(MinHeap *heap, const int capacity);
+void pushHeap(MinHeap *heap, const int node, const float key);
+int popHeap(MinHeap *heap, int *node, float *key);
+void clearHeap(MinHeap *heap);
+void freeHeap(MinHeap *heap);
+
+// Radix heap functions
+void initializeRadixHeap(RadixHeap *heap);
+void pushRadixHeap(RadixHeap *heap, const int node, const uint32_t key);
+int popRadixHeap(RadixHeap *heap, int *node, uint32_t *key);
+void freeRadixHeap(RadixHeap *heap);
+
+#endif //HEAP_UTILS_H
@@ -0,0 +1,174 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "isochrone_utils.h"
+#include "task_utils.h"  // Include parallelFor function
+
+// Define a struct holding the arguments of the parallel band calculation
+typedef struct {
+    Isochrone *isochrone;
+    const Node* nodes;
+    int vertices;
+    int edge_count;
+    const int* edges_start;
+    const int* edge_destinations;
+    const float* edge_weights;
+    const float* dist;
+} IsochroneTask;
+
+// Function to allocate memory of the isochrone
+static void* isochroneAlloc(const size_t size) {
+    void* memory = malloc(size > 0 ? size : 1);
+    if (memory == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the isochrone.\n");
+        exit(EXIT_FAILURE);
+    }
+    return memory;
+}
+
+// Function to compare two (lat, lon) pairs by longitude and then latitude, for qsort
+static int comparePoints(const void* a, const void* b) {
+    const float* first = a;
+    const float* second = b;
+    if (first[1] != second[1]) {
+        return first[1] < second[1] ? -1 : 1;
+    }
+    if (first[0] != second[0]) {
+        return first[0] < second[0] ? -1 : 1;
+    }
+    return 0;
+}
+
+// Function to get the cross product of the vectors origin -> a and origin -> b, positive for a counter-clockwise turn
+static double cross(const float* origin, const float* a, const float* b) {
+    return ((double) a[1] - origin[1]) * ((double) b[0] - origin[0]) -
+           ((double) a[0] - origin[0]) * ((double) b[1] - origin[1]);
+}
+
+// Function to calculate the convex hull of the (lat, lon) pairs with Andrew's monotone chain.
+// The points are sorted in place, the hull is written to hull, which needs room for 2 * point_count pairs.
+// Returns the number of corners of the hull.
+static int convexHull(float* points, const int point_count, float* hull) {
+    if (point_count < 3) {
+        for (int i = 0; i < 2 * point_count; i++) {
+            hull[i] = points[i];
+        }
+        return point_count;
+    }
+    qsort(points, point_count, 2 * sizeof(float), comparePoints);
+
+    // lower hull from left to right, then upper hull from right to left
+    int size = 0;
+    for (int i = 0; i < point_count; i++) {
+        while (size >= 2 && cross(hull + 2 * (size - 2), hull + 2 * (size - 1), points + 2 * i) <= 0) {
+            size--;
+        }
+        hull[2 * size] = points[2 * i];
+        hull[2 * size + 1] = points[2 * i + 1];
+        size++;
+    }
+    const int lower_size = size + 1;
+    for (int i = point_count - 2; i >= 0; i--) {
+        while (size >= lower_size && cross(hull + 2 * (size - 2), hull + 2 * (size - 1), points + 2 * i) <= 0) {
+            size--;
+        }
+        hull[2 * size] = points[2 * i];
+        hull[2 * size + 1] = points[2 * i + 1];
+        size++;
+    }
+
+    // the last point is the first one again
+    return size - 1;
+}
+
+// Function to calculate the bands begin to end - 1 of an isochrone task. The polygon of a band encloses every node
+// within its limit and the points where the limit cuts the edges leaving them, interpolated along the edge.
+static void calculateBands(void* context, const int begin, const int end, const int worker_id) {
+    const IsochroneTask* task = context;
+    const int vertices = task->vertices;
+
+    for (int b = begin; b < end; b++) {
+        IsochroneBand* band = &task->isochrone->bands[b];
+        const float limit = band->limit;
+
+        // count the nodes within the limit and the edges that leave the band
+        int node_count = 0;
+        int point_count = 0;
+        for (int v = 0; v < vertices; v++) {
+            if (task->dist[v] > limit) {
+                continue;
+            }
+            node_count++;
+            point_count++;
+            const int edge_end = (v == vertices - 1) ? task->edge_count : task->edges_start[v + 1];
+            for (int edge = task->edges_start[v]; edge < edge_end; edge++) {
+                if (task->dist[v] + task->edge_weights[edge] > limit) {
+                    point_count++;
+                }
+            }
+        }
+
+        // collect the nodes and the cut points
+        float* points = isochroneAlloc(2 * (size_t) point_count * sizeof(float));
+        int size = 0;
+        for (int v = 0; v < vertices; v++) {
+            if (task->dist[v] > limit) {
+                continue;
+            }
+            points[2 * size] = task->nodes[v].lat;
+            points[2 * size + 1] = task->nodes[v].lon;
+            size++;
+
+            const int edge_end = (v == vertices - 1) ? task->edge_count : task->edges_start[v + 1];
+            for (int edge = task->edges_start[v]; edge < edge_end; edge++) {
+                const float weight = task->edge_weights[edge];
+                if (task->dist[v] + weight > limit) {
+                    const Node* destination = &task->nodes[task->edge_destinations[edge]];
+                    const float fraction = (limit - task->dist[v]) / weight;
+                    points[2 * size] = task->nodes[v].lat + fraction * (destination->lat - task->nodes[v].lat);
+                    points[2 * size + 1] = task->nodes[v].lon + fraction * (destination->lon - task->nodes[v].lon);
+                    size++;
+                }
+            }
+        }
+
+        band->node_count = node_count;
+        band->polygon = isochroneAlloc(4 * (size_t) point_count * sizeof(float));
+        band->polygon_size = convexHull(points, point_count, band->polygon);
+        free(points);
+    }
+}
+
+// Function to calculate an isochrone from the distances of a search that settled every node up to limit.
+// The limit is split into band_count bands of equal width, whose polygons are calculated in parallel.
+void computeIsochrone(
+    Isochrone *isochrone,
+    const Node* nodes,
+    const int vertices,
+    const int edge_count,
+    const int* edges_start,
+    const int* edge_destinations,
+    const float* edge_weights,
+    const float* dist,
+    const float limit,
+    const int band_count) {
+
+    isochrone->band_count = band_count;
+    isochrone->bands = isochroneAlloc(band_count * sizeof(IsochroneBand));
+    for (int b = 0; b < band_count; b++) {
+        isochrone->bands[b].limit = limit * (float) (b + 1) / (float) band_count;
+        isochrone->bands[b].polygon = NULL;
+    }
+
+    IsochroneTask task = {isochrone, nodes, vertices, edge_count, edges_start, edge_destinations, edge_weights, dist};
+    parallelFor(0, band_count, 1, calculateBands, &task);
+}
+
+// Function to free the polygons of the isochrone
+void freeIsochrone(Isochrone *isochrone) {
+    for (int b = 0; b < isochrone->band_count; b++) {
+        free(isochrone->bands[b].polygon);
+    }
+    free(isochrone->bands);
+    isochrone->bands = NULL;
+}
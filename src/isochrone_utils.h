@@ -0,0 +1,34 @@
+#ifndef ISOCHRONE_UTILS_H
+#define ISOCHRONE_UTILS_H
+
+#include "graph_utils.h"  // For Node struct
+
+// Define one band of an isochrone, everything that can be reached within its limit
+typedef struct {
+    float limit;  // Distance in meters the band reaches
+    int node_count;  // Number of nodes within the limit
+    int polygon_size;  // Number of corners of the polygon
+    float *polygon;  // Corners of the boundary polygon as (lat, lon) pairs in counter-clockwise order
+} IsochroneBand;
+
+// Define a struct to store the bands of an isochrone, ordered from the smallest to the largest limit
+typedef struct {
+    int band_count;
+    IsochroneBand *bands;
+} Isochrone;
+
+// Isochrone functions
+void computeIsochrone(
+    Isochrone *isochrone,
+    const Node* nodes,
+    const int vertices,
+    const int edge_count,
+    const int* edges_start,
+    const int* edge_destinations,
+    const float* edge_weights,
+    const float* dist,
+    const float limit,
+    const int band_count);
+void freeIsochrone(Isochrone *isochrone);
+
+#endif //ISOCHRONE_UTILS_H
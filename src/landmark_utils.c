@@ -0,0 +1,476 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <float.h>  // For FLT_MAX
+
+#include "landmark_utils.h"
+#include "heap_utils.h"  // Include MinHeap functions
+#include "task_utils.h"  // Include parallelFor function
+#include "haversine.h"  // Include haversine function
+
+#define INF FLT_MAX
+
+#define LANDMARK_FILE_MAGIC 0x4D4C504F  // "OPLM"
+#define LANDMARK_FILE_VERSION 2
+
+// Define a struct holding the arguments of the parallel landmark distance calculation
+typedef struct {
+    Landmarks *landmarks;
+    int vertices;
+    int edge_count;
+    const int* edges_start;
+    const int* edge_destinations;
+    const float* edge_weights;
+} LandmarkTask;
+
+// Dijkstra's algorithm over the flattened arrays using a binary heap.
+// Stores the settled nodes in order (if given) and returns the number of settled nodes.
+static int csrDijkstra(
+        const int vertices,
+        const int edge_count,
+        const int* edges_start,
+        const int* edge_destinations,
+        const float* edge_weights,
+        const int source,
+        float* dist,
+        int* prev,
+        int* order,
+        MinHeap *heap) {
+
+    // Initialize all distances as INFINITE and previous as -1
+    for (int i = 0; i < vertices; i++) {
+        dist[i] = INF;
+        if (prev != NULL) prev[i] = -1;
+    }
+    dist[source] = 0;
+
+    clearHeap(heap);
+    pushHeap(heap, source, 0);
+
+    int settled = 0;
+    int node;
+    float key;
+    while (popHeap(heap, &node, &key)) {
+        // Skip outdated heap entries
+        if (key > dist[node]) {
+            continue;
+        }
+        if (order != NULL) {
+            order[settled] = node;
+        }
+        settled++;
+
+        const int edge_end = (node == vertices - 1) ? edge_count : edges_start[node + 1];
+        for (int edge = edges_start[node]; edge < edge_end; edge++) {
+            const float new_dist = key + edge_weights[edge];
+            if (new_dist < dist[edge_destinations[edge]]) {
+                dist[edge_destinations[edge]] = new_dist;
+                if (prev != NULL) prev[edge_destinations[edge]] = node;
+                pushHeap(heap, edge_destinations[edge], new_dist);
+            }
+        }
+    }
+    return settled;
+}
+
+// Function to calculate the triangle inequality bound using the first `count` landmarks
+static float partialLowerBound(const Landmarks *landmarks, const int count, const int node, const int target) {
+    float bound = 0;
+    for (int l = 0; l < count; l++) {
+        const float *distances = landmarks->distances + (size_t) l * landmarks->vertices;
+        const float to_target = distances[target];
+        const float to_node = distances[node];
+
+        // A landmark in another component provides no information
+        if (to_target == INF && to_node == INF) {
+            continue;
+        }
+        // Node and target are in different components
+        if (to_target == INF || to_node == INF) {
+            return INF;
+        }
+
+        const float difference = fabsf(to_target - to_node);
+        if (difference > bound) {
+            bound = difference;
+        }
+    }
+    return bound;
+}
+
+// Function to check if a node has at least one edge
+static int hasEdges(const int node, const int vertices, const int edge_count, const int* edges_start) {
+    const int edge_end = (node == vertices - 1) ? edge_count : edges_start[node + 1];
+    return edges_start[node] != edge_end;
+}
+
+// Function to calculate the distances of the landmarks begin to end - 1 of a landmark task
+static void calculateLandmarkDistances(void *context, const int begin, const int end, const int worker_id) {
+    const LandmarkTask *task = context;
+    Landmarks *landmarks = task->landmarks;
+
+    MinHeap heap;
+    initializeHeap(&heap, 1024);
+    for (int l = begin; l < end; l++) {
+        csrDijkstra(task->vertices, task->edge_count, task->edges_start, task->edge_destinations,
+                    task->edge_weights, landmarks->landmarks[l],
+                    landmarks->distances + (size_t) l * task->vertices, NULL, NULL, &heap);
+    }
+    freeHeap(&heap);
+}
+
+// Function to pick landmarks that are spread over the graph by repeatedly taking
+// the node with the largest geographical distance to all landmarks chosen so far
+static void selectFarthestLandmarks(
+        Landmarks *landmarks,
+        const Node* nodes,
+        const int vertices,
+        const int edge_count,
+        const int* edges_start) {
+
+    float *min_distance = malloc(vertices * sizeof(float));
+    if (min_distance == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for landmark selection.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Use the first connected node as reference for the first landmark
+    int reference = 0;
+    while (reference < vertices - 1 && !hasEdges(reference, vertices, edge_count, edges_start)) {
+        reference++;
+    }
+    for (int v = 0; v < vertices; v++) {
+        min_distance[v] = hasEdges(v, vertices, edge_count, edges_start)
+            ? haversine(nodes[reference].lat, nodes[reference].lon, nodes[v].lat, nodes[v].lon)
+            : -1;
+    }
+
+    for (int l = 0; l < landmarks->count; l++) {
+        // Take the node that is farthest away from all current landmarks
+        int best = 0;
+        for (int v = 1; v < vertices; v++) {
+            if (min_distance[v] > min_distance[best]) best = v;
+        }
+        landmarks->landmarks[l] = best;
+
+        // Update the distance of each node to its closest landmark
+        for (int v = 0; v < vertices; v++) {
+            if (min_distance[v] < 0) continue;
+            const float distance = haversine(nodes[best].lat, nodes[best].lon, nodes[v].lat, nodes[v].lon);
+            if (distance < min_distance[v]) min_distance[v] = distance;
+        }
+        min_distance[best] = -1;
+    }
+
+    free(min_distance);
+}
+
+// Define a struct holding one step of the avoid heuristic: the distances of the landmark picked last and the
+// shortest path tree of the next root don't depend on each other, so both Dijkstra searches run at the same time
+typedef struct {
+    int vertices;
+    int edge_count;
+    const int* edges_start;
+    const int* edge_destinations;
+    const float* edge_weights;
+    int landmark;  // Landmark whose distances are calculated, -1 if there is none
+    float *landmark_distances;
+    int root;  // Root of the next shortest path tree, -1 if there is none
+    float *root_dist;
+    int *prev;
+    int *order;
+    int settled;  // Number of nodes settled by the tree of the root
+    MinHeap *heaps;  // One heap for each of the two searches
+} AvoidStepTask;
+
+// Define a struct holding the arguments of the parallel weighting of the shortest path tree
+typedef struct {
+    const Landmarks *landmarks;
+    const Node* nodes;
+    int landmark_count;  // Landmarks picked so far
+    int root;
+    const float *root_dist;
+    const int *order;
+    float *size;
+    int *best_child;
+    char *covered;
+} AvoidWeightTask;
+
+// Function to run the searches of an avoid step, iteration 0 is the landmark and iteration 1 the next root
+static void runAvoidStep(void *context, const int begin, const int end, const int worker_id) {
+    AvoidStepTask *task = context;
+    for (int i = begin; i < end; i++) {
+        if (i == 0 && task->landmark != -1) {
+            csrDijkstra(task->vertices, task->edge_count, task->edges_start, task->edge_destinations,
+                        task->edge_weights, task->landmark, task->landmark_distances, NULL, NULL, &task->heaps[0]);
+        } else if (i == 1 && task->root != -1) {
+            task->settled = csrDijkstra(task->vertices, task->edge_count, task->edges_start,
+                                        task->edge_destinations, task->edge_weights, task->root,
+                                        task->root_dist, task->prev, task->order, &task->heaps[1]);
+        }
+    }
+}
+
+// Function to weight the settled nodes begin to end - 1 by how much the current lower bound underestimates them
+static void weightAvoidNodes(void *context, const int begin, const int end, const int worker_id) {
+    const AvoidWeightTask *task = context;
+    const Node *root = &task->nodes[task->root];
+    for (int i = begin; i < end; i++) {
+        const int v = task->order[i];
+        float bound = partialLowerBound(task->landmarks, task->landmark_count, task->root, v);
+        const float geographic = haversine(root->lat, root->lon, task->nodes[v].lat, task->nodes[v].lon);
+        if (geographic > bound) bound = geographic;
+        task->size[v] = task->root_dist[v] > bound ? task->root_dist[v] - bound : 0;
+        task->best_child[v] = -1;
+        task->covered[v] = 0;
+    }
+}
+
+// Function to pick the next random connected root, -1 if none was found
+static int nextAvoidRoot(unsigned int *seed, const int vertices, const int edge_count, const int* edges_start) {
+    for (int tries = 0; tries < vertices; tries++) {
+        *seed = *seed * 1103515245 + 12345;
+        const int candidate = (int) ((*seed >> 8) % (unsigned int) vertices);
+        if (hasEdges(candidate, vertices, edge_count, edges_start)) return candidate;
+    }
+    return -1;
+}
+
+// Function to pick landmarks with the avoid heuristic (Goldberg and Werneck).
+// From a random root the shortest path tree is built and every node is weighted with the gap between its
+// real distance and the current lower bound. The landmark becomes the leaf reached by descending into the
+// heaviest subtree that contains no landmark yet. Each pick depends on the distances of the previous ones,
+// so the distances of a new landmark are calculated while the tree of the next root is built, and the nodes of
+// every tree are weighted on the threads of the task pool.
+static void selectAvoidLandmarks(
+        Landmarks *landmarks,
+        const Node* nodes,
+        const int vertices,
+        const int edge_count,
+        const int* edges_start,
+        const int* edge_destinations,
+        const float* edge_weights) {
+
+    // The tree of the current root is read while the tree of the next root is built, so there are two of them
+    float *root_dist[2] = {malloc(vertices * sizeof(float)), malloc(vertices * sizeof(float))};
+    int *prev[2] = {malloc(vertices * sizeof(int)), malloc(vertices * sizeof(int))};
+    int *order[2] = {malloc(vertices * sizeof(int)), malloc(vertices * sizeof(int))};
+    float *size = malloc(vertices * sizeof(float));
+    int *best_child = malloc(vertices * sizeof(int));
+    char *covered = calloc(vertices, sizeof(char));
+    if (root_dist[0] == NULL || root_dist[1] == NULL || prev[0] == NULL || prev[1] == NULL ||
+        order[0] == NULL || order[1] == NULL || size == NULL || best_child == NULL || covered == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for landmark selection.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    MinHeap heaps[2];
+    initializeHeap(&heaps[0], 1024);
+    initializeHeap(&heaps[1], 1024);
+
+    AvoidStepTask step = {vertices, edge_count, edges_start, edge_destinations, edge_weights,
+                          -1, NULL, -1, NULL, NULL, NULL, 0, heaps};
+    AvoidWeightTask weight = {landmarks, nodes, 0, -1, NULL, NULL, size, best_child, covered};
+
+    unsigned int seed = 42;  // Fixed seed so repeated runs pick the same landmarks
+    int current = 0;  // Index of the tree of the current root
+    int attempts = 1;
+    int l = 0;
+
+    // Build the shortest path tree of the first root
+    int root = nextAvoidRoot(&seed, vertices, edge_count, edges_start);
+    int settled = 0;
+    if (root != -1) {
+        settled = csrDijkstra(vertices, edge_count, edges_start, edge_destinations, edge_weights,
+                              root, root_dist[0], prev[0], order[0], &heaps[0]);
+    }
+
+    while (root != -1 && l < landmarks->count) {
+        // Weight each node by how much the current lower bound underestimates its distance
+        weight.landmark_count = l;
+        weight.root = root;
+        weight.root_dist = root_dist[current];
+        weight.order = order[current];
+        parallelFor(0, settled, 1024, weightAvoidNodes, &weight);
+        for (int i = 0; i < l; i++) {
+            covered[landmarks->landmarks[i]] = 1;
+        }
+
+        // Accumulate the subtree sizes bottom up, children are settled after their parents
+        for (int i = settled - 1; i > 0; i--) {
+            const int v = order[current][i];
+            const int parent = prev[current][v];
+            if (covered[v]) {
+                covered[parent] = 1;
+                continue;
+            }
+            size[parent] += size[v];
+            if (best_child[parent] == -1 || size[v] > size[best_child[parent]]) {
+                best_child[parent] = v;
+            }
+        }
+
+        // Descend into the heaviest subtree until a leaf is reached
+        int landmark = root;
+        while (best_child[landmark] != -1) {
+            landmark = best_child[landmark];
+        }
+
+        // Calculate the distances of the new landmark while the tree of the next root is built.
+        // If the root itself is a landmark there is no new landmark and only the next tree is built.
+        step.landmark = -1;
+        if (!covered[landmark]) {
+            landmarks->landmarks[l] = landmark;
+            step.landmark = landmark;
+            step.landmark_distances = landmarks->distances + (size_t) l * vertices;
+            l++;
+        }
+        root = -1;
+        if (l < landmarks->count && attempts < 4 * landmarks->count) {
+            root = nextAvoidRoot(&seed, vertices, edge_count, edges_start);
+            attempts++;
+        }
+        step.root = root;
+        step.root_dist = root_dist[1 - current];
+        step.prev = prev[1 - current];
+        step.order = order[1 - current];
+        parallelFor(0, 2, 1, runAvoidStep, &step);
+        settled = step.settled;
+        current = 1 - current;
+    }
+    landmarks->count = l;
+
+    freeHeap(&heaps[0]);
+    freeHeap(&heaps[1]);
+    for (int i = 0; i < 2; i++) {
+        free(root_dist[i]);
+        free(prev[i]);
+        free(order[i]);
+    }
+    free(size);
+    free(best_child);
+    free(covered);
+}
+
+// Function to select the landmarks and calculate the distance between every landmark and every node
+void createLandmarks(
+        Landmarks *landmarks,
+        const Node* nodes,
+        const int vertices,
+        const int edge_count,
+        const int* edges_start,
+        const int* edge_destinations,
+        const float* edge_weights,
+        int count,
+        const LandmarkSelection selection) {
+
+    // There can't be more landmarks than connected nodes
+    int connected = 0;
+    for (int v = 0; v < vertices; v++) {
+        if (hasEdges(v, vertices, edge_count, edges_start)) connected++;
+    }
+    if (count > connected) count = connected;
+
+    landmarks->count = count;
+    landmarks->vertices = vertices;
+    landmarks->landmarks = malloc((count > 0 ? count : 1) * sizeof(int));
+    landmarks->distances = malloc(((size_t) (count > 0 ? count : 1)) * vertices * sizeof(float));
+    if (landmarks->landmarks == NULL || landmarks->distances == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for landmarks.\n");
+        exit(EXIT_FAILURE);
+    }
+    if (count == 0) {
+        return;
+    }
+
+    if (selection == LANDMARKS_AVOID) {
+        selectAvoidLandmarks(landmarks, nodes, vertices, edge_count, edges_start, edge_destinations, edge_weights);
+        return;
+    }
+
+    selectFarthestLandmarks(landmarks, nodes, vertices, edge_count, edges_start);
+
+    // Calculate the distances of all landmarks in parallel on the threads of the task pool
+    LandmarkTask task = {landmarks, vertices, edge_count, edges_start, edge_destinations, edge_weights};
+    parallelFor(0, count, 1, calculateLandmarkDistances, &task);
+}
+
+// Function to get the ALT lower bound of the distance between node and target
+float landmarkLowerBound(const Landmarks *landmarks, const int node, const int target) {
+    return partialLowerBound(landmarks, landmarks->count, node, target);
+}
+
+// Function to write the landmarks to a file, so later queries on the same graph can skip the preprocessing
+int saveLandmarks(const Landmarks *landmarks, const char *path, const uint64_t fingerprint) {
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) {
+        fprintf(stderr, "Error: Could not open %s for writing.\n", path);
+        return -1;
+    }
+
+    const int header[4] = {LANDMARK_FILE_MAGIC, LANDMARK_FILE_VERSION, landmarks->vertices, landmarks->count};
+    const size_t distance_count = (size_t) landmarks->count * landmarks->vertices;
+    int ok = fwrite(header, sizeof(int), 4, file) == 4 &&
+             fwrite(&fingerprint, sizeof(uint64_t), 1, file) == 1 &&
+             fwrite(landmarks->landmarks, sizeof(int), landmarks->count, file) == (size_t) landmarks->count &&
+             fwrite(landmarks->distances, sizeof(float), distance_count, file) == distance_count;
+
+    ok = fclose(file) == 0 && ok;
+    if (!ok) {
+        fprintf(stderr, "Error: Could not write landmarks to %s.\n", path);
+        remove(path);
+        return -1;
+    }
+    return 0;
+}
+
+// Function to read landmarks written by saveLandmarks, returns -1 if the file doesn't match the graph
+int loadLandmarks(Landmarks *landmarks, const char *path, const int vertices, const uint64_t fingerprint) {
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        return -1;
+    }
+
+    int header[4];
+    uint64_t file_fingerprint;
+    if (fread(header, sizeof(int), 4, file) != 4 ||
+        fread(&file_fingerprint, sizeof(uint64_t), 1, file) != 1 ||
+        header[0] != LANDMARK_FILE_MAGIC || header[1] != LANDMARK_FILE_VERSION ||
+        header[2] != vertices || header[3] < 0 || file_fingerprint != fingerprint) {
+        fclose(file);
+        return -1;
+    }
+
+    landmarks->vertices = vertices;
+    landmarks->count = header[3];
+    landmarks->landmarks = malloc((landmarks->count > 0 ? landmarks->count : 1) * sizeof(int));
+    landmarks->distances = malloc(((size_t) (landmarks->count > 0 ? landmarks->count : 1)) * vertices * sizeof(float));
+    if (landmarks->landmarks == NULL || landmarks->distances == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for landmarks.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    const size_t distance_count = (size_t) landmarks->count * vertices;
+    if (fread(landmarks->landmarks, sizeof(int), landmarks->count, file) != (size_t) landmarks->count ||
+        fread(landmarks->distances, sizeof(float), distance_count, file) != distance_count) {
+        fclose(file);
+        freeLandmarks(landmarks);
+        return -1;
+    }
+
+    fclose(file);
+    return 0;
+}
+
+// Function to free the landmark memory
+void freeLandmarks(Landmarks *landmarks) {
+    if (landmarks == NULL) {
+        return;
+    }
+    free(landmarks->landmarks);
+    free(landmarks->distances);
+    landmarks->landmarks = NULL;
+    landmarks->distances = NULL;
+    landmarks->count = 0;
+}
@@ -0,0 +1,38 @@
+#ifndef LANDMARK_UTILS_H
+#define LANDMARK_UTILS_H
+
+#include <stdint.h>
+
+#include "graph_utils.h"  // For Node struct
+
+// Strategies to pick the landmarks
+typedef enum {
+    LANDMARKS_FARTHEST,  // Geographically spread landmarks, distances are computed in parallel
+    LANDMARKS_AVOID  // Goldberg's avoid heuristic, places landmarks where the current bounds are weakest
+} LandmarkSelection;
+
+// Define a struct to store the landmarks and their distances alongside the graph
+typedef struct {
+    int count;  // Number of landmarks
+    int vertices;  // Number of vertices the distances were computed for
+    int *landmarks;  // Node index of each landmark
+    float *distances;  // distances[l * vertices + v] holds the shortest distance between landmark l and node v
+} Landmarks;
+
+// Landmark functions
+void createLandmarks(
+    Landmarks *landmarks,
+    const Node* nodes,
+    const int vertices,
+    const int edge_count,
+    const int* edges_start,
+    const int* edge_destinations,
+    const float* edge_weights,
+    const int count,
+    const LandmarkSelection selection);
+float landmarkLowerBound(const Landmarks *landmarks, const int node, const int target);
+int saveLandmarks(const Landmarks *landmarks, const char *path, const uint64_t fingerprint);
+int loadLandmarks(Landmarks *landmarks, const char *path, const int vertices, const uint64_t fingerprint);
+void freeLandmarks(Landmarks *landmarks);
+
+#endif //LANDMARK_UTILS_H
@@ -0,0 +1,283 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <float.h>  // For FLT_MAX
+#include <curl/curl.h>
+#include <time.h>
+
+#include "cli_utils.h" // Include parseArguments and wallTimeMs functions
+#include "data_loader.h"  // Include OverpassAPI functions
+#include "graph_utils.h"  // Include Graph functions
+#include "haversine.h"  // Include haversine function
+#include "heap_utils.h"  // Include MinHeap functions
+#include "landmark_utils.h"  // Include Landmark functions
+#include "cache_utils.h"  // Include cache path and fingerprint functions
+#include "parallel_utils.h"  // Include convert_to_device_arrays function
+#include "output_utils.h"  // Include the route writer
+
+#define INF FLT_MAX
+
+#define LANDMARK_COUNT 8  // Number of landmarks, more landmarks give tighter bounds but cost memory and preprocessing
+#define LANDMARK_SELECTION LANDMARKS_AVOID  // Strategy used to pick the landmarks
+
+// A* search with ALT (A*, Landmarks, Triangle inequality) lower bounds
+int altAStar(
+        const int vertices,
+        const int edge_count,
+        Node nodes[],
+        const int* edges_start,
+        const int* edge_destinations,
+        const float* edge_weights,
+        const Landmarks* landmarks,
+        const int start_index,
+        const int dest_index) {
+
+    // define the distance array. dist[i] holds the shortest known distance form src to i
+    float dist[vertices];
+
+    // define the previous array. prev[i] stores the previous node in the path to i
+    int prev[vertices];
+
+    // define the expanded array. expanded[i] holds the distance i had when its edges were last processed
+    float expanded[vertices];
+
+    // Initialize all distances as INFINITE, previous as -1 and expanded as -1
+    for (int i = 0; i < vertices; i++) {
+        dist[i] = INF;  // Infinite distance to node
+        prev[i] = -1; // Undefined previous node
+        expanded[i] = -1;  // Edges not processed yet
+    }
+
+    // Distance of source vertex from itself is always 0
+    dist[start_index] = 0;
+
+    // The priority queue is ordered by the distance from the start plus the estimated distance to the destination
+    MinHeap heap;
+    initializeHeap(&heap, 1024);
+    pushHeap(&heap, start_index, 0);
+
+    int node;
+    float key;
+    while (popHeap(&heap, &node, &key)) {
+        // Stop as soon as the destination is taken from the queue
+        if (node == dest_index) {
+            break;
+        }
+
+        // Skip outdated queue entries of nodes that were already processed with their current distance
+        if (expanded[node] == dist[node]) {
+            continue;
+        }
+        expanded[node] = dist[node];
+
+        const int edge_end = (node == vertices - 1) ? edge_count : edges_start[node + 1];
+        for (int edge = edges_start[node]; edge < edge_end; edge++) {
+            const int next = edge_destinations[edge];
+            const float new_dist = dist[node] + edge_weights[edge];
+
+            // check if the new distance is shorter that the previous one
+            if (new_dist < dist[next]) {
+                // The landmark bound and the straight line distance are both lower bounds, use the tighter one
+                float estimate = landmarkLowerBound(landmarks, next, dest_index);
+                if (estimate == INF) {
+                    continue;  // The destination can't be reached from this node
+                }
+                const float geographic = haversine(nodes[next].lat, nodes[next].lon,
+                                                   nodes[dest_index].lat, nodes[dest_index].lon);
+                if (geographic > estimate) {
+                    estimate = geographic;
+                }
+
+                // update the dest and prev of the next node
+                dist[next] = new_dist;
+                prev[next] = node;
+                pushHeap(&heap, next, new_dist + estimate);
+            }
+        }
+    }
+
+    freeHeap(&heap);
+
+    // After the loop, check if the target vertex has been reached
+    if (dist[dest_index] != INF) {
+        // Retrieve and print the path
+        int current = dest_index;
+
+        RouteWriter route;
+        beginRoute(&route, "route", 0);
+        while (current != -1) {
+            addRoutePoint(&route, nodes[current].lat, nodes[current].lon);
+            current = prev[current]; // Move to the previous node
+        }
+        endRoute(&route);
+
+        printf("\t\"routeLength\": \"%.2fm\",\n", dist[dest_index]);
+        return 0;
+    }
+    fprintf(stderr, "Target cannot be reached from source\n");
+    return 1;
+}
+
+
+int main(int argc, char *argv[]) {
+    // get the timestamp of the execution start
+    const double total_time_start = wallTimeMs();
+
+    // Start the Response JSON
+    printf("{\n");
+
+    // define arrays for start and destination
+    float start[2];   // Array for starting coordinates
+    float dest[2];    // Array for destination coordinates
+    float* bbox;      // Pointer for bounding box coordinates
+    int bbox_size;     // Size of the bounding box
+
+    // Read the route format, "array" by default or "polyline" for an encoded polyline
+    selectRouteFormat(extractOption(&argc, argv, "route"));
+
+    // Parse the command-line arguments
+    if (parseArguments(argc, argv, start, dest, &bbox, &bbox_size) != 0) {
+        free(bbox);
+        return 1; // Exit if parsing failed
+    }
+
+    // initialise curl
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+
+    // get the nodes closest to the given address
+    const int64_t start_id = getClosestNode(start);
+    if (start_id == -1) {
+        fprintf(stderr, "Couldn't find closest Node to the start coordinates (%f, %f)\n", start[0], start[1]);
+        return 1;
+    }
+    printf("\t\"startNode\": %lld,\n", start_id);
+
+    const int64_t destination_id = getClosestNode(dest);
+    if (destination_id == -1) {
+        fprintf(stderr, "Couldn't find closest node to the destination coordinates (%f, %f)\n", dest[0], dest[1]);
+        return 1;
+    }
+    printf("\t\"destNode\": %lld,\n", destination_id);
+
+    // Initialise nodes Array and nodeCount
+    Node* nodes = NULL;
+    int nodeCount = 0;
+
+    // Initialise roads Array and roadCount
+    Road* roads = NULL;
+    int roadCount = 0;
+
+    // Data import
+    getRoadNodes(
+        bbox,
+        bbox_size,
+        &nodes,
+        &nodeCount,
+        &roads,
+        &roadCount);
+
+    // end curl
+    curl_global_cleanup();
+
+    // free the not needed data
+    free(bbox);
+
+    // Find the index of the start and dest node
+    int start_index = -1;
+    int dest_index = -1;
+    for (int i = 0; i < nodeCount; i++) {
+        if (nodes[i].id == start_id) start_index = i;
+        if (nodes[i].id == destination_id) dest_index = i;
+        if (start_index != -1 && dest_index != -1) break;
+    }
+
+    // If the source or target doesn't exist, exit the function
+    if (start_index == -1 || dest_index == -1) {
+        fprintf(stderr, "Invalid source or target ID\n");
+        free(nodes);
+        return -1;
+    }
+
+    // Define the Graph
+    const double graph_time_start = wallTimeMs();  // start the graph time measurement
+
+    // Fill the Graph using the Roads Data
+    createGraph(nodes, nodeCount, roads, roadCount);
+
+    // free the not needed data
+    free(roads);
+
+    // Create the flattened graph arrays
+    int edges_start[nodeCount];  // Array that holds the starting index inside the edges array for each node
+    int *edge_destinations = NULL; // Array to hold the destination of each edge
+    float *edge_weights = NULL;    // Array to hold the weight of each edge
+
+    // Convert nodes and edges to flattened arrays
+    int edge_count = 0;
+    convert_to_device_arrays(nodes, nodeCount, edges_start, &edge_destinations, &edge_weights, &edge_count);
+
+    // end the graph time and prints its result
+    const double graph_time_end = wallTimeMs();
+    const double graph_time  = graph_time_end - graph_time_start;
+    printf("\t\"graphTime\": %.f,\n", graph_time);
+
+    // Select the landmarks or load them if this graph was already preprocessed
+    const double preprocessing_time_start = wallTimeMs();  // Start the preprocessing time
+
+    const int landmark_config[2] = {LANDMARK_COUNT, LANDMARK_SELECTION};
+    const uint64_t landmark_key = hashBytes(
+        graphFingerprint(nodes, nodeCount, edges_start, edge_destinations, edge_weights, edge_count),
+        landmark_config, sizeof(landmark_config));
+
+    Landmarks landmarks;
+    char landmark_path[1024];
+    const int has_cache = getCachePath(landmark_path, sizeof(landmark_path), "landmarks", landmark_key, "bin") == 0;
+    if (!has_cache || loadLandmarks(&landmarks, landmark_path, nodeCount, landmark_key) != 0) {
+        createLandmarks(&landmarks, nodes, nodeCount, edge_count, edges_start, edge_destinations, edge_weights,
+                        LANDMARK_COUNT, LANDMARK_SELECTION);
+        if (has_cache) {
+            saveLandmarks(&landmarks, landmark_path, landmark_key);
+        }
+    }
+
+    // end the preprocessing time and print its result
+    const double preprocessing_time_end = wallTimeMs();
+    const double preprocessing_time = preprocessing_time_end - preprocessing_time_start;
+    printf("\t\"preprocessingTime\": %.f,\n", preprocessing_time);
+
+    // Run the ALT search with the source and target IDs
+    const double routing_time_start = wallTimeMs();  // Start the routing time
+    if (altAStar(
+        nodeCount,
+        edge_count,
+        nodes,
+        edges_start,
+        edge_destinations,
+        edge_weights,
+        &landmarks,
+        start_index,
+        dest_index) != 0) {
+        freeLandmarks(&landmarks);
+        freeNodes(nodes, nodeCount);
+        return 1;
+    }
+
+    // end the routing time and print its result
+    const double routing_time_end = wallTimeMs();
+    const double routing_time_ms = routing_time_end - routing_time_start;
+
+    freeLandmarks(&landmarks);
+    freeNodes(nodes, nodeCount);
+    free(edge_destinations);
+    free(edge_weights);
+
+    printf("\t\"routingTime\": %.f,\n", routing_time_ms);
+
+    // get the total time and print its result
+    const double total_time_end = wallTimeMs();
+    const double total_time = total_time_end - total_time_start;
+    printf("\t\"totalTime\": %.f,\n", total_time);
+
+    // End the Response JSON
+    printf("\t\"success\": true\n}\n");
+    return 0;
+}
\ No newline at end of file
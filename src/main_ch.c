@@ -0,0 +1,205 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <float.h>  // For FLT_MAX
+#include <curl/curl.h>
+#include <time.h>
+
+#include "cli_utils.h" // Include parseArguments and wallTimeMs functions
+#include "data_loader.h"  // Include OverpassAPI functions
+#include "graph_utils.h"  // Include Graph functions
+#include "ch_utils.h"  // Include Contraction Hierarchy functions
+#include "cache_utils.h"  // Include cache path and fingerprint functions
+#include "parallel_utils.h"  // Include convert_to_device_arrays function
+#include "output_utils.h"  // Include the route writer
+
+#define INF FLT_MAX
+
+// Bidirectional search in the contraction hierarchy
+int contractionHierarchyQuery(
+        Node nodes[],
+        const ContractionHierarchy* ch,
+        const int start_index,
+        const int dest_index) {
+
+    // define the path array, it receives the unpacked node sequence from start to destination
+    int *path = malloc(ch->vertices * sizeof(int));
+    if (path == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the path.\n");
+        return 1;
+    }
+    int path_length = 0;
+
+    const float distance = queryContractionHierarchy(ch, start_index, dest_index, path, &path_length);
+
+    // check if the target vertex has been reached
+    if (distance != INF) {
+        // Print the path from the destination back to the start like the other algorithms
+        RouteWriter route;
+        beginRoute(&route, "route", path_length);
+        for (int i = path_length - 1; i >= 0; i--) {
+            addRoutePoint(&route, nodes[path[i]].lat, nodes[path[i]].lon);
+        }
+        endRoute(&route);
+
+        printf("\t\"routeLength\": \"%.2fm\",\n", distance);
+        free(path);
+        return 0;
+    }
+    free(path);
+    fprintf(stderr, "Target cannot be reached from source\n");
+    return 1;
+}
+
+
+int main(int argc, char *argv[]) {
+    // get the timestamp of the execution start
+    const double total_time_start = wallTimeMs();
+
+    // Start the Response JSON
+    printf("{\n");
+
+    // define arrays for start and destination
+    float start[2];   // Array for starting coordinates
+    float dest[2];    // Array for destination coordinates
+    float* bbox;      // Pointer for bounding box coordinates
+    int bbox_size;     // Size of the bounding box
+
+    // Read the route format, "array" by default or "polyline" for an encoded polyline
+    selectRouteFormat(extractOption(&argc, argv, "route"));
+
+    // Parse the command-line arguments
+    if (parseArguments(argc, argv, start, dest, &bbox, &bbox_size) != 0) {
+        free(bbox);
+        return 1; // Exit if parsing failed
+    }
+
+    // initialise curl
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+
+    // get the nodes closest to the given address
+    const int64_t start_id = getClosestNode(start);
+    if (start_id == -1) {
+        fprintf(stderr, "Couldn't find closest Node to the start coordinates (%f, %f)\n", start[0], start[1]);
+        return 1;
+    }
+    printf("\t\"startNode\": %lld,\n", start_id);
+
+    const int64_t destination_id = getClosestNode(dest);
+    if (destination_id == -1) {
+        fprintf(stderr, "Couldn't find closest node to the destination coordinates (%f, %f)\n", dest[0], dest[1]);
+        return 1;
+    }
+    printf("\t\"destNode\": %lld,\n", destination_id);
+
+    // Initialise nodes Array and nodeCount
+    Node* nodes = NULL;
+    int nodeCount = 0;
+
+    // Initialise roads Array and roadCount
+    Road* roads = NULL;
+    int roadCount = 0;
+
+    // Data import
+    getRoadNodes(
+        bbox,
+        bbox_size,
+        &nodes,
+        &nodeCount,
+        &roads,
+        &roadCount);
+
+    // end curl
+    curl_global_cleanup();
+
+    // free the not needed data
+    free(bbox);
+
+    // Find the index of the start and dest node
+    int start_index = -1;
+    int dest_index = -1;
+    for (int i = 0; i < nodeCount; i++) {
+        if (nodes[i].id == start_id) start_index = i;
+        if (nodes[i].id == destination_id) dest_index = i;
+        if (start_index != -1 && dest_index != -1) break;
+    }
+
+    // If the source or target doesn't exist, exit the function
+    if (start_index == -1 || dest_index == -1) {
+        fprintf(stderr, "Invalid source or target ID\n");
+        free(nodes);
+        return -1;
+    }
+
+    // Define the Graph
+    const double graph_time_start = wallTimeMs();  // start the graph time measurement
+
+    // Fill the Graph using the Roads Data
+    createGraph(nodes, nodeCount, roads, roadCount);
+
+    // free the not needed data
+    free(roads);
+
+    // Create the flattened graph arrays
+    int edges_start[nodeCount];  // Array that holds the starting index inside the edges array for each node
+    int *edge_destinations = NULL; // Array to hold the destination of each edge
+    float *edge_weights = NULL;    // Array to hold the weight of each edge
+
+    // Convert nodes and edges to flattened arrays
+    int edge_count = 0;
+    convert_to_device_arrays(nodes, nodeCount, edges_start, &edge_destinations, &edge_weights, &edge_count);
+
+    // end the graph time and prints its result
+    const double graph_time_end = wallTimeMs();
+    const double graph_time  = graph_time_end - graph_time_start;
+    printf("\t\"graphTime\": %.f,\n", graph_time);
+
+    // Build the contraction hierarchy or load it if this graph was already preprocessed
+    const double preprocessing_time_start = wallTimeMs();  // Start the preprocessing time
+
+    const uint64_t fingerprint = graphFingerprint(nodes, nodeCount, edges_start, edge_destinations, edge_weights, edge_count);
+
+    ContractionHierarchy ch;
+    char ch_path[1024];
+    const int has_cache = getCachePath(ch_path, sizeof(ch_path), "hierarchy", fingerprint, "bin") == 0;
+    if (!has_cache || loadContractionHierarchy(&ch, ch_path, nodeCount, fingerprint) != 0) {
+        buildContractionHierarchy(&ch, nodeCount, edge_count, edges_start, edge_destinations, edge_weights);
+        if (has_cache) {
+            saveContractionHierarchy(&ch, ch_path, fingerprint);
+        }
+    }
+
+    // the flattened graph is fully contained in the hierarchy
+    free(edge_destinations);
+    free(edge_weights);
+
+    // end the preprocessing time and print its result
+    const double preprocessing_time_end = wallTimeMs();
+    const double preprocessing_time = preprocessing_time_end - preprocessing_time_start;
+    printf("\t\"preprocessingTime\": %.f,\n", preprocessing_time);
+
+    // Run the hierarchy query with the source and target IDs
+    const double routing_time_start = wallTimeMs();  // Start the routing time
+    if (contractionHierarchyQuery(nodes, &ch, start_index, dest_index) != 0) {
+        freeContractionHierarchy(&ch);
+        freeNodes(nodes, nodeCount);
+        return 1;
+    }
+
+    // end the routing time and print its result
+    const double routing_time_end = wallTimeMs();
+    const double routing_time_ms = routing_time_end - routing_time_start;
+
+    freeContractionHierarchy(&ch);
+    freeNodes(nodes, nodeCount);
+
+    printf("\t\"routingTime\": %.f,\n", routing_time_ms);
+
+    // get the total time and print its result
+    const double total_time_end = wallTimeMs();
+    const double total_time = total_time_end - total_time_start;
+    printf("\t\"totalTime\": %.f,\n", total_time);
+
+    // End the Response JSON
+    printf("\t\"success\": true\n}\n");
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,230 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <float.h>  // For FLT_MAX
+#include <curl/curl.h>
+#include <time.h>
+
+#include "cli_utils.h" // Include parseArguments, parsePoints and extractOption functions
+#include "data_loader.h"  // Include OverpassAPI functions
+#include "graph_utils.h"  // Include Graph functions
+#include "parallel_utils.h"  // Include the flattening of the graph
+#include "task_utils.h"  // Include the task pool
+#include "matrix_utils.h"  // Include snapToGraph function
+#include "dynamic_utils.h"  // Include the dynamic graph functions
+#include "output_utils.h"  // Include the route writer
+
+#define INF FLT_MAX
+
+// Function to print the route from the source of the tree to dest_index and its length, null if it can't be reached
+static void printRoute(const char* name, const Node* nodes, const ShortestPathTree* tree, const int dest_index) {
+    if (tree->dist[dest_index] == INF) {
+        printf("\t\"%s\": null,\n", name);
+        printf("\t\"%sLength\": null,\n", name);
+        return;
+    }
+
+    RouteWriter route;
+    beginRoute(&route, name, 0);
+    for (int current = dest_index; current != -1; current = tree->prev[current]) {
+        addRoutePoint(&route, nodes[current].lat, nodes[current].lon);
+    }
+    endRoute(&route);
+    printf("\t\"%sLength\": \"%.2fm\",\n", name, tree->dist[dest_index]);
+}
+
+// Function to close every edge between the nodes a and b in both directions, returns the number of added updates
+static int closeSegment(const DynamicGraph* graph, const int a, const int b, EdgeUpdate* updates) {
+    int update_count = 0;
+    const int ends[2][2] = {{a, b}, {b, a}};
+    for (int direction = 0; direction < 2; direction++) {
+        const int from = ends[direction][0];
+        const int to = ends[direction][1];
+        const int edge_end = (from == graph->vertices - 1) ? graph->edge_count : graph->edges_start[from + 1];
+        for (int edge = graph->edges_start[from]; edge < edge_end; edge++) {
+            if (graph->edge_destinations[edge] == to) {
+                updates[update_count].edge = edge;
+                updates[update_count].weight = INF;
+                update_count++;
+            }
+        }
+    }
+    return update_count;
+}
+
+
+int main(int argc, char *argv[]) {
+    // get the timestamp of the execution start
+    const double total_time_start = wallTimeMs();
+
+    // Start the Response JSON
+    printf("{\n");
+
+    // Read the closed road segments and the thread count, the remaining arguments are start, destination and bounding
+    // box. Every two points of the closures are the ends of one closed segment.
+    const char* closures_option = extractOption(&argc, argv, "closures");
+    initializeTaskPool(threadCount(extractOption(&argc, argv, "threads")));
+    const int thread_count = taskThreadCount();
+
+    float* closure_points = NULL;
+    int closure_point_count = 0;
+    if (parsePoints(closures_option, &closure_points, &closure_point_count) != 0) {
+        return 1;
+    }
+    if (closure_point_count % 2 != 0) {
+        fprintf(stderr, "The closures need two points for every closed segment\n");
+        free(closure_points);
+        return 1;
+    }
+
+    // define arrays for start and destination
+    float start[2];   // Array for starting coordinates
+    float dest[2];    // Array for destination coordinates
+    float* bbox;      // Pointer for bounding box coordinates
+    int bbox_size;     // Size of the bounding box
+
+    // Read the route format, "array" by default or "polyline" for an encoded polyline
+    selectRouteFormat(extractOption(&argc, argv, "route"));
+
+    // Parse the command-line arguments
+    if (parseArguments(argc, argv, start, dest, &bbox, &bbox_size) != 0) {
+        free(bbox);
+        free(closure_points);
+        return 1; // Exit if parsing failed
+    }
+
+    // initialise curl
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+
+    // Initialise nodes Array and nodeCount
+    Node* nodes = NULL;
+    int nodeCount = 0;
+
+    // Initialise roads Array and roadCount
+    Road* roads = NULL;
+    int roadCount = 0;
+
+    // Data import
+    getRoadNodes(
+        bbox,
+        bbox_size,
+        &nodes,
+        &nodeCount,
+        &roads,
+        &roadCount);
+
+    // end curl
+    curl_global_cleanup();
+
+    // free the not needed data
+    free(bbox);
+
+    // Define the Graph
+    const double graph_time_start = wallTimeMs();  // start the graph time measurement
+
+    // Fill the Graph using the Roads Data
+    createGraph(nodes, nodeCount, roads, roadCount);
+
+    // free the not needed data
+    free(roads);
+
+    // Flatten the graph into arrays
+    int *edges_start = malloc((nodeCount > 0 ? nodeCount : 1) * sizeof(int));  // starting index inside the edges array for each node
+    int *edge_destinations = NULL; // Array to hold the destination of each edge
+    float *edge_weights = NULL;    // Array to hold the weight of each edge
+    if (edges_start == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the graph.\n");
+        exit(EXIT_FAILURE);
+    }
+    int edge_count = 0;
+    convert_to_device_arrays(nodes, nodeCount, edges_start, &edge_destinations, &edge_weights, &edge_count);
+
+    // Snap the start, the destination and the ends of the closed segments to their closest nodes
+    const int start_index = snapToGraph(nodes, nodeCount, edge_count, edges_start, start);
+    const int dest_index = snapToGraph(nodes, nodeCount, edge_count, edges_start, dest);
+    int closure_indices[closure_point_count > 0 ? closure_point_count : 1];
+    snapPoints(nodes, nodeCount, edge_count, edges_start, closure_points, closure_point_count, closure_indices);
+    free(closure_points);
+    if (start_index == -1 || dest_index == -1) {
+        fprintf(stderr, "Couldn't find nodes close to the start and destination coordinates\n");
+        freeNodes(nodes, nodeCount);
+        free(edges_start);
+        free(edge_destinations);
+        free(edge_weights);
+        return 1;
+    }
+    printf("\t\"startNode\": %lld,\n", (long long) nodes[start_index].id);
+    printf("\t\"destNode\": %lld,\n", (long long) nodes[dest_index].id);
+
+    // Collect the incoming edges, they are needed to repair the tree
+    DynamicGraph graph;
+    createDynamicGraph(&graph, nodeCount, edge_count, edges_start, edge_destinations, edge_weights);
+
+    // end the graph time and prints its result
+    const double graph_time = wallTimeMs() - graph_time_start;
+    printf("\t\"graphTime\": %.f,\n", graph_time);
+    printf("\t\"threads\": %d,\n", thread_count);
+
+    // Calculate the shortest-path tree of the start node before the closures
+    const double routing_time_start = wallTimeMs();  // Start the routing time
+    ShortestPathTree tree;
+    computeShortestPathTree(&tree, &graph, start_index);
+    const double routing_time_ms = wallTimeMs() - routing_time_start;
+    printRoute("route", nodes, &tree, dest_index);
+    printf("\t\"routingTime\": %.f,\n", routing_time_ms);
+
+    // Close the segments, ends that were snapped to the same node don't close anything.
+    // A segment closes at most all edges of its two ends.
+    int update_capacity = 1;
+    for (int i = 0; i < closure_point_count; i++) {
+        const int node = closure_indices[i];
+        if (node != -1) {
+            update_capacity += ((node == nodeCount - 1) ? edge_count : edges_start[node + 1]) - edges_start[node];
+        }
+    }
+    EdgeUpdate *updates = malloc(update_capacity * sizeof(EdgeUpdate));
+    if (updates == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the edge updates.\n");
+        exit(EXIT_FAILURE);
+    }
+    int update_count = 0;
+    for (int i = 0; i + 1 < closure_point_count; i += 2) {
+        const int a = closure_indices[i];
+        const int b = closure_indices[i + 1];
+        if (a != -1 && b != -1 && a != b) {
+            update_count += closeSegment(&graph, a, b, updates + update_count);
+        }
+    }
+    printf("\t\"closedEdges\": %d,\n", update_count);
+
+    // Repair the tree, only the subtrees below the closed edges are calculated again
+    const double repair_time_start = wallTimeMs();
+    const int repaired_nodes = applyEdgeUpdates(&graph, updates, update_count, &tree, 1);
+    const double repair_time = wallTimeMs() - repair_time_start;
+    printRoute("closedRoute", nodes, &tree, dest_index);
+    printf("\t\"repairedNodes\": %d,\n", repaired_nodes);
+    printf("\t\"repairTime\": %.3f,\n", repair_time);
+
+    // Calculate the tree again from scratch for comparison
+    const double recompute_time_start = wallTimeMs();
+    ShortestPathTree recomputed;
+    computeShortestPathTree(&recomputed, &graph, start_index);
+    const double recompute_time = wallTimeMs() - recompute_time_start;
+    printf("\t\"recomputeTime\": %.3f,\n", recompute_time);
+
+    freeShortestPathTree(&recomputed);
+    freeShortestPathTree(&tree);
+    freeDynamicGraph(&graph);
+    free(updates);
+    freeNodes(nodes, nodeCount);
+    free(edges_start);
+    free(edge_destinations);
+    free(edge_weights);
+
+    // get the total time and print its result
+    const double total_time = wallTimeMs() - total_time_start;
+    printf("\t\"totalTime\": %.f,\n", total_time);
+
+    // End the Response JSON
+    printf("\t\"success\": true\n}\n");
+    return 0;
+}
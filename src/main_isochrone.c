@@ -0,0 +1,309 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <float.h>  // For FLT_MAX
+#include <curl/curl.h>
+#include <time.h>
+#include <stdatomic.h>
+
+#include "cli_utils.h" // Include parseBoundingBox and extractOption functions
+#include "data_loader.h"  // Include OverpassAPI functions
+#include "graph_utils.h"  // Include Graph functions
+#include "parallel_utils.h"  // Include convert_to_device_arrays function
+#include "delta_utils.h"  // Include selectDelta function
+#include "task_utils.h"  // Include the task pool
+#include "simd_utils.h"  // Include selectRelaxKernel function
+#include "threaded_utils.h"  // Include threadedDeltaStepping function
+#include "matrix_utils.h"  // Include snapToGraph function
+#include "isochrone_utils.h"  // Include the isochrone functions
+#include "opencl_engine.h"  // Include the OpenCL engine
+
+#define INF FLT_MAX
+
+#define PHASE_COST 4096.0f  // Number of edge relaxations that take about as long as the launches and transfers of a phase
+
+// Function to print the nodes within the limit as (lat, lon, distance) triples
+static void printReachableNodes(const Node* nodes, const int vertices, const float* dist, const float limit) {
+    int reachable = 0;
+    for (int i = 0; i < vertices; i++) {
+        if (dist[i] <= limit) reachable++;
+    }
+    printf("\t\"reachableNodes\": %d,\n", reachable);
+
+    printf("\t\"reachable\": [");
+    int printed = 0;
+    for (int i = 0; i < vertices; i++) {
+        if (dist[i] <= limit) {
+            printf("%s[%f, %f, %.1f]", printed++ > 0 ? ", " : "", nodes[i].lat, nodes[i].lon, dist[i]);
+        }
+    }
+    printf("],\n");
+}
+
+// Function to print the bands of the isochrone with their polygons
+static void printIsochrone(const Isochrone *isochrone) {
+    printf("\t\"bands\": [\n");
+    for (int b = 0; b < isochrone->band_count; b++) {
+        const IsochroneBand *band = &isochrone->bands[b];
+        printf("\t\t{\"limit\": %.1f, \"nodes\": %d, \"polygon\": [", band->limit, band->node_count);
+        for (int i = 0; i < band->polygon_size; i++) {
+            printf("%s[%f, %f]", i > 0 ? ", " : "", band->polygon[2 * i], band->polygon[2 * i + 1]);
+        }
+        printf("]}%s\n", b < isochrone->band_count - 1 ? "," : "");
+    }
+    printf("\t],\n");
+}
+
+
+int main(int argc, char *argv[]) {
+    // get the timestamp of the execution start
+    const double total_time_start = wallTimeMs();
+
+    // Start the Response JSON
+    printf("{\n");
+
+    // Read the distance limit in meters and the number of bands it is split into
+    const char* limit_option = extractOption(&argc, argv, "limit");
+    const char* bands_option = extractOption(&argc, argv, "bands");
+    const float limit = limit_option != NULL ? strtof(limit_option, NULL) : 0;
+    if (!(limit > 0)) {
+        fprintf(stderr, "The limit option must be a distance in meters greater than 0\n");
+        return 1;
+    }
+    const int band_count = bands_option != NULL ? atoi(bands_option) : 1;
+    if (band_count < 1) {
+        fprintf(stderr, "The bands option must be at least 1\n");
+        return 1;
+    }
+
+    // Read the backend, "threads" by default or "opencl", and their settings
+    const char* backend_option = extractOption(&argc, argv, "backend");
+    int use_opencl = 0;
+    if (backend_option != NULL && strcmp(backend_option, "opencl") == 0) {
+        use_opencl = 1;
+    } else if (backend_option != NULL && strcmp(backend_option, "threads") != 0) {
+        fprintf(stderr, "Ignoring unknown backend '%s', using the threads instead\n", backend_option);
+    }
+    const char* delta_option = extractOption(&argc, argv, "delta");
+    const char* relaxation_option = extractOption(&argc, argv, "relaxation");
+    const char* strategy_option = extractOption(&argc, argv, "strategy");
+    const char* kernels_option = extractOption(&argc, argv, "kernels");
+    const char* platform_option = extractOption(&argc, argv, "platform");
+    const char* device_option = extractOption(&argc, argv, "device");
+    const char* kernel_name;
+    const RelaxKernel kernel = selectRelaxKernel(extractOption(&argc, argv, "simd"), &kernel_name);
+    initializeTaskPool(threadCount(extractOption(&argc, argv, "threads")));
+    const int thread_count = taskThreadCount();
+
+    // Parse the start point, the bounding box follows it
+    argc = skipUnknownOptions(argc, argv);
+    if (argc < 3) {
+        fprintf(stderr, "Invalid Arguments\n "
+                        "Usage: --limit=meters start_lat start_lon bbox_lat1 bbox_lon1 bbox_lat2 bbox_lon2 ...\n");
+        return 1;
+    }
+    const float start[2] = {strtof(argv[1], NULL), strtof(argv[2], NULL)};
+    float* bbox;      // Pointer for bounding box coordinates
+    int bbox_size;     // Size of the bounding box
+    if (parseBoundingBox(argc - 2, argv + 2, &bbox, &bbox_size) != 0) {
+        free(bbox);
+        return 1; // Exit if parsing failed
+    }
+
+    // initialise curl
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+
+    // Initialise nodes Array and nodeCount
+    Node* nodes = NULL;
+    int nodeCount = 0;
+
+    // Initialise roads Array and roadCount
+    Road* roads = NULL;
+    int roadCount = 0;
+
+    // Data import
+    getRoadNodes(
+        bbox,
+        bbox_size,
+        &nodes,
+        &nodeCount,
+        &roads,
+        &roadCount);
+
+    // end curl
+    curl_global_cleanup();
+
+    // free the not needed data
+    free(bbox);
+
+    // Define the Graph
+    const double graph_time_start = wallTimeMs();  // start the graph time measurement
+
+    // Fill the Graph using the Roads Data
+    createGraph(nodes, nodeCount, roads, roadCount);
+
+    // free the not needed data
+    free(roads);
+
+    // Flatten the graph into arrays
+    int *edges_start = malloc((nodeCount > 0 ? nodeCount : 1) * sizeof(int));  // starting index inside the edges array for each node
+    int *light_end = malloc((nodeCount > 0 ? nodeCount : 1) * sizeof(int));  // index of the first heavy edge for each node
+    int *edge_destinations = NULL; // Array to hold the destination of each edge
+    float *edge_weights = NULL;    // Array to hold the weight of each edge
+    if (edges_start == NULL || light_end == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the graph.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    int edge_count = 0;
+    convert_to_device_arrays(nodes, nodeCount, edges_start, &edge_destinations, &edge_weights, &edge_count);
+
+    // Snap the start point to its closest node
+    const int start_index = snapToGraph(nodes, nodeCount, edge_count, edges_start, start);
+    if (start_index == -1) {
+        fprintf(stderr, "Couldn't find a node close to the start coordinates (%f, %f)\n", start[0], start[1]);
+        freeNodes(nodes, nodeCount);
+        free(edges_start);
+        free(light_end);
+        free(edge_destinations);
+        free(edge_weights);
+        return 1;
+    }
+    printf("\t\"startNode\": %lld,\n", (long long) nodes[start_index].id);
+
+    // Determine the bucket width, a phase costs time on every thread or the launches and transfers of the device
+    GraphStats stats;
+    computeGraphStats(&stats, nodeCount, edge_count, edge_weights);
+    const float delta = selectDelta(
+        delta_option, &stats, nodeCount, edge_count, edges_start, edge_destinations, edge_weights, start_index,
+        use_opencl ? PHASE_COST : PHASE_COST_PER_THREAD * (float) thread_count);
+    partition_light_heavy_edges(nodeCount, edge_count, edges_start, edge_destinations, edge_weights, delta, light_end);
+
+    // end the graph time and prints its result
+    const double graph_time = wallTimeMs() - graph_time_start;
+    printf("\t\"graphTime\": %.f,\n", graph_time);
+    printf("\t\"delta\": %.2f,\n", delta);
+    printf("\t\"limit\": %.1f,\n", limit);
+    printf("\t\"backend\": \"%s\",\n", use_opencl ? "opencl" : "threads");
+    printf("\t\"threads\": %d,\n", thread_count);
+    if (!use_opencl) {
+        printf("\t\"simd\": \"%s\",\n", kernel_name);
+    }
+
+    // Calculate the distances up to the limit
+    float *dist = malloc((nodeCount > 0 ? nodeCount : 1) * sizeof(float));
+    if (dist == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the distances.\n");
+        exit(EXIT_FAILURE);
+    }
+    double routing_time_ms;
+    if (use_opencl) {
+        EngineRelaxation relaxation = RELAXATION_ATOMIC;
+        if (relaxation_option != NULL && strcmp(relaxation_option, "plain") == 0) {
+            relaxation = RELAXATION_PLAIN;
+        } else if (relaxation_option != NULL && strcmp(relaxation_option, "fixed") == 0) {
+            relaxation = RELAXATION_FIXED;
+        }
+        const int specialize = kernels_option == NULL || strcmp(kernels_option, "generic") != 0;
+        EngineStrategy strategy = STRATEGY_BUCKETS;
+        if (strategy_option != NULL && strcmp(strategy_option, "nearfar") == 0) {
+            strategy = STRATEGY_NEAR_FAR;
+        }
+
+        // Select the OpenCL device and upload the graph
+        OpenCLDevice device;
+        if (selectDevice(&device, platform_option, device_option) != 0) {
+            freeNodes(nodes, nodeCount);
+            free(dist);
+            free(edges_start);
+            free(light_end);
+            free(edge_destinations);
+            free(edge_weights);
+            return 1;
+        }
+        printf("\t\"device\": \"%s (%s)\",\n", device.name, deviceTypeName(device.type));
+        OpenCLEngine engine;
+        createEngine(
+            &engine,
+            &device,
+            strategy,
+            relaxation,
+            specialize,
+            nodeCount,
+            edge_count,
+            edges_start,
+            light_end,
+            edge_destinations,
+            edge_weights,
+            delta,
+            stats.max_weight);
+
+        const double routing_time_start = wallTimeMs();  // Start the routing time
+        int *prev = malloc((nodeCount > 0 ? nodeCount : 1) * sizeof(int));
+        if (prev == NULL) {
+            fprintf(stderr, "Error: Unable to allocate memory for the previous nodes.\n");
+            exit(EXIT_FAILURE);
+        }
+        runEngineBoundedQuery(&engine, start_index, limit, dist, prev);
+        routing_time_ms = wallTimeMs() - routing_time_start;
+        free(prev);
+        freeEngine(&engine);
+    } else {
+        _Atomic uint64_t* labels = malloc(nodeCount * sizeof(_Atomic uint64_t));
+        if (labels == NULL) {
+            fprintf(stderr, "Error: Unable to allocate memory for the labels.\n");
+            exit(EXIT_FAILURE);
+        }
+
+        // Settle every node up to the limit, there is no destination to stop at
+        const double routing_time_start = wallTimeMs();  // Start the routing time
+        threadedDeltaStepping(
+            nodeCount,
+            edge_count,
+            edges_start,
+            light_end,
+            delta,
+            stats.max_weight,
+            edge_destinations,
+            edge_weights,
+            kernel,
+            start_index,
+            -1,
+            limit,
+            labels);
+        for (int i = 0; i < nodeCount; i++) {
+            dist[i] = labelDistance(atomic_load(&labels[i]));
+        }
+        routing_time_ms = wallTimeMs() - routing_time_start;
+        free(labels);
+    }
+    printf("\t\"routingTime\": %.f,\n", routing_time_ms);
+
+    // Calculate the polygons of the bands
+    const double isochrone_time_start = wallTimeMs();
+    Isochrone isochrone;
+    computeIsochrone(
+        &isochrone, nodes, nodeCount, edge_count, edges_start, edge_destinations, edge_weights, dist, limit, band_count);
+    const double isochrone_time = wallTimeMs() - isochrone_time_start;
+
+    printReachableNodes(nodes, nodeCount, dist, limit);
+    printIsochrone(&isochrone);
+    printf("\t\"isochroneTime\": %.f,\n", isochrone_time);
+
+    freeIsochrone(&isochrone);
+    freeNodes(nodes, nodeCount);
+    free(dist);
+    free(edges_start);
+    free(light_end);
+    free(edge_destinations);
+    free(edge_weights);
+
+    // get the total time and print its result
+    const double total_time = wallTimeMs() - total_time_start;
+    printf("\t\"totalTime\": %.f,\n", total_time);
+
+    // End the Response JSON
+    printf("\t\"success\": true\n}\n");
+    return 0;
+}
@@ -0,0 +1,177 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <float.h>  // For FLT_MAX
+#include <curl/curl.h>
+#include <time.h>
+
+#include "cli_utils.h" // Include parseBoundingBox, parsePoints and extractOption functions
+#include "data_loader.h"  // Include OverpassAPI functions
+#include "graph_utils.h"  // Include Graph functions
+#include "parallel_utils.h"  // Include the flattening of the graph
+#include "task_utils.h"  // Include the task pool
+#include "matrix_utils.h"  // Include the distance matrix functions
+
+#define INF FLT_MAX
+
+// Function to print the OSM IDs of the snapped nodes, null for points that could not be snapped
+static void printSnappedNodes(const char* name, const Node* nodes, const int* indices, const int count) {
+    printf("\t\"%s\": [", name);
+    for (int i = 0; i < count; i++) {
+        if (indices[i] == -1) {
+            printf("%snull", i > 0 ? ", " : "");
+        } else {
+            printf("%s%lld", i > 0 ? ", " : "", (long long) nodes[indices[i]].id);
+        }
+    }
+    printf("],\n");
+}
+
+// Function to print the matrix with one row per source, unreachable targets are null
+static void printDistanceMatrix(const DistanceMatrix *matrix) {
+    printf("\t\"matrix\": [\n");
+    for (int s = 0; s < matrix->source_count; s++) {
+        const float *row = matrix->distances + (size_t) s * matrix->target_count;
+        printf("\t\t[");
+        for (int t = 0; t < matrix->target_count; t++) {
+            if (row[t] == INF) {
+                printf("%snull", t > 0 ? "," : "");
+            } else {
+                printf("%s%.1f", t > 0 ? "," : "", row[t]);
+            }
+        }
+        printf("]%s\n", s < matrix->source_count - 1 ? "," : "");
+    }
+    printf("\t],\n");
+}
+
+
+int main(int argc, char *argv[]) {
+    // get the timestamp of the execution start
+    const double total_time_start = wallTimeMs();
+
+    // Start the Response JSON
+    printf("{\n");
+
+    // Read the sources, the targets and the thread count, the remaining arguments are the bounding box.
+    // Without targets the distances between all sources are calculated.
+    const char* sources_option = extractOption(&argc, argv, "sources");
+    const char* targets_option = extractOption(&argc, argv, "targets");
+    initializeTaskPool(threadCount(extractOption(&argc, argv, "threads")));
+    const int thread_count = taskThreadCount();
+
+    float* source_points = NULL;
+    int source_count = 0;
+    if (parsePoints(sources_option, &source_points, &source_count) != 0) {
+        return 1;
+    }
+    float* target_points = source_points;
+    int target_count = source_count;
+    if (targets_option != NULL && parsePoints(targets_option, &target_points, &target_count) != 0) {
+        free(source_points);
+        return 1;
+    }
+
+    float* bbox;      // Pointer for bounding box coordinates
+    int bbox_size;     // Size of the bounding box
+    if (parseBoundingBox(argc, argv, &bbox, &bbox_size) != 0) {
+        free(bbox);
+        free(source_points);
+        if (target_points != source_points) free(target_points);
+        return 1; // Exit if parsing failed
+    }
+
+    // initialise curl
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+
+    // Initialise nodes Array and nodeCount
+    Node* nodes = NULL;
+    int nodeCount = 0;
+
+    // Initialise roads Array and roadCount
+    Road* roads = NULL;
+    int roadCount = 0;
+
+    // Data import
+    getRoadNodes(
+        bbox,
+        bbox_size,
+        &nodes,
+        &nodeCount,
+        &roads,
+        &roadCount);
+
+    // end curl
+    curl_global_cleanup();
+
+    // free the not needed data
+    free(bbox);
+
+    // Define the Graph
+    const double graph_time_start = wallTimeMs();  // start the graph time measurement
+
+    // Fill the Graph using the Roads Data
+    createGraph(nodes, nodeCount, roads, roadCount);
+
+    // free the not needed data
+    free(roads);
+
+    // Flatten the graph into arrays
+    int *edges_start = malloc((nodeCount > 0 ? nodeCount : 1) * sizeof(int));  // starting index inside the edges array for each node
+    int *edge_destinations = NULL; // Array to hold the destination of each edge
+    float *edge_weights = NULL;    // Array to hold the weight of each edge
+    if (edges_start == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the graph.\n");
+        exit(EXIT_FAILURE);
+    }
+    int edge_count = 0;
+    convert_to_device_arrays(nodes, nodeCount, edges_start, &edge_destinations, &edge_weights, &edge_count);
+
+    // Snap the points to their closest nodes, the graph is already downloaded, so no point needs its own request
+    int source_indices[source_count];
+    int target_indices[target_count];
+    snapPoints(nodes, nodeCount, edge_count, edges_start, source_points, source_count, source_indices);
+    snapPoints(nodes, nodeCount, edge_count, edges_start, target_points, target_count, target_indices);
+    if (target_points != source_points) free(target_points);
+    free(source_points);
+
+    // end the graph time and prints its result
+    const double graph_time = wallTimeMs() - graph_time_start;
+    printf("\t\"graphTime\": %.f,\n", graph_time);
+    printf("\t\"threads\": %d,\n", thread_count);
+    printSnappedNodes("sourceNodes", nodes, source_indices, source_count);
+    printSnappedNodes("targetNodes", nodes, target_indices, target_count);
+
+    // Calculate the distances, one search per source
+    const double routing_time_start = wallTimeMs();  // Start the routing time
+    DistanceMatrix matrix;
+    computeDistanceMatrix(
+        &matrix,
+        nodeCount,
+        edge_count,
+        edges_start,
+        edge_destinations,
+        edge_weights,
+        source_indices,
+        source_count,
+        target_indices,
+        target_count);
+
+    // end the routing time and print its result
+    const double routing_time_ms = wallTimeMs() - routing_time_start;
+    printDistanceMatrix(&matrix);
+    printf("\t\"routingTime\": %.f,\n", routing_time_ms);
+
+    freeDistanceMatrix(&matrix);
+    freeNodes(nodes, nodeCount);
+    free(edges_start);
+    free(edge_destinations);
+    free(edge_weights);
+
+    // get the total time and print its result
+    const double total_time = wallTimeMs() - total_time_start;
+    printf("\t\"totalTime\": %.f,\n", total_time);
+
+    // End the Response JSON
+    printf("\t\"success\": true\n}\n");
+    return 0;
+}
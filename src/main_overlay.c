@@ -0,0 +1,233 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <float.h>  // For FLT_MAX
+#include <curl/curl.h>
+#include <time.h>
+
+#include "cli_utils.h" // Include parseArguments and extractOption functions
+#include "data_loader.h"  // Include OverpassAPI functions
+#include "graph_utils.h"  // Include Graph functions
+#include "overlay_utils.h"  // Include Partition Overlay functions
+#include "cache_utils.h"  // Include cache path and fingerprint functions
+#include "parallel_utils.h"  // Include convert_to_device_arrays function
+#include "task_utils.h"  // Include the task pool
+#include "output_utils.h"  // Include the route writer
+
+#define INF FLT_MAX
+
+#define DEFAULT_CELL_SIZE 512  // Largest number of nodes of a cell on level 1
+#define DEFAULT_LEVELS 3  // Number of levels of the overlay
+
+// Search on the partition overlay
+int partitionOverlayQuery(
+        Node nodes[],
+        const PartitionOverlay* overlay,
+        const int edge_count,
+        const int* edges_start,
+        const int* edge_destinations,
+        const float* edge_weights,
+        const int start_index,
+        const int dest_index) {
+
+    // define the path array, it receives the unpacked node sequence from start to destination
+    int *path = malloc(overlay->vertices * sizeof(int));
+    if (path == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the path.\n");
+        return 1;
+    }
+    int path_length = 0;
+
+    const float distance = queryPartitionOverlay(
+        overlay, edge_count, edges_start, edge_destinations, edge_weights, start_index, dest_index, path, &path_length);
+
+    // check if the target vertex has been reached
+    if (distance != INF) {
+        // Print the path from the destination back to the start like the other algorithms
+        RouteWriter route;
+        beginRoute(&route, "route", path_length);
+        for (int i = path_length - 1; i >= 0; i--) {
+            addRoutePoint(&route, nodes[path[i]].lat, nodes[path[i]].lon);
+        }
+        endRoute(&route);
+
+        printf("\t\"routeLength\": \"%.2fm\",\n", distance);
+        free(path);
+        return 0;
+    }
+    free(path);
+    fprintf(stderr, "Target cannot be reached from source\n");
+    return 1;
+}
+
+
+int main(int argc, char *argv[]) {
+    // get the timestamp of the execution start
+    const double total_time_start = wallTimeMs();
+
+    // Start the Response JSON
+    printf("{\n");
+
+    // define arrays for start and destination
+    float start[2];   // Array for starting coordinates
+    float dest[2];    // Array for destination coordinates
+    float* bbox;      // Pointer for bounding box coordinates
+    int bbox_size;     // Size of the bounding box
+
+    // Read the size of the cells, the number of levels and the thread count, the remaining arguments are the coordinates
+    const int cell_size = positiveOption(extractOption(&argc, argv, "cellsize"), "cell size", DEFAULT_CELL_SIZE);
+    const int level_count = positiveOption(extractOption(&argc, argv, "levels"), "level count", DEFAULT_LEVELS);
+    initializeTaskPool(threadCount(extractOption(&argc, argv, "threads")));
+    const int thread_count = taskThreadCount();
+
+    // Read the route format, "array" by default or "polyline" for an encoded polyline
+    selectRouteFormat(extractOption(&argc, argv, "route"));
+
+    // Parse the command-line arguments
+    if (parseArguments(argc, argv, start, dest, &bbox, &bbox_size) != 0) {
+        free(bbox);
+        return 1; // Exit if parsing failed
+    }
+
+    // initialise curl
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+
+    // get the nodes closest to the given address
+    const int64_t start_id = getClosestNode(start);
+    if (start_id == -1) {
+        fprintf(stderr, "Couldn't find closest Node to the start coordinates (%f, %f)\n", start[0], start[1]);
+        return 1;
+    }
+    printf("\t\"startNode\": %lld,\n", start_id);
+
+    const int64_t destination_id = getClosestNode(dest);
+    if (destination_id == -1) {
+        fprintf(stderr, "Couldn't find closest node to the destination coordinates (%f, %f)\n", dest[0], dest[1]);
+        return 1;
+    }
+    printf("\t\"destNode\": %lld,\n", destination_id);
+
+    // Initialise nodes Array and nodeCount
+    Node* nodes = NULL;
+    int nodeCount = 0;
+
+    // Initialise roads Array and roadCount
+    Road* roads = NULL;
+    int roadCount = 0;
+
+    // Data import
+    getRoadNodes(
+        bbox,
+        bbox_size,
+        &nodes,
+        &nodeCount,
+        &roads,
+        &roadCount);
+
+    // end curl
+    curl_global_cleanup();
+
+    // free the not needed data
+    free(bbox);
+
+    // Find the index of the start and dest node
+    int start_index = -1;
+    int dest_index = -1;
+    for (int i = 0; i < nodeCount; i++) {
+        if (nodes[i].id == start_id) start_index = i;
+        if (nodes[i].id == destination_id) dest_index = i;
+        if (start_index != -1 && dest_index != -1) break;
+    }
+
+    // If the source or target doesn't exist, exit the function
+    if (start_index == -1 || dest_index == -1) {
+        fprintf(stderr, "Invalid source or target ID\n");
+        free(nodes);
+        return -1;
+    }
+
+    // Define the Graph
+    const double graph_time_start = wallTimeMs();  // start the graph time measurement
+
+    // Fill the Graph using the Roads Data
+    createGraph(nodes, nodeCount, roads, roadCount);
+
+    // free the not needed data
+    free(roads);
+
+    // Create the flattened graph arrays
+    int *edges_start = malloc((nodeCount > 0 ? nodeCount : 1) * sizeof(int));  // starting index inside the edges array for each node
+    int *edge_destinations = NULL; // Array to hold the destination of each edge
+    float *edge_weights = NULL;    // Array to hold the weight of each edge
+    if (edges_start == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the graph.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Convert nodes and edges to flattened arrays
+    int edge_count = 0;
+    convert_to_device_arrays(nodes, nodeCount, edges_start, &edge_destinations, &edge_weights, &edge_count);
+
+    // end the graph time and prints its result
+    const double graph_time = wallTimeMs() - graph_time_start;
+    printf("\t\"graphTime\": %.f,\n", graph_time);
+    printf("\t\"threads\": %d,\n", thread_count);
+
+    // Build the partition overlay or load it if this graph was already preprocessed with the same cells
+    const double preprocessing_time_start = wallTimeMs();  // Start the preprocessing time
+    const uint64_t fingerprint = graphFingerprint(nodes, nodeCount, edges_start, edge_destinations, edge_weights, edge_count);
+    const int parameters[2] = {cell_size, level_count};
+    PartitionOverlay overlay;
+    char overlay_path[1024];
+    const int has_cache = getCachePath(
+        overlay_path, sizeof(overlay_path), "overlay", hashBytes(fingerprint, parameters, sizeof(parameters)), "bin") == 0;
+    if (!has_cache || loadPartitionOverlay(&overlay, overlay_path, nodeCount, fingerprint) != 0) {
+        buildPartitionOverlay(
+            &overlay, nodes, nodeCount, edge_count, edges_start, edge_destinations, edge_weights, cell_size, level_count);
+        if (has_cache) {
+            savePartitionOverlay(&overlay, overlay_path, fingerprint);
+        }
+    }
+
+    // end the preprocessing time and print its result
+    const double preprocessing_time = wallTimeMs() - preprocessing_time_start;
+    printf("\t\"preprocessingTime\": %.f,\n", preprocessing_time);
+
+    // print the number of cells and boundary nodes of every level
+    printf("\t\"levels\": [");
+    for (int l = 0; l < overlay.level_count; l++) {
+        printf("%s{\"cells\": %d, \"boundaryNodes\": %d}", l > 0 ? ", " : "",
+               overlay.levels[l].cell_count, overlay.levels[l].boundary_count);
+    }
+    printf("],\n");
+
+    // Run the overlay query with the source and target IDs
+    const double routing_time_start = wallTimeMs();  // Start the routing time
+
+    if (partitionOverlayQuery(
+            nodes, &overlay, edge_count, edges_start, edge_destinations, edge_weights, start_index, dest_index) != 0) {
+        freePartitionOverlay(&overlay);
+        freeNodes(nodes, nodeCount);
+        free(edges_start);
+        free(edge_destinations);
+        free(edge_weights);
+        return 1;
+    }
+
+    // end the routing time and print its result
+    const double routing_time_ms = wallTimeMs() - routing_time_start;
+    printf("\t\"routingTime\": %.f,\n", routing_time_ms);
+
+    freePartitionOverlay(&overlay);
+    freeNodes(nodes, nodeCount);
+    free(edges_start);
+    free(edge_destinations);
+    free(edge_weights);
+
+    // get the total time and print its result
+    const double total_time = wallTimeMs() - total_time_start;
+    printf("\t\"totalTime\": %.f,\n", total_time);
+
+    // End the Response JSON
+    printf("\t\"success\": true\n}\n");
+    return 0;
+}
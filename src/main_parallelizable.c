@@ -5,21 +5,79 @@
 #include <time.h>
 #include <CL/cl.h>
 
-#include "cli_utils.h" // Include parseArguments function
+#include "cli_utils.h" // Include parseArguments and wallTimeMs functions
 #include "data_loader.h"  // Include OverpassAPI functions
 #include "graph_utils.h"  // Include Graph functions
 #include "bucket_utils.h"  // Include Bucket functions
 #include "parallel_utils.h"  // Include convert_to_device_arrays function
+#include "delta_utils.h"  // Include selectDelta function
+#include "output_utils.h"  // Include the route writer
 
 #define INF FLT_MAX
 
-#define DELTA 40.0 // The Delta value for bucket ranges
+// Function to relax either the light or the heavy edges of every node in bucket_nodes, one iteration per OpenCL work item.
+// Every node that gets a shorter distance is marked with its new bucket inside nodes_2_bucket.
+static void processBucketNodes(
+        float* dist,
+        int* prev,
+        const int* edges_start,
+        const int* light_end,
+        const int* edge_destinations,
+        const float* edge_weights,
+        const int* bucket_nodes,
+        const int bucket_size,
+        int* nodes_2_bucket,
+        const float delta,
+        const int vertices,
+        const int edge_count,
+        const int heavy) {
+
+    for (int i = 0; i < bucket_size; i++) {
+        const int node = bucket_nodes[i];
+
+        // light edges range from the start of the node edges to light_end, heavy edges from there to the next node
+        const int edge_begin = heavy ? light_end[node] : edges_start[node];
+        const int edge_end = heavy ? ((node == vertices - 1) ? edge_count : edges_start[node + 1]) : light_end[node];
+
+        for (int edge = edge_begin; edge < edge_end; edge++) {
+            // calculate the new distance
+            const float new_dist = dist[node] + edge_weights[edge];
+
+            // check if the new distance is sorter that the previous one
+            if (dist[edge_destinations[edge]] > new_dist) {
+                // update the dest and prev of the next node
+                dist[edge_destinations[edge]] = new_dist;
+                prev[edge_destinations[edge]] = node;
+
+                // set the bucket of the next node, light edges can lead back into the current bucket
+                nodes_2_bucket[edge_destinations[edge]] = (int)(new_dist / delta);
+            }
+        }
+    }
+}
+
+// Function to move the marked nodes into their buckets and reset the marks
+static void collectBucketNodes(
+        BucketsArray* bucketsArray,
+        int* nodes_2_bucket,
+        const int vertices) {
+
+    for (int node_index = 0; node_index < vertices; node_index++) {
+        if (nodes_2_bucket[node_index] != -1) {
+            addNodeToBucket(bucketsArray, nodes_2_bucket[node_index], node_index);
+            nodes_2_bucket[node_index] = -1;  // Reset the value
+        }
+    }
+}
 
 int parallelizableDeltaStepping(
         const int vertices,
         const int edge_count,
         Node nodes[],
         const int* edges_start,
+        const int* light_end,
+        const float delta,
+        const float max_weight,
         const int* edge_destinations,
         const float* edge_weights,
         const int start_index,
@@ -35,79 +93,64 @@ int parallelizableDeltaStepping(
     // nodes_2_buckets[i] contains the bucket index where the node i belongs to
     int nodes_2_bucket[vertices];
 
+    // settled[i] is set once node i was taken out of its final bucket
+    char settled[vertices];
+
+    // the nodes of the current phase and the nodes settled in the current bucket
+    int phase_nodes[vertices];
+    int settled_nodes[vertices];
+
     // Initialize all distances as INFINITE, previous as -1 and nodes_2_buckets as -1
     for (int i = 0; i < vertices; i++) {
         dist[i] = INF;  // Infinite distance to node
         prev[i] = -1; // Undefined previous node
         nodes_2_bucket[i] = -1;  // no bucket where the node belongs to
+        settled[i] = 0;
     }
 
     // Distance of source vertex from itself is always 0
     dist[start_index] = 0;
 
-    // Create the buckets array
+    // Create the cyclic buckets, no edge reaches further than max_weight / delta buckets ahead
     BucketsArray bucketsArray;
-    initializeBuckets(&bucketsArray);
+    initializeBuckets(&bucketsArray, vertices, max_weight, delta);
 
     // Add the start node to the first bucket
     addNodeToBucket(&bucketsArray, 0, start_index);
 
     // run a loop over every bucket
     int bucket_id = 0;
-    while (bucket_id < bucketsArray.numBuckets) {
-        // set work size
-        size_t globalWorkSize[1] = {bucketsArray.bucketSizes[bucket_id]};
-
-        // check if there is stuff to do
-        if (globalWorkSize[0] == 0) {
-            bucket_id++;
-            continue;
+    while (bucket_id != -1) {
+        // Stop once the destination is settled, every node left has a distance of at least bucket_id * delta
+        if (dist[dest_index] <= bucket_id * delta) {
+            break;
         }
 
-        for (int i = 0; i < bucketsArray.bucketSizes[bucket_id]; i++) {
-            const int node = bucketsArray.buckets[bucket_id][i];
-
-            // Check if node is the last index to avoid out-of-bounds access
-            // Check if the nodes has next nodes
-            if ((node < vertices - 1 && edges_start[node] != edges_start[node + 1]) ||
-                (node == vertices - 1 && edges_start[node] != edge_count)) {
-
-                int edge_end = (node == vertices - 1) ? edge_count : edges_start[node + 1];
-
-                for (int edge = edges_start[node]; edge < edge_end; edge++) {
-                    // calculate the new distance
-                    const float new_dist = dist[node] + edge_weights[edge];
-
-                    // check if the new distance is sorter that the previous one
-                    if (dist[edge_destinations[edge]] > new_dist) {
-                        // update the dest and prev of the next node
-                        dist[edge_destinations[edge]] = new_dist;
-                        prev[edge_destinations[edge]] = node;
-
-                        // calculate the bucket of the next node
-                        int next_bucket = (int)(new_dist / DELTA) + 1;
-
-                        // check if the bucket is one that isn't done yet
-                        if (next_bucket <= bucket_id) {
-                            // if not set the bucket tto the next one coming
-                            next_bucket = bucket_id + 1;
-                        }
-
-                        // set the bucket of the next node
-                        nodes_2_bucket[edge_destinations[edge]] = next_bucket;
-                    }
+        // Relax the light edges in phases until no node is added to the current bucket anymore
+        int settled_count = 0;
+        int phase_size;
+        while ((phase_size = takeBucketNodes(&bucketsArray, phase_nodes)) > 0) {
+            // nodes can be relaxed in several phases, but they are settled only once
+            for (int i = 0; i < phase_size; i++) {
+                if (!settled[phase_nodes[i]]) {
+                    settled[phase_nodes[i]] = 1;
+                    settled_nodes[settled_count++] = phase_nodes[i];
                 }
             }
-        }
 
-        // Add the nodes to their buckets
-        for (int node_index = 0; node_index < vertices; node_index++) {
-            if (nodes_2_bucket[node_index] != -1) {
-                addNodeToBucket(&bucketsArray, nodes_2_bucket[node_index], node_index);
-                nodes_2_bucket[node_index] = -1;  // Reset the value
-            }
+            processBucketNodes(
+                dist, prev, edges_start, light_end, edge_destinations, edge_weights,
+                phase_nodes, phase_size, nodes_2_bucket, delta, vertices, edge_count, 0);
+            collectBucketNodes(&bucketsArray, nodes_2_bucket, vertices);
         }
-        bucket_id++;
+
+        // Relax the heavy edges of the settled nodes once, they only lead to later buckets
+        processBucketNodes(
+            dist, prev, edges_start, light_end, edge_destinations, edge_weights,
+            settled_nodes, settled_count, nodes_2_bucket, delta, vertices, edge_count, 1);
+        collectBucketNodes(&bucketsArray, nodes_2_bucket, vertices);
+
+        bucket_id = nextBucket(&bucketsArray);
     }
 
     // Free each bucket's allocated memory
@@ -118,15 +161,13 @@ int parallelizableDeltaStepping(
         // Retrieve and print the path
         int current = dest_index;
 
-        printf("\t\"route\": [");
+        RouteWriter route;
+        beginRoute(&route, "route", 0);
         while (current != -1) {
-            printf("[%f, %f]", nodes[current].lat, nodes[current].lon);
+            addRoutePoint(&route, nodes[current].lat, nodes[current].lon);
             current = prev[current]; // Move to the previous node
-            if (current != -1) {
-                printf(", ");
-            }
         }
-        printf("],\n");
+        endRoute(&route);
 
         printf("\t\"routeLength\": \"%.2fm\",\n", dist[dest_index]);
         return 0;
@@ -136,9 +177,9 @@ int parallelizableDeltaStepping(
 }
 
 
-int main(const int argc, char *argv[]) {
+int main(int argc, char *argv[]) {
     // get the timestamp of the execution start
-    const clock_t total_time_start = clock();
+    const double total_time_start = wallTimeMs();
 
     // Start the Response JSON
     printf("{\n");
@@ -149,6 +190,12 @@ int main(const int argc, char *argv[]) {
     float* bbox;      // Pointer for bounding box coordinates
     int bbox_size;     // Size of the bounding box
 
+    // Read the optional bucket width, the remaining arguments are the coordinates
+    const char* delta_option = extractOption(&argc, argv, "delta");
+
+    // Read the route format, "array" by default or "polyline" for an encoded polyline
+    selectRouteFormat(extractOption(&argc, argv, "route"));
+
     // Parse the command-line arguments
     if (parseArguments(argc, argv, start, dest, &bbox, &bbox_size) != 0) {
         free(bbox);
@@ -213,7 +260,7 @@ int main(const int argc, char *argv[]) {
     }
 
     // Define the Graph
-    const clock_t graph_time_start = clock();  // start the graph time measurement
+    const double graph_time_start = wallTimeMs();  // start the graph time measurement
 
     // Fill the Graph using the Roads Data
     createGraph(nodes, nodeCount, roads, roadCount);
@@ -230,18 +277,34 @@ int main(const int argc, char *argv[]) {
     int edge_count = 0;
     convert_to_device_arrays(nodes, nodeCount, edges_start, &edge_destinations, &edge_weights, &edge_count);
 
+    // Determine the bucket width from the graph unless the request sets it,
+    // every phase scans the bucket marks of all nodes, so it costs about as much as relaxing nodeCount edges
+    GraphStats stats;
+    computeGraphStats(&stats, nodeCount, edge_count, edge_weights);
+    const float delta = selectDelta(
+        delta_option, &stats, nodeCount, edge_count, edges_start, edge_destinations, edge_weights, start_index,
+        (float) nodeCount);
+
+    // Split the edges of every node into light and heavy edges
+    int light_end[nodeCount];  // Array that holds the index of the first heavy edge for each node
+    partition_light_heavy_edges(nodeCount, edge_count, edges_start, edge_destinations, edge_weights, delta, light_end);
+
     // end the graph time and prints its result
-    const clock_t graph_time_end = clock();
-    const double graph_time  = ((double) (graph_time_end - graph_time_start)) * 1000 / CLOCKS_PER_SEC;
+    const double graph_time_end = wallTimeMs();
+    const double graph_time  = graph_time_end - graph_time_start;
     printf("\t\"graphTime\": %.f,\n", graph_time);
+    printf("\t\"delta\": %.2f,\n", delta);
 
     // Run Dijkstra's algorithm with the source and target IDs
-    const clock_t routing_time_start = clock();  // Start the routing time
+    const double routing_time_start = wallTimeMs();  // Start the routing time
     if (parallelizableDeltaStepping(
         nodeCount,
         edge_count,
         nodes,
         edges_start,
+        light_end,
+        delta,
+        stats.max_weight,
         edge_destinations,
         edge_weights,
         start_index,
@@ -255,14 +318,14 @@ int main(const int argc, char *argv[]) {
     free(edge_weights);
 
     // end the routing time and print its result
-    const clock_t routing_time_end = clock();
-    const double routing_time_ms = (double)(routing_time_end - routing_time_start) * 1000 / CLOCKS_PER_SEC;
+    const double routing_time_end = wallTimeMs();
+    const double routing_time_ms = routing_time_end - routing_time_start;
 
     printf("\t\"routingTime\": %.f,\n", routing_time_ms);
 
     // get the total time and print its result
-    const clock_t total_time_end = clock();
-    const double total_time = ((double) (total_time_end - total_time_start)) * 1000 / CLOCKS_PER_SEC;
+    const double total_time_end = wallTimeMs();
+    const double total_time = total_time_end - total_time_start;
     printf("\t\"totalTime\": %.f,\n", total_time);
 
     // End the Response JSON
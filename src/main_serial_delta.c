@@ -1,75 +1,149 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <float.h>  // For FLT_MAX
 #include <curl/curl.h>
 #include <time.h>
 
-#include "cli_utils.h" // Include parseArguments function
+#include "cli_utils.h" // Include parseArguments and wallTimeMs functions
 #include "data_loader.h"  // Include OverpassAPI functions
 #include "graph_utils.h"  // Include Graph functions
 #include "bucket_utils.h"  // Include Bucket functions
+#include "parallel_utils.h"  // Include convert_to_device_arrays function
+#include "delta_utils.h"  // Include selectDelta function
+#include "simd_utils.h"  // Include selectRelaxKernel function
+#include "output_utils.h"  // Include the route writer
 
 #define INF FLT_MAX
 
-#define DELTA 40.0 // The Delta value for bucket ranges, this can be tuned for optimal performance
+// Function to relax a single edge and move its destination into the bucket of its new distance
+static void relaxEdge(
+        float* dist,
+        int* prev,
+        BucketsArray* bucketsArray,
+        const int node,
+        const int destination,
+        const float weight,
+        const float delta) {
+
+    const float new_distance = dist[node] + weight;
+    // Check if the new distance is shorter
+    if (new_distance < dist[destination]) {
+        // Update distance and previous node
+        dist[destination] = new_distance;
+        prev[destination] = node;
+
+        // Add the destination node to the bucket of its new distance
+        addNodeToBucket(bucketsArray, (int)(new_distance / delta), destination);
+    }
+}
+
+// Function to relax the edges edge_begin to edge_end - 1 of a node, RELAX_WIDTH at a time.
+// The kernel finds the edges that are shorter without a branch per edge, only those are relaxed one by one.
+static void relaxEdges(
+        float* dist,
+        int* prev,
+        BucketsArray* bucketsArray,
+        const RelaxKernel kernel,
+        const int node,
+        const int edge_begin,
+        const int edge_end,
+        const int* edge_destinations,
+        const float* edge_weights,
+        const float delta) {
+
+    for (int first = edge_begin; first < edge_end; first += RELAX_WIDTH) {
+        const int count = (edge_end - first < RELAX_WIDTH) ? edge_end - first : RELAX_WIDTH;
+        uint32_t mask = kernel(dist, DISTANCE_FLOATS, edge_destinations + first, edge_weights + first, count, dist[node]);
+        while (mask != 0) {
+            const int edge = first + __builtin_ctz(mask);
+            mask &= mask - 1;
+            relaxEdge(dist, prev, bucketsArray, node, edge_destinations[edge], edge_weights[edge], delta);
+        }
+    }
+}
 
 // Delta-Stepping algorithm
 int deltaStepping(
         const int vertices,
+        const int edge_count,
         Node nodes[],
+        const int* edges_start,
+        const int* edge_destinations,
+        const float* edge_weights,
+        const int* light_end,
+        const float delta,
+        const float max_weight,
+        const RelaxKernel kernel,
         const int start_index,
         const int dest_index) {
 
     float dist[vertices];     // Output array. dist[i] holds the shortest distance from src to i
     int prev[vertices];     // prev[i] stores the previous vertex in the path
 
+    // the nodes taken out of the current bucket
+    int bucket_nodes[vertices];
+
+    // nodes whose light edges were relaxed in the current bucket, their heavy edges follow once the bucket is empty
+    int settled_nodes[vertices];
+    int settled_count;
+
+    // settled[i] is set once node i was taken out of its final bucket
+    char settled[vertices];
+
     // Initialize all distances as INFINITE and previous as -1
     for (int i = 0; i < vertices; i++) {
         dist[i] = INF;  // Infinite distance to node
         prev[i] = -1; // Undefined previous vertex
+        settled[i] = 0;  // Not settled yet
     }
 
     // Distance of source vertex from itself is always 0
     dist[start_index] = 0;
 
-    // Define the buckets array with dynamic resizing capability
+    // Define the cyclic buckets, no edge reaches further than max_weight / delta buckets ahead
     BucketsArray bucketsArray;
-    initializeBuckets(&bucketsArray);
+    initializeBuckets(&bucketsArray, vertices, max_weight, delta);
 
     // add the start node to the first bucket
     addNodeToBucket(&bucketsArray, 0, start_index);
 
     // go through each Bucket
     int bucket_id = 0;
-    while (bucket_id < bucketsArray.numBuckets) {
-        // Go through each node inside the bucket
-        for (int i = 0; i < bucketsArray.bucketSizes[bucket_id]; i++) {
-            const int node = bucketsArray.buckets[bucket_id][i];
-
-            // Get the edge of the node
-            const Edge* edge = nodes[node].head;
-
-            // Process edges
-            while (edge) {
-                const float new_distance = dist[node] + edge->weight;
-                // Check if the new distance is shorter
-                if (new_distance < dist[edge->destination]) {
-                    // Update distance and previous node
-                    dist[edge->destination] = new_distance;
-                    prev[edge->destination] = node;
-
-                    // Determine the bucket for the destination node
-                    const int new_bucket_index = (int)(new_distance / DELTA);
-
-                    // Add the destination node to the correct bucket
-                    addNodeToBucket(&bucketsArray, new_bucket_index, edge->destination);
+    while (bucket_id != -1) {
+        // Stop once the destination is settled, every node left has a distance of at least bucket_id * delta
+        if (dist[dest_index] <= bucket_id * delta) {
+            break;
+        }
+
+        // Relax the light edges of the nodes inside the bucket until it is empty,
+        // nodes that get a shorter distance inside this bucket are added to it again
+        settled_count = 0;
+        int bucket_size;
+        while ((bucket_size = takeBucketNodes(&bucketsArray, bucket_nodes)) > 0) {
+            for (int i = 0; i < bucket_size; i++) {
+                const int node = bucket_nodes[i];
+
+                // Remember the node for the heavy edges the first time it is relaxed
+                if (!settled[node]) {
+                    settled[node] = 1;
+                    settled_nodes[settled_count++] = node;
                 }
-                // Move to the next edge
-                edge = edge->next;
+
+                relaxEdges(dist, prev, &bucketsArray, kernel, node, edges_start[node], light_end[node],
+                           edge_destinations, edge_weights, delta);
             }
         }
 
-        bucket_id++;
+        // Relax the heavy edges of every node settled in this bucket once, they only reach later buckets
+        for (int i = 0; i < settled_count; i++) {
+            const int node = settled_nodes[i];
+            const int edge_end = (node == vertices - 1) ? edge_count : edges_start[node + 1];
+            relaxEdges(dist, prev, &bucketsArray, kernel, node, light_end[node], edge_end,
+                       edge_destinations, edge_weights, delta);
+        }
+
+        bucket_id = nextBucket(&bucketsArray);
     }
 
     // Free each bucket's allocated memory
@@ -80,15 +154,13 @@ int deltaStepping(
         // Retrieve and print the path
         int current = dest_index;
 
-        printf("\t\"route\": [");
+        RouteWriter route;
+        beginRoute(&route, "route", 0);
         while (current != -1) {
-            printf("[%f, %f]", nodes[current].lat, nodes[current].lon);
+            addRoutePoint(&route, nodes[current].lat, nodes[current].lon);
             current = prev[current]; // Move to the previous node
-            if (current != -1) {
-                printf(", ");
-            }
         }
-        printf("],\n");
+        endRoute(&route);
 
         printf("\t\"routeLength\": \"%.2fm\",\n", dist[dest_index]);
         return 0;
@@ -97,10 +169,132 @@ int deltaStepping(
     return 1;
 }
 
+// Function to relax the fixed-point edges edge_begin to edge_end - 1 of a node
+static void relaxFixedEdges(
+        uint32_t* dist,
+        int* prev,
+        BucketsArray* bucketsArray,
+        const int node,
+        const int edge_begin,
+        const int edge_end,
+        const int* edge_destinations,
+        const uint32_t* fixed_weights,
+        const uint32_t delta) {
+
+    for (int edge = edge_begin; edge < edge_end; edge++) {
+        // the sum can't wrap around, a distance beyond FIXED_INF never improves a node
+        const uint64_t new_distance = (uint64_t) dist[node] + fixed_weights[edge];
+        const int destination = edge_destinations[edge];
+        if (new_distance < dist[destination]) {
+            dist[destination] = (uint32_t) new_distance;
+            prev[destination] = node;
+            addNodeToBucket(bucketsArray, (int) (new_distance / delta), destination);
+        }
+    }
+}
+
+// Delta-Stepping algorithm on fixed-point distances in millimetres. The sums are exact and the bucket of a node is an
+// integer division, so it finds the same distances as the fixed-point kernel of the parallel version.
+int fixedDeltaStepping(
+        const int vertices,
+        const int edge_count,
+        Node nodes[],
+        const int* edges_start,
+        const int* edge_destinations,
+        const uint32_t* fixed_weights,
+        const int* light_end,
+        const uint32_t delta,
+        const uint32_t max_weight,
+        const int start_index,
+        const int dest_index) {
+
+    uint32_t dist[vertices];     // Output array. dist[i] holds the shortest distance from src to i in millimetres
+    int prev[vertices];     // prev[i] stores the previous vertex in the path
+
+    // the nodes taken out of the current bucket and the nodes whose light edges were relaxed in it
+    int bucket_nodes[vertices];
+    int settled_nodes[vertices];
+    int settled_count;
+
+    // settled[i] is set once node i was taken out of its final bucket
+    char settled[vertices];
 
-int main(const int argc, char *argv[]) {
+    // Initialize all distances as INFINITE and previous as -1
+    for (int i = 0; i < vertices; i++) {
+        dist[i] = FIXED_INF;
+        prev[i] = -1;
+        settled[i] = 0;
+    }
+
+    // Distance of source vertex from itself is always 0
+    dist[start_index] = 0;
+
+    // Define the cyclic buckets, no edge reaches further than max_weight / delta buckets ahead
+    BucketsArray bucketsArray;
+    initializeBuckets(&bucketsArray, vertices, (float) max_weight, (float) delta);
+    addNodeToBucket(&bucketsArray, 0, start_index);
+
+    // go through each Bucket
+    int bucket_id = 0;
+    while (bucket_id != -1) {
+        // Stop once the destination is settled, every node left has a distance of at least bucket_id * delta
+        if (dist[dest_index] <= (uint64_t) bucket_id * delta) {
+            break;
+        }
+
+        // Relax the light edges of the nodes inside the bucket until it is empty
+        settled_count = 0;
+        int bucket_size;
+        while ((bucket_size = takeBucketNodes(&bucketsArray, bucket_nodes)) > 0) {
+            for (int i = 0; i < bucket_size; i++) {
+                const int node = bucket_nodes[i];
+                if (!settled[node]) {
+                    settled[node] = 1;
+                    settled_nodes[settled_count++] = node;
+                }
+                relaxFixedEdges(dist, prev, &bucketsArray, node, edges_start[node], light_end[node],
+                                edge_destinations, fixed_weights, delta);
+            }
+        }
+
+        // Relax the heavy edges of every node settled in this bucket once, they only reach later buckets
+        for (int i = 0; i < settled_count; i++) {
+            const int node = settled_nodes[i];
+            const int edge_end = (node == vertices - 1) ? edge_count : edges_start[node + 1];
+            relaxFixedEdges(dist, prev, &bucketsArray, node, light_end[node], edge_end,
+                            edge_destinations, fixed_weights, delta);
+        }
+
+        bucket_id = nextBucket(&bucketsArray);
+    }
+
+    // Free each bucket's allocated memory
+    freeBuckets(&bucketsArray);
+
+    // After the loop, check if the target vertex has been reached
+    if (dist[dest_index] != FIXED_INF) {
+        // Retrieve and print the path
+        int current = dest_index;
+
+        RouteWriter route;
+        beginRoute(&route, "route", 0);
+        while (current != -1) {
+            addRoutePoint(&route, nodes[current].lat, nodes[current].lon);
+            current = prev[current]; // Move to the previous node
+        }
+        endRoute(&route);
+
+        printf("\t\"routeLength\": \"%.2fm\",\n", (double) dist[dest_index] / FIXED_SCALE);
+        return 0;
+    }
+    fprintf(stderr, "Target cannot be reached from source\n");
+    return 1;
+}
+
+
+int main(int argc, char *argv[]) {
     // get the timestamp of the execution start
-    const clock_t total_time_start = clock();
+    const double total_time_start = wallTimeMs();
 
     // Start the Response JSON
     printf("{\n");
@@ -111,6 +305,23 @@ int main(const int argc, char *argv[]) {
     float* bbox;      // Pointer for bounding box coordinates
     int bbox_size;     // Size of the bounding box
 
+    // Read the optional bucket width and relaxation kernel, the remaining arguments are the coordinates
+    const char* delta_option = extractOption(&argc, argv, "delta");
+    const char* kernel_name;
+    const RelaxKernel kernel = selectRelaxKernel(extractOption(&argc, argv, "simd"), &kernel_name);
+
+    // Read the distance mode, "float" by default or "fixed" for integer distances in millimetres
+    const char* weights_option = extractOption(&argc, argv, "weights");
+    int fixed = 0;
+    if (weights_option != NULL && strcmp(weights_option, "fixed") == 0) {
+        fixed = 1;
+    } else if (weights_option != NULL && strcmp(weights_option, "float") != 0) {
+        fprintf(stderr, "Ignoring unknown weights '%s', using float distances instead\n", weights_option);
+    }
+
+    // Read the route format, "array" by default or "polyline" for an encoded polyline
+    selectRouteFormat(extractOption(&argc, argv, "route"));
+
     // Parse the command-line arguments
     if (parseArguments(argc, argv, start, dest, &bbox, &bbox_size) != 0) {
         free(bbox);
@@ -175,7 +386,7 @@ int main(const int argc, char *argv[]) {
     }
 
     // Define the Graph
-    const clock_t graph_time_start = clock();  // start the graph time measurement
+    const double graph_time_start = wallTimeMs();  // start the graph time measurement
 
     // Fill the Graph using the Roads Data
     createGraph(nodes, nodeCount, roads, roadCount);
@@ -183,30 +394,92 @@ int main(const int argc, char *argv[]) {
     // free the not needed data
     free(roads);
 
+    // Flatten the graph into arrays, the edges of every node are split into light and heavy edges
+    int edges_start[nodeCount];  // Array that holds the starting index inside the edges array for each node
+    int light_end[nodeCount];  // Array that holds the index of the first heavy edge for each node
+    int *edge_destinations = NULL; // Array to hold the destination of each edge
+    float *edge_weights = NULL;    // Array to hold the weight of each edge
+
+    int edge_count = 0;
+    convert_to_device_arrays(nodes, nodeCount, edges_start, &edge_destinations, &edge_weights, &edge_count);
+
+    // Determine the bucket width from the graph unless the request sets it, a phase is as cheap as a relaxation here
+    GraphStats stats;
+    computeGraphStats(&stats, nodeCount, edge_count, edge_weights);
+    const float delta = selectDelta(
+        delta_option, &stats, nodeCount, edge_count, edges_start, edge_destinations, edge_weights, start_index, 1.0f);
+    partition_light_heavy_edges(nodeCount, edge_count, edges_start, edge_destinations, edge_weights, delta, light_end);
+
+    // Round the weights to millimetres for the fixed-point distances, after the partition so the order still holds
+    uint32_t *fixed_weights = NULL;
+    if (fixed) {
+        fixed_weights = malloc((edge_count > 0 ? edge_count : 1) * sizeof(uint32_t));
+        if (fixed_weights == NULL) {
+            fprintf(stderr, "Error: Unable to allocate memory for the fixed-point weights.\n");
+            exit(EXIT_FAILURE);
+        }
+        convert_to_fixed_weights(edge_count, edge_weights, fixed_weights);
+    }
+
     // end the graph time and prints its result
-    const clock_t graph_time_end = clock();
-    const double graph_time  = ((double) (graph_time_end - graph_time_start)) * 1000 / CLOCKS_PER_SEC;
+    const double graph_time_end = wallTimeMs();
+    const double graph_time  = graph_time_end - graph_time_start;
     printf("\t\"graphTime\": %.f,\n", graph_time);
+    printf("\t\"delta\": %.2f,\n", delta);
+    printf("\t\"simd\": \"%s\",\n", fixed ? "scalar" : kernel_name);
+    printf("\t\"weights\": \"%s\",\n", fixed ? "fixed" : "float");
 
     // Run Delta stepping algorithm with the source and target IDs
-    const clock_t routing_time_start = clock();  // Start the routing time
-
-    if (deltaStepping(nodeCount, nodes, start_index, dest_index) != 0) {
+    const double routing_time_start = wallTimeMs();  // Start the routing time
+
+    int result;
+    if (fixed) {
+        result = fixedDeltaStepping(
+            nodeCount,
+            edge_count,
+            nodes,
+            edges_start,
+            edge_destinations,
+            fixed_weights,
+            light_end,
+            to_fixed_distance(delta),
+            to_fixed_distance(stats.max_weight),
+            start_index,
+            dest_index);
+    } else {
+        result = deltaStepping(
+            nodeCount,
+            edge_count,
+            nodes,
+            edges_start,
+            edge_destinations,
+            edge_weights,
+            light_end,
+            delta,
+            stats.max_weight,
+            kernel,
+            start_index,
+            dest_index);
+    }
+    free(fixed_weights);
+    if (result != 0) {
         freeNodes(nodes, nodeCount);
         return 1;
     }
 
     freeNodes(nodes, nodeCount);
+    free(edge_destinations);
+    free(edge_weights);
 
     // end the routing time and print its result
-    const clock_t routing_time_end = clock();
-    const double routing_time_ms = (double)(routing_time_end - routing_time_start) * 1000 / CLOCKS_PER_SEC;
+    const double routing_time_end = wallTimeMs();
+    const double routing_time_ms = routing_time_end - routing_time_start;
 
     printf("\t\"routingTime\": %.f,\n", routing_time_ms);
 
     // get the total time and print its result
-    const clock_t total_time_end = clock();
-    const double total_time = ((double) (total_time_end - total_time_start)) * 1000 / CLOCKS_PER_SEC;
+    const double total_time_end = wallTimeMs();
+    const double total_time = total_time_end - total_time_start;
     printf("\t\"totalTime\": %.f,\n", total_time);
 
     // End the Response JSON
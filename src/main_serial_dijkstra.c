@@ -1,13 +1,17 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <stdbool.h> // For boolean data types
 #include <float.h>  // For FLT_MAX
 #include <curl/curl.h>
 #include <time.h>
 
-#include "cli_utils.h" // Include parseArguments function
+#include "cli_utils.h" // Include parseArguments and wallTimeMs functions
 #include "data_loader.h"  // Include OverpassAPI functions
 #include "graph_utils.h"  // Include Graph functions
+#include "output_utils.h"  // Include the route writer
+#include "heap_utils.h"  // Include RadixHeap functions
+#include "parallel_utils.h"  // Include to_fixed_distance function
 
 #define INF FLT_MAX
 
@@ -87,15 +91,13 @@ int dijkstra(
         // Retrieve and print the path
         int current = dest_index;
 
-        printf("\t\"route\": [");
+        RouteWriter route;
+        beginRoute(&route, "route", 0);
         while (current != -1) {
-            printf("[%f, %f]", nodes[current].lat, nodes[current].lon);
+            addRoutePoint(&route, nodes[current].lat, nodes[current].lon);
             current = prev[current]; // Move to the previous node
-            if (current != -1) {
-                printf(", ");
-            }
         }
-        printf("],\n");
+        endRoute(&route);
 
         printf("\t\"routeLength\": \"%.2fm\",\n", dist[dest_index]);
         return 0;
@@ -104,10 +106,88 @@ int dijkstra(
     return 1;
 }
 
+// Dijkstra's algorithm on fixed-point distances in millimetres. The distances are integers that only grow, so a
+// radix heap replaces the search for the closest vertex. Every weight is rounded like convert_to_fixed_weights does,
+// so it finds the same distances as the fixed-point Delta-Stepping versions.
+int fixedDijkstra(
+        const int vertices,
+        Node nodes[],
+        const int start_index,
+        const int dest_index) {
+
+    uint32_t dist[vertices];     // Output array. dist[i] holds the shortest distance from src to i in millimetres
+    bool visited_map[vertices]; // visited_map[i] is true if vertex i is included in the shortest path tree
+    int prev[vertices];     // prev[i] stores the previous vertex in the path
+
+    // Initialize all distances as INFINITE, visited_map[] as false and previous as -1
+    for (int i = 0; i < vertices; i++) {
+        dist[i] = FIXED_INF;
+        visited_map[i] = false;
+        prev[i] = -1; // Undefined previous vertex
+    }
+
+    // Distance of source vertex from itself is always 0
+    dist[start_index] = 0;
+
+    RadixHeap heap;
+    initializeRadixHeap(&heap);
+    pushRadixHeap(&heap, start_index, 0);
+
+    // Take the closest vertex until the target is reached or no vertex is left
+    int u;
+    uint32_t key;
+    while (popRadixHeap(&heap, &u, &key)) {
+        // skip outdated entries of vertices that were pushed again with a shorter distance
+        if (visited_map[u] || key != dist[u]) {
+            continue;
+        }
+
+        // Mark the picked vertex as processed
+        visited_map[u] = true;
+
+        // Check if the target vertex has been reached
+        if (u == dest_index) {
+            break; // Stop the loop when the shortest path to the target is found
+        }
 
-int main(const int argc, char *argv[]) {
+        // Update dist value of the adjacent vertices of the picked vertex, the sum can't wrap around
+        for (Edge* edge = nodes[u].head; edge != NULL; edge = edge->next) {
+            const int v = edge->destination;
+            const uint64_t new_distance = (uint64_t) dist[u] + to_fixed_distance(edge->weight);
+            if (!visited_map[v] && new_distance < dist[v]) {
+                dist[v] = (uint32_t) new_distance;
+                prev[v] = u; // Update previous vertex
+                pushRadixHeap(&heap, v, dist[v]);
+            }
+        }
+    }
+
+    freeRadixHeap(&heap);
+
+    // After the loop, check if the target vertex has been reached
+    if (dist[dest_index] != FIXED_INF) {
+        // Retrieve and print the path
+        int current = dest_index;
+
+        RouteWriter route;
+        beginRoute(&route, "route", 0);
+        while (current != -1) {
+            addRoutePoint(&route, nodes[current].lat, nodes[current].lon);
+            current = prev[current]; // Move to the previous node
+        }
+        endRoute(&route);
+
+        printf("\t\"routeLength\": \"%.2fm\",\n", (double) dist[dest_index] / FIXED_SCALE);
+        return 0;
+    }
+    fprintf(stderr, "Target cannot be reached from source\n");
+    return 1;
+}
+
+
+int main(int argc, char *argv[]) {
     // get the timestamp of the execution start
-    const clock_t total_time_start = clock();
+    const double total_time_start = wallTimeMs();
 
     // Start the Response JSON
     printf("{\n");
@@ -118,6 +198,18 @@ int main(const int argc, char *argv[]) {
     float* bbox;      // Pointer for bounding box coordinates
     int bbox_size;     // Size of the bounding box
 
+    // Read the distance mode, "float" by default or "fixed" for integer distances in millimetres
+    const char* weights_option = extractOption(&argc, argv, "weights");
+    int fixed = 0;
+    if (weights_option != NULL && strcmp(weights_option, "fixed") == 0) {
+        fixed = 1;
+    } else if (weights_option != NULL && strcmp(weights_option, "float") != 0) {
+        fprintf(stderr, "Ignoring unknown weights '%s', using float distances instead\n", weights_option);
+    }
+
+    // Read the route format, "array" by default or "polyline" for an encoded polyline
+    selectRouteFormat(extractOption(&argc, argv, "route"));
+
     // Parse the command-line arguments
     if (parseArguments(argc, argv, start, dest, &bbox, &bbox_size) != 0) {
         free(bbox);
@@ -182,7 +274,7 @@ int main(const int argc, char *argv[]) {
     }
 
     // Define the Graph
-    const clock_t graph_time_start = clock();  // start the graph time measurement
+    const double graph_time_start = wallTimeMs();  // start the graph time measurement
 
     // Fill the Graph using the Roads Data
     createGraph(nodes, nodeCount, roads, roadCount);
@@ -191,14 +283,18 @@ int main(const int argc, char *argv[]) {
     free(roads);
 
     // end the graph time and prints its result
-    const clock_t graph_time_end = clock();
-    const double graph_time  = ((double) (graph_time_end - graph_time_start)) * 1000 / CLOCKS_PER_SEC;
+    const double graph_time_end = wallTimeMs();
+    const double graph_time  = graph_time_end - graph_time_start;
     printf("\t\"graphTime\": %.f,\n", graph_time);
+    printf("\t\"weights\": \"%s\",\n", fixed ? "fixed" : "float");
 
     // Run Dijkstra's algorithm with the source and target IDs
-    const clock_t routing_time_start = clock();  // Start the routing time
+    const double routing_time_start = wallTimeMs();  // Start the routing time
 
-    if (dijkstra(nodeCount, nodes, start_index, dest_index) != 0) {
+    const int result = fixed
+        ? fixedDijkstra(nodeCount, nodes, start_index, dest_index)
+        : dijkstra(nodeCount, nodes, start_index, dest_index);
+    if (result != 0) {
         freeNodes(nodes, nodeCount);
         return 1;
     }
@@ -206,14 +302,14 @@ int main(const int argc, char *argv[]) {
     freeNodes(nodes, nodeCount);
 
     // end the routing time and print its result
-    const clock_t routing_time_end = clock();
-    const double routing_time_ms = (double)(routing_time_end - routing_time_start) * 1000 / CLOCKS_PER_SEC;
+    const double routing_time_end = wallTimeMs();
+    const double routing_time_ms = routing_time_end - routing_time_start;
 
     printf("\t\"routingTime\": %.f,\n", routing_time_ms);
 
     // get the total time and print its result
-    const clock_t total_time_end = clock();
-    const double total_time = ((double) (total_time_end - total_time_start)) * 1000 / CLOCKS_PER_SEC;
+    const double total_time_end = wallTimeMs();
+    const double total_time = total_time_end - total_time_start;
     printf("\t\"totalTime\": %.f,\n", total_time);
 
     // End the Response JSON
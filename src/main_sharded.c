@@ -0,0 +1,225 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <float.h>  // For FLT_MAX
+#include <curl/curl.h>
+#include <time.h>
+
+#include "cli_utils.h" // Include parseArguments and extractOption functions
+#include "data_loader.h"  // Include OverpassAPI functions
+#include "graph_utils.h"  // Include Graph functions
+#include "shard_utils.h"  // Include the shard workers
+#include "parallel_utils.h"  // Include convert_to_device_arrays function
+#include "output_utils.h"  // Include the route writer
+
+#define INF FLT_MAX
+
+#define DEFAULT_SHARDS 4  // Number of shards, rounded up to a power of two
+
+// Search across the shards
+int shardedQuery(Node nodes[], const ShardCluster* cluster, const int start_index, const int dest_index) {
+    // define the path array, it receives the unpacked node sequence from start to destination
+    int *path = malloc(cluster->vertices * sizeof(int));
+    if (path == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the path.\n");
+        return 1;
+    }
+    int path_length = 0;
+
+    const float distance = queryShardCluster(cluster, start_index, dest_index, path, &path_length);
+
+    // check if the target vertex has been reached, a negative distance means a worker failed
+    if (distance >= 0 && distance != INF) {
+        // Print the path from the destination back to the start like the other algorithms
+        RouteWriter route;
+        beginRoute(&route, "route", path_length);
+        for (int i = path_length - 1; i >= 0; i--) {
+            addRoutePoint(&route, nodes[path[i]].lat, nodes[path[i]].lon);
+        }
+        endRoute(&route);
+
+        printf("\t\"routeLength\": \"%.2fm\",\n", distance);
+        free(path);
+        return 0;
+    }
+    free(path);
+    if (distance == INF) {
+        fprintf(stderr, "Target cannot be reached from source\n");
+    }
+    return 1;
+}
+
+
+int main(int argc, char *argv[]) {
+    // get the timestamp of the execution start
+    const double total_time_start = wallTimeMs();
+
+    // Start the Response JSON
+    printf("{\n");
+
+    // define arrays for start and destination
+    float start[2];   // Array for starting coordinates
+    float dest[2];    // Array for destination coordinates
+    float* bbox;      // Pointer for bounding box coordinates
+    int bbox_size;     // Size of the bounding box
+
+    // Read the number of shards, the remaining arguments are the coordinates
+    const int shard_count = positiveOption(extractOption(&argc, argv, "shards"), "shard count", DEFAULT_SHARDS);
+
+    // Read the route format, "array" by default or "polyline" for an encoded polyline
+    selectRouteFormat(extractOption(&argc, argv, "route"));
+
+    // Parse the command-line arguments
+    if (parseArguments(argc, argv, start, dest, &bbox, &bbox_size) != 0) {
+        free(bbox);
+        return 1; // Exit if parsing failed
+    }
+
+    // Start the workers before the graph is imported, so they don't inherit a copy of it
+    const double setup_time_start = wallTimeMs();  // Start the setup time
+    ShardCluster cluster;
+    if (startShardWorkers(&cluster, shard_count) != 0) {
+        free(bbox);
+        return 1;
+    }
+    double setup_time = wallTimeMs() - setup_time_start;
+
+    // initialise curl
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+
+    // get the nodes closest to the given address
+    const int64_t start_id = getClosestNode(start);
+    if (start_id == -1) {
+        fprintf(stderr, "Couldn't find closest Node to the start coordinates (%f, %f)\n", start[0], start[1]);
+        stopShardCluster(&cluster);
+        return 1;
+    }
+    printf("\t\"startNode\": %lld,\n", start_id);
+
+    const int64_t destination_id = getClosestNode(dest);
+    if (destination_id == -1) {
+        fprintf(stderr, "Couldn't find closest node to the destination coordinates (%f, %f)\n", dest[0], dest[1]);
+        stopShardCluster(&cluster);
+        return 1;
+    }
+    printf("\t\"destNode\": %lld,\n", destination_id);
+
+    // Initialise nodes Array and nodeCount
+    Node* nodes = NULL;
+    int nodeCount = 0;
+
+    // Initialise roads Array and roadCount
+    Road* roads = NULL;
+    int roadCount = 0;
+
+    // Data import
+    getRoadNodes(
+        bbox,
+        bbox_size,
+        &nodes,
+        &nodeCount,
+        &roads,
+        &roadCount);
+
+    // end curl
+    curl_global_cleanup();
+
+    // free the not needed data
+    free(bbox);
+
+    // Find the index of the start and dest node
+    int start_index = -1;
+    int dest_index = -1;
+    for (int i = 0; i < nodeCount; i++) {
+        if (nodes[i].id == start_id) start_index = i;
+        if (nodes[i].id == destination_id) dest_index = i;
+        if (start_index != -1 && dest_index != -1) break;
+    }
+
+    // If the source or target doesn't exist, exit the function
+    if (start_index == -1 || dest_index == -1) {
+        fprintf(stderr, "Invalid source or target ID\n");
+        stopShardCluster(&cluster);
+        free(nodes);
+        return -1;
+    }
+
+    // Define the Graph
+    const double graph_time_start = wallTimeMs();  // start the graph time measurement
+
+    // Fill the Graph using the Roads Data
+    createGraph(nodes, nodeCount, roads, roadCount);
+
+    // free the not needed data
+    free(roads);
+
+    // Create the flattened graph arrays
+    int *edges_start = malloc((nodeCount > 0 ? nodeCount : 1) * sizeof(int));  // starting index inside the edges array for each node
+    int *edge_destinations = NULL; // Array to hold the destination of each edge
+    float *edge_weights = NULL;    // Array to hold the weight of each edge
+    if (edges_start == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the graph.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Convert nodes and edges to flattened arrays
+    int edge_count = 0;
+    convert_to_device_arrays(nodes, nodeCount, edges_start, &edge_destinations, &edge_weights, &edge_count);
+
+    // the coordinator only needs the coordinates of the nodes from here on
+    freeEdges(nodes, nodeCount);
+
+    // end the graph time and prints its result
+    const double graph_time = wallTimeMs() - graph_time_start;
+    printf("\t\"graphTime\": %.f,\n", graph_time);
+
+    // Split the graph into shards and send them to the workers, the coordinator keeps only the edges between the shards
+    const double load_time_start = wallTimeMs();  // Continue the setup time
+    const int loaded = loadShardCluster(
+        &cluster, nodes, nodeCount, edge_count, edges_start, edge_destinations, edge_weights);
+    free(edges_start);
+    free(edge_destinations);
+    free(edge_weights);
+    if (loaded != 0) {
+        freeNodes(nodes, nodeCount);
+        return 1;
+    }
+
+    // end the setup time and print its result
+    setup_time += wallTimeMs() - load_time_start;
+    printf("\t\"setupTime\": %.f,\n", setup_time);
+
+    // print the number of nodes and boundary nodes of every shard
+    printf("\t\"shards\": [");
+    for (int k = 0; k < cluster.shard_count; k++) {
+        printf("%s{\"nodes\": %d, \"boundaryNodes\": %d}", k > 0 ? ", " : "",
+               cluster.shard_start[k + 1] - cluster.shard_start[k],
+               cluster.boundary_start[k + 1] - cluster.boundary_start[k]);
+    }
+    printf("],\n");
+
+    // Run the query across the shards with the source and target IDs
+    const double routing_time_start = wallTimeMs();  // Start the routing time
+
+    if (shardedQuery(nodes, &cluster, start_index, dest_index) != 0) {
+        stopShardCluster(&cluster);
+        freeNodes(nodes, nodeCount);
+        return 1;
+    }
+
+    // end the routing time before the workers are stopped
+    const double routing_time_ms = wallTimeMs() - routing_time_start;
+
+    stopShardCluster(&cluster);
+    freeNodes(nodes, nodeCount);
+
+    // print the routing time
+    printf("\t\"routingTime\": %.f,\n", routing_time_ms);
+
+    // get the total time and print its result
+    const double total_time = wallTimeMs() - total_time_start;
+    printf("\t\"totalTime\": %.f,\n", total_time);
+
+    // End the Response JSON
+    printf("\t\"success\": true\n}\n");
+    return 0;
+}
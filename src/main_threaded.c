@@ -0,0 +1,260 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <float.h>  // For FLT_MAX
+#include <curl/curl.h>
+#include <time.h>
+#include <stdatomic.h>
+
+#include "cli_utils.h" // Include parseArguments function
+#include "data_loader.h"  // Include OverpassAPI functions
+#include "graph_utils.h"  // Include Graph functions
+#include "parallel_utils.h"  // Include convert_to_device_arrays function
+#include "delta_utils.h"  // Include selectDelta function
+#include "task_utils.h"  // Include the task pool
+#include "simd_utils.h"  // Include selectRelaxKernel function
+#include "threaded_utils.h"  // Include threadedDeltaStepping function
+#include "output_utils.h"  // Include the route writer
+
+#define INF FLT_MAX
+
+// Multi-threaded Delta-Stepping from start_index that stops at dest_index and prints the route.
+// With fixed_weights set it runs on fixed-point distances in millimetres instead of the float weights.
+int threadedRoute(
+        const int vertices,
+        const int edge_count,
+        Node nodes[],
+        const int* edges_start,
+        const int* light_end,
+        const float delta,
+        const float max_weight,
+        const int* edge_destinations,
+        const float* edge_weights,
+        const uint32_t* fixed_weights,
+        const RelaxKernel kernel,
+        const int start_index,
+        const int dest_index) {
+
+    // define the label array. labels[i] holds the shortest distance from src to i and the previous node in the path
+    _Atomic uint64_t* labels = malloc(vertices * sizeof(_Atomic uint64_t));
+    if (labels == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the labels.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    if (fixed_weights != NULL) {
+        threadedFixedDeltaStepping(vertices, edge_count, edges_start, light_end, to_fixed_distance(delta),
+                                   to_fixed_distance(max_weight), edge_destinations, fixed_weights, start_index,
+                                   dest_index, labels);
+    } else {
+        threadedDeltaStepping(vertices, edge_count, edges_start, light_end, delta, max_weight, edge_destinations,
+                              edge_weights, kernel, start_index, dest_index, INF, labels);
+    }
+
+    // After the search, check if the target vertex has been reached
+    const uint64_t dest_label = atomic_load(&labels[dest_index]);
+    const int reached = fixed_weights != NULL ? labelFixedDistance(dest_label) != FIXED_INF : labelDistance(dest_label) != INF;
+    if (reached) {
+        // Retrieve and print the path
+        int current = dest_index;
+
+        RouteWriter route;
+        beginRoute(&route, "route", 0);
+        while (current != -1) {
+            addRoutePoint(&route, nodes[current].lat, nodes[current].lon);
+            current = labelPrevious(atomic_load(&labels[current])); // Move to the previous node
+        }
+        endRoute(&route);
+
+        const double length = fixed_weights != NULL
+            ? (double) labelFixedDistance(dest_label) / FIXED_SCALE
+            : labelDistance(dest_label);
+        printf("\t\"routeLength\": \"%.2fm\",\n", length);
+        free(labels);
+        return 0;
+    }
+    free(labels);
+    fprintf(stderr, "Target cannot be reached from source\n");
+    return 1;
+}
+
+int main(int argc, char *argv[]) {
+    // get the timestamp of the execution start
+    const double total_time_start = wallTimeMs();
+
+    // Start the Response JSON
+    printf("{\n");
+
+    // define arrays for start and destination
+    float start[2];   // Array for starting coordinates
+    float dest[2];    // Array for destination coordinates
+    float* bbox;      // Pointer for bounding box coordinates
+    int bbox_size;     // Size of the bounding box
+
+    // Read the optional bucket width, relaxation kernel and thread count, the remaining arguments are the coordinates
+    const char* delta_option = extractOption(&argc, argv, "delta");
+    const char* kernel_name;
+    const RelaxKernel kernel = selectRelaxKernel(extractOption(&argc, argv, "simd"), &kernel_name);
+    initializeTaskPool(threadCount(extractOption(&argc, argv, "threads")));
+    const int thread_count = taskThreadCount();
+
+    // Read the distance mode, "float" by default or "fixed" for integer distances in millimetres
+    const char* weights_option = extractOption(&argc, argv, "weights");
+    int fixed = 0;
+    if (weights_option != NULL && strcmp(weights_option, "fixed") == 0) {
+        fixed = 1;
+    } else if (weights_option != NULL && strcmp(weights_option, "float") != 0) {
+        fprintf(stderr, "Ignoring unknown weights '%s', using float distances instead\n", weights_option);
+    }
+
+    // Read the route format, "array" by default or "polyline" for an encoded polyline
+    selectRouteFormat(extractOption(&argc, argv, "route"));
+
+    // Parse the command-line arguments
+    if (parseArguments(argc, argv, start, dest, &bbox, &bbox_size) != 0) {
+        free(bbox);
+        return 1; // Exit if parsing failed
+    }
+
+    // initialise curl
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+
+    // get the nodes closest to the given address
+    const int64_t start_id = getClosestNode(start);
+    if (start_id == -1) {
+        fprintf(stderr, "Couldn't find closest Node to the start coordinates (%f, %f)\n", start[0], start[1]);
+        return 1;
+    }
+    printf("\t\"startNode\": %lld,\n", start_id);
+
+    const int64_t destination_id = getClosestNode(dest);
+    if (destination_id == -1) {
+        fprintf(stderr, "Couldn't find closest node to the destination coordinates (%f, %f)\n", dest[0], dest[1]);
+        return 1;
+    }
+    printf("\t\"destNode\": %lld,\n", destination_id);
+
+    // Initialise nodes Array and nodeCount
+    Node* nodes = NULL;
+    int nodeCount = 0;
+
+    // Initialise roads Array and roadCount
+    Road* roads = NULL;
+    int roadCount = 0;
+
+    // Data import
+    getRoadNodes(
+        bbox,
+        bbox_size,
+        &nodes,
+        &nodeCount,
+        &roads,
+        &roadCount);
+
+    // end curl
+    curl_global_cleanup();
+
+    // free the not needed data
+    free(bbox);
+
+    // Find the index of the start and dest node
+    int start_index = -1;
+    int dest_index = -1;
+    for (int i = 0; i < nodeCount; i++) {
+        if (nodes[i].id == start_id) start_index = i;
+        if (nodes[i].id == destination_id) dest_index = i;
+        if (start_index != -1 && dest_index != -1) break;
+    }
+
+    // If the source or target doesn't exist, exit the function
+    if (start_index == -1 || dest_index == -1) {
+        fprintf(stderr, "Invalid source or target ID\n");
+        free(nodes);
+        return -1;
+    }
+
+    // Define the Graph
+    const double graph_time_start = wallTimeMs();  // start the graph time measurement
+
+    // Fill the Graph using the Roads Data
+    createGraph(nodes, nodeCount, roads, roadCount);
+
+    // free the not needed data
+    free(roads);
+
+    // Flatten the graph into arrays, the edges of every node are split into light and heavy edges
+    int edges_start[nodeCount];  // Array that holds the starting index inside the edges array for each node
+    int light_end[nodeCount];  // Array that holds the index of the first heavy edge for each node
+    int *edge_destinations = NULL; // Array to hold the destination of each edge
+    float *edge_weights = NULL;    // Array to hold the weight of each edge
+
+    int edge_count = 0;
+    convert_to_device_arrays(nodes, nodeCount, edges_start, &edge_destinations, &edge_weights, &edge_count);
+
+    // Determine the bucket width from the graph unless the request sets it, starting a phase costs time on every thread
+    GraphStats stats;
+    computeGraphStats(&stats, nodeCount, edge_count, edge_weights);
+    const float delta = selectDelta(
+        delta_option, &stats, nodeCount, edge_count, edges_start, edge_destinations, edge_weights, start_index,
+        PHASE_COST_PER_THREAD * (float) thread_count);
+    partition_light_heavy_edges(nodeCount, edge_count, edges_start, edge_destinations, edge_weights, delta, light_end);
+
+    // Round the weights to millimetres for the fixed-point distances, after the partition so the order still holds
+    uint32_t *fixed_weights = NULL;
+    if (fixed) {
+        fixed_weights = malloc((edge_count > 0 ? edge_count : 1) * sizeof(uint32_t));
+        if (fixed_weights == NULL) {
+            fprintf(stderr, "Error: Unable to allocate memory for the fixed-point weights.\n");
+            exit(EXIT_FAILURE);
+        }
+        convert_to_fixed_weights(edge_count, edge_weights, fixed_weights);
+    }
+
+    // end the graph time and prints its result
+    const double graph_time = wallTimeMs() - graph_time_start;
+    printf("\t\"graphTime\": %.f,\n", graph_time);
+    printf("\t\"delta\": %.2f,\n", delta);
+    printf("\t\"threads\": %d,\n", thread_count);
+    printf("\t\"simd\": \"%s\",\n", fixed ? "scalar" : kernel_name);
+    printf("\t\"weights\": \"%s\",\n", fixed ? "fixed" : "float");
+
+    // Run the multi-threaded Delta stepping algorithm with the source and target IDs
+    const double routing_time_start = wallTimeMs();  // Start the routing time
+
+    const int result = threadedRoute(
+        nodeCount,
+        edge_count,
+        nodes,
+        edges_start,
+        light_end,
+        delta,
+        stats.max_weight,
+        edge_destinations,
+        edge_weights,
+        fixed_weights,
+        kernel,
+        start_index,
+        dest_index);
+    free(fixed_weights);
+    if (result != 0) {
+        freeNodes(nodes, nodeCount);
+        return 1;
+    }
+
+    freeNodes(nodes, nodeCount);
+    free(edge_destinations);
+    free(edge_weights);
+
+    // end the routing time and print its result
+    const double routing_time_ms = wallTimeMs() - routing_time_start;
+    printf("\t\"routingTime\": %.f,\n", routing_time_ms);
+
+    // get the total time and print its result
+    const double total_time = wallTimeMs() - total_time_start;
+    printf("\t\"totalTime\": %.f,\n", total_time);
+
+    // End the Response JSON
+    printf("\t\"success\": true\n}\n");
+    return 0;
+}
@@ -15,6 +15,28 @@
 #define RESPONSE_HEADER "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n\r\n"
 #define PATH_MAX 1024
 
+#define MAX_REQUEST_OPTIONS 8
+
+// Define the program of an algorithm together with the optional fields of a request it reads. Only these are handed
+// to the program as --name=value arguments, it would reject the coordinates if it got an option it doesn't know.
+typedef struct {
+    const char *algorithm;
+    const char *program;
+    const char *options[MAX_REQUEST_OPTIONS + 1];
+} AlgorithmProgram;
+
+static const AlgorithmProgram algorithm_programs[] = {
+    {"serial_dijkstra", "OpenPathCL_serial_dijkstra", {"weights", "route", NULL}},
+    {"serial_delta", "OpenPathCL_serial_delta", {"delta", "simd", "weights", "route", NULL}},
+    {"parallelizable", "OpenPathCL_parallelizable", {"delta", "route", NULL}},
+    {"parallel", "OpenPathCL_parallel", {"delta", "relaxation", "strategy", "kernels", "route", NULL}},
+    {"threaded", "OpenPathCL_threaded", {"delta", "simd", "threads", "weights", "route", NULL}},
+    {"alt", "OpenPathCL_alt", {"route", NULL}},
+    {"ch", "OpenPathCL_ch", {"route", NULL}},
+    {"overlay", "OpenPathCL_overlay", {"cellsize", "levels", "threads", "route", NULL}},
+    {NULL, NULL, {NULL}}
+};
+
 void serve_image(const int client_fd, const char *image_name, const unsigned char *image_data, const unsigned int image_len, const char *content_type) {
     size_t response_size = snprintf(NULL, 0, "HTTP/1.1 200 OK\r\nContent-Type: %s\r\nContent-Length: %u\r\n\r\n", content_type, image_len);
     char *response = malloc(response_size + 1);
@@ -125,15 +147,14 @@ void handle_form_submission(int client_fd, char *request_body) {
     }
 
     // Construct the full path to the executable
-    if (strcmp(algorithm->valuestring, "serial_dijkstra") == 0) {
-        snprintf(full_program_path, PATH_MAX, "%s/OpenPathCL_serial_dijkstra", cwd);
-    } else if (strcmp(algorithm->valuestring, "serial_delta") == 0) {
-        snprintf(full_program_path, PATH_MAX, "%s/OpenPathCL_serial_delta", cwd);
-    } else if (strcmp(algorithm->valuestring, "parallelizable") == 0) {
-        snprintf(full_program_path, PATH_MAX, "%s/OpenPathCL_parallelizable", cwd);
-    } else if (strcmp(algorithm->valuestring, "parallel") == 0) {
-        snprintf(full_program_path, PATH_MAX, "%s/OpenPathCL_parallel", cwd);
-    } else {
+    const AlgorithmProgram *selected = NULL;
+    for (int i = 0; algorithm_programs[i].algorithm != NULL; i++) {
+        if (strcmp(algorithm->valuestring, algorithm_programs[i].algorithm) == 0) {
+            selected = &algorithm_programs[i];
+            break;
+        }
+    }
+    if (selected == NULL) {
         printf("Invalid algorithm specified.\n");
         fflush(stdout);
         cJSON_Delete(json);
@@ -141,6 +162,7 @@ void handle_form_submission(int client_fd, char *request_body) {
         send(client_fd, response, strlen(response), 0);
         return;
     }
+    snprintf(full_program_path, PATH_MAX, "%s/%s", cwd, selected->program);
 
     // Calculate the number of arguments
     int bbox_size = cJSON_GetArraySize(bbox);
@@ -148,7 +170,7 @@ void handle_form_submission(int client_fd, char *request_body) {
     int num_args = 4 + num_bbox_args; // start(2), dest(2), bbox(num_bbox_args), plus the program name
 
     // Allocate memory for the argument array dynamically
-    char **args = malloc((num_args + 2) * sizeof(char *));  // +2 for program name and NULL termination
+    char **args = malloc((num_args + 2 + MAX_REQUEST_OPTIONS) * sizeof(char *));  // +2 for program name and NULL termination
     int arg_idx = 0;
 
     // First argument: Program name (with full path)
@@ -228,6 +250,21 @@ void handle_form_submission(int client_fd, char *request_body) {
         }
     }
 
+    // Add the optional settings of the request the algorithm reads, numbers and strings are passed on as they are
+    const char *const *request_options = selected->options;
+    for (int i = 0; request_options[i] != NULL; i++) {
+        const cJSON *option = cJSON_GetObjectItemCaseSensitive(json, request_options[i]);
+        char option_str[128];
+        if (cJSON_IsNumber(option)) {
+            snprintf(option_str, sizeof(option_str), "--%s=%g", request_options[i], option->valuedouble);
+        } else if (cJSON_IsString(option) && option->valuestring != NULL) {
+            snprintf(option_str, sizeof(option_str), "--%s=%s", request_options[i], option->valuestring);
+        } else {
+            continue;
+        }
+        args[arg_idx++] = strdup(option_str);
+    }
+
     // Null-terminate the argument list for execvp
     args[arg_idx] = NULL;
 
@@ -0,0 +1,218 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <float.h>  // For FLT_MAX
+
+#include "matrix_utils.h"
+#include "heap_utils.h"  // Include MinHeap functions
+#include "task_utils.h"  // Include parallelFor function
+#include "haversine.h"  // Include haversine function
+
+#define INF FLT_MAX
+
+// Define a struct holding the arguments of the parallel point snapping
+typedef struct {
+    const Node* nodes;
+    int vertices;
+    int edge_count;
+    const int* edges_start;
+    const float* points;
+    int* indices;
+} SnapTask;
+
+// Define the state of one thread of the matrix calculation, reused by all searches of the thread.
+// A distance is only valid if the stamp of its node holds the number of the current search,
+// so a search that stops early does not have to reset the distances of the whole graph.
+typedef struct {
+    float *dist;
+    int *stamp;
+    int search;  // number of the current search, counted from 1
+    MinHeap heap;
+} SearchState;
+
+// Define a struct holding the arguments of the parallel matrix calculation
+typedef struct {
+    DistanceMatrix *matrix;
+    int vertices;
+    int edge_count;
+    const int* edges_start;
+    const int* edge_destinations;
+    const float* edge_weights;
+    const int* sources;
+    const int* targets;
+    const char* is_target;  // is_target[v] is set if at least one target was snapped to node v
+    int distinct_targets;  // Number of different target nodes
+    SearchState *states;  // One state per thread of the task pool
+} MatrixTask;
+
+// Function to find the node with edges that lies closest to the point, -1 if the graph has no edges
+int snapToGraph(const Node* nodes, const int vertices, const int edge_count, const int* edges_start, const float* point) {
+    int closest = -1;
+    float closest_distance = INF;
+    for (int v = 0; v < vertices; v++) {
+        // nodes without edges can't be routed from or to
+        const int edge_end = (v == vertices - 1) ? edge_count : edges_start[v + 1];
+        if (edges_start[v] == edge_end) {
+            continue;
+        }
+        const float distance = haversine(point[0], point[1], nodes[v].lat, nodes[v].lon);
+        if (distance < closest_distance) {
+            closest_distance = distance;
+            closest = v;
+        }
+    }
+    return closest;
+}
+
+// Function to snap the points begin to end - 1 of a snap task
+static void snapPointRange(void *context, const int begin, const int end, const int worker_id) {
+    const SnapTask *task = context;
+    for (int i = begin; i < end; i++) {
+        task->indices[i] = snapToGraph(task->nodes, task->vertices, task->edge_count, task->edges_start, task->points + 2 * i);
+    }
+}
+
+// Function to snap every (lat, lon) pair of points to its closest node, on the threads of the task pool
+void snapPoints(
+    const Node* nodes,
+    const int vertices,
+    const int edge_count,
+    const int* edges_start,
+    const float* points,
+    const int point_count,
+    int* indices) {
+
+    SnapTask task = {nodes, vertices, edge_count, edges_start, points, indices};
+    parallelFor(0, point_count, 1, snapPointRange, &task);
+}
+
+// Function to get the distance of a node in the current search of a thread
+static float stateDistance(const SearchState *state, const int node) {
+    return state->stamp[node] == state->search ? state->dist[node] : INF;
+}
+
+// One-to-many Dijkstra from one source that stops as soon as every target node is settled
+static void oneToMany(const MatrixTask *task, SearchState *state, const int source) {
+    const int vertices = task->vertices;
+    const int* edges_start = task->edges_start;
+
+    // start a new search, all distances of the previous one become invalid
+    state->search++;
+    state->stamp[source] = state->search;
+    state->dist[source] = 0;
+    clearHeap(&state->heap);
+    pushHeap(&state->heap, source, 0);
+
+    int remaining = task->distinct_targets;
+    int node;
+    float key;
+    while (remaining > 0 && popHeap(&state->heap, &node, &key)) {
+        // Skip outdated heap entries
+        if (key > state->dist[node]) {
+            continue;
+        }
+        if (task->is_target[node]) {
+            remaining--;
+        }
+
+        const int edge_end = (node == vertices - 1) ? task->edge_count : edges_start[node + 1];
+        for (int edge = edges_start[node]; edge < edge_end; edge++) {
+            const int destination = task->edge_destinations[edge];
+            const float new_dist = key + task->edge_weights[edge];
+            if (new_dist < stateDistance(state, destination)) {
+                state->stamp[destination] = state->search;
+                state->dist[destination] = new_dist;
+                pushHeap(&state->heap, destination, new_dist);
+            }
+        }
+    }
+}
+
+// Function to calculate the matrix rows of the sources begin to end - 1 of a matrix task
+static void calculateMatrixRows(void *context, const int begin, const int end, const int worker_id) {
+    const MatrixTask *task = context;
+    SearchState *state = &task->states[worker_id];
+    DistanceMatrix *matrix = task->matrix;
+
+    for (int s = begin; s < end; s++) {
+        float *row = matrix->distances + (size_t) s * matrix->target_count;
+        if (task->sources[s] == -1) {
+            for (int t = 0; t < matrix->target_count; t++) {
+                row[t] = INF;
+            }
+            continue;
+        }
+
+        oneToMany(task, state, task->sources[s]);
+        for (int t = 0; t < matrix->target_count; t++) {
+            row[t] = task->targets[t] == -1 ? INF : stateDistance(state, task->targets[t]);
+        }
+    }
+}
+
+// Function to calculate the distances from every source to every target. Every source runs one search that stops
+// once all targets are settled, and the sources are spread over the threads of the task pool.
+// Sources or targets of -1 could not be snapped and get a distance of INF.
+void computeDistanceMatrix(
+    DistanceMatrix *matrix,
+    const int vertices,
+    const int edge_count,
+    const int* edges_start,
+    const int* edge_destinations,
+    const float* edge_weights,
+    const int* sources,
+    const int source_count,
+    const int* targets,
+    const int target_count) {
+
+    matrix->source_count = source_count;
+    matrix->target_count = target_count;
+    matrix->distances = malloc(((size_t) source_count * target_count > 0 ? (size_t) source_count * target_count : 1) * sizeof(float));
+
+    // mark the target nodes, several targets can be snapped to the same node
+    char *is_target = calloc(vertices > 0 ? vertices : 1, sizeof(char));
+    const int thread_count = taskThreadCount();
+    SearchState *states = malloc(thread_count * sizeof(SearchState));
+    if (matrix->distances == NULL || is_target == NULL || states == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the distance matrix.\n");
+        exit(EXIT_FAILURE);
+    }
+    int distinct_targets = 0;
+    for (int t = 0; t < target_count; t++) {
+        if (targets[t] != -1 && !is_target[targets[t]]) {
+            is_target[targets[t]] = 1;
+            distinct_targets++;
+        }
+    }
+
+    // allocate the state of every thread, no stamp matches a search before the first one
+    for (int i = 0; i < thread_count; i++) {
+        states[i].dist = malloc(vertices * sizeof(float));
+        states[i].stamp = calloc(vertices > 0 ? vertices : 1, sizeof(int));
+        states[i].search = 0;
+        if (states[i].dist == NULL || states[i].stamp == NULL) {
+            fprintf(stderr, "Error: Unable to allocate memory for the distance matrix.\n");
+            exit(EXIT_FAILURE);
+        }
+        initializeHeap(&states[i].heap, 1024);
+    }
+
+    // Calculate the rows in parallel on the threads of the task pool
+    MatrixTask task = {
+        matrix, vertices, edge_count, edges_start, edge_destinations, edge_weights, sources, targets, is_target,
+        distinct_targets, states};
+    parallelFor(0, source_count, 1, calculateMatrixRows, &task);
+
+    for (int i = 0; i < thread_count; i++) {
+        free(states[i].dist);
+        free(states[i].stamp);
+        freeHeap(&states[i].heap);
+    }
+    free(states);
+    free(is_target);
+}
+
+// Function to free the distances of the matrix
+void freeDistanceMatrix(DistanceMatrix *matrix) {
+    free(matrix->distances);
+    matrix->distances = NULL;
+}
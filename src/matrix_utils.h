@@ -0,0 +1,36 @@
+#ifndef MATRIX_UTILS_H
+#define MATRIX_UTILS_H
+
+#include "graph_utils.h"  // For Node struct
+
+// Define a struct to store the distances between a set of sources and a set of targets
+typedef struct {
+    int source_count;  // Number of rows
+    int target_count;  // Number of columns
+    float *distances;  // distances[s * target_count + t] holds the distance from source s to target t, INF if unreachable
+} DistanceMatrix;
+
+// Matrix functions
+int snapToGraph(const Node* nodes, const int vertices, const int edge_count, const int* edges_start, const float* point);
+void snapPoints(
+    const Node* nodes,
+    const int vertices,
+    const int edge_count,
+    const int* edges_start,
+    const float* points,
+    const int point_count,
+    int* indices);
+void computeDistanceMatrix(
+    DistanceMatrix *matrix,
+    const int vertices,
+    const int edge_count,
+    const int* edges_start,
+    const int* edge_destinations,
+    const float* edge_weights,
+    const int* sources,
+    const int source_count,
+    const int* targets,
+    const int target_count);
+void freeDistanceMatrix(DistanceMatrix *matrix);
+
+#endif //MATRIX_UTILS_H
@@ -0,0 +1,1318 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>  // For memcpy and strstr
+#include <float.h>  // For FLT_MAX
+#include <limits.h>  // For INT_MAX
+
+#include "opencl_engine.h"
+#include "parallel_utils.h"  // Include the fixed-point conversion
+
+#define INF FLT_MAX
+#define EDGE_PARALLEL_MIN_EDGES 256  // Smallest number of edges of a phase for which the edge-parallel kernel pays off
+#define EDGE_PARALLEL_SKEW 4  // Ratio of the largest to the average degree of a phase from which edges are spread
+#define KERNEL_UNROLL 4  // Unroll factor of the relaxation loops in specialized builds
+
+#define CHECK_ERROR(err, msg) \
+    if (err != CL_SUCCESS) { \
+    fprintf(stderr, "%s failed with error code %d\n", msg, err); \
+    exit(EXIT_FAILURE); \
+    }
+
+// Unroll hint of the relaxation loops, a specialized build sets RELAX_UNROLL with a -D option (see createEngine).
+// Without it the hint expands to nothing and the compiler treats the loops as it likes.
+#define KERNEL_DEFAULTS \
+"#ifdef RELAX_UNROLL                                                                \n" \
+"#define UNROLL_PRAGMA(x) _Pragma(#x)                                               \n" \
+"#define UNROLL_HINT(n) UNROLL_PRAGMA(unroll n)                                     \n" \
+"#else                                                                              \n" \
+"#define UNROLL_HINT(n)                                                             \n" \
+"#endif                                                                             \n" \
+"                                                                                   \n"
+
+const char* kernel_source =
+KERNEL_DEFAULTS
+"__kernel void process_bucket_nodes(                                                \n"
+"   __global float* dist,                                                           \n"
+"   __global int* prev,                                                             \n"
+"   __global const int* edges_start,                                                \n"
+"   __global const int* light_end,                                                  \n"
+"   __global const int* edge_destinations,                                          \n"
+"   __global const float* edge_weights,                                             \n"
+"   __global const int* bucket_nodes,                                               \n"
+"   __global int* queued,                                                           \n"
+"   __global int* frontier,                                                         \n"
+"   __global int* frontier_size,                                                    \n"
+"   const int heavy                                                                 \n"
+") {                                                                                \n"
+"   int node = bucket_nodes[get_global_id(0)];                                      \n"
+"                                                                                   \n"
+"   // light edges range from the start of the node edges to light_end,             \n"
+"   // heavy edges from light_end to the start of the next node                     \n"
+"   int edge_begin = heavy ? light_end[node] : edges_start[node];                   \n"
+"   int edge_end = light_end[node];                                                 \n"
+"   if (heavy) {                                                                    \n"
+"       edge_end = edges_start[node + 1];                                           \n"
+"   }                                                                               \n"
+"                                                                                   \n"
+"   UNROLL_HINT(RELAX_UNROLL)                                                       \n"
+"   for (int edge = edge_begin; edge < edge_end; edge++) {                          \n"
+"       // calculate the new distance                                               \n"
+"       const float new_dist = dist[node] + edge_weights[edge];                     \n"
+"                                                                                   \n"
+"       // check if the new distance is sorter that the previous one                \n"
+"       if (dist[edge_destinations[edge]] > new_dist) {                             \n"
+"           // update the dest and prev of the next node                            \n"
+"           dist[edge_destinations[edge]] = new_dist;                               \n"
+"           prev[edge_destinations[edge]] = node;                                   \n"
+"                                                                                   \n"
+"           // append the next node to the frontier, unless it is already in it     \n"
+"           if (atomic_xchg(&queued[edge_destinations[edge]], 1) == 0) {            \n"
+"               frontier[2 * atomic_inc(frontier_size)] = edge_destinations[edge];  \n"
+"           }                                                                       \n"
+"       }                                                                           \n"
+"   }                                                                               \n"
+"}                                                                                  \n"
+"                                                                                   \n"
+"__kernel void compact_frontier(                                                    \n"
+"   __global const float* dist,                                                     \n"
+"   __global int* queued,                                                           \n"
+"   __global int* frontier,                                                         \n"
+"   const float delta                                                               \n"
+") {                                                                                \n"
+"   int node = frontier[2 * get_global_id(0)];                                      \n"
+"                                                                                   \n"
+"   // pair the node with the bucket of its final distance of this phase,           \n"
+"   // light edges can lead back into the current bucket                            \n"
+"   frontier[2 * get_global_id(0) + 1] = (int)(dist[node] / delta);                 \n"
+"   queued[node] = 0;                                                               \n"
+"}";
+
+// The plain kernel above lets two work items write dist and prev of the same node at the same time, so a shorter
+// distance can be overwritten or paired with the wrong previous node. The atomic kernel avoids this by packing both
+// into one 64-bit label that is only replaced by a compare-and-swap if the new distance is shorter.
+const char* atomic_kernel_source =
+KERNEL_DEFAULTS
+"#pragma OPENCL EXTENSION cl_khr_int64_base_atomics : enable                        \n"
+"                                                                                   \n"
+"// a label holds the distance of a node in the upper and its previous node in the  \n"
+"// lower 32 bits, distances are never negative so labels compare like distances    \n"
+"__kernel void process_bucket_nodes_atomic(                                         \n"
+"   __global ulong* labels,                                                         \n"
+"   __global const int* edges_start,                                                \n"
+"   __global const int* light_end,                                                  \n"
+"   __global const int* edge_destinations,                                          \n"
+"   __global const float* edge_weights,                                             \n"
+"   __global const int* bucket_nodes,                                               \n"
+"   __global int* queued,                                                           \n"
+"   __global int* frontier,                                                         \n"
+"   __global int* frontier_size,                                                    \n"
+"   const int heavy                                                                 \n"
+") {                                                                                \n"
+"   int node = bucket_nodes[get_global_id(0)];                                      \n"
+"   const float node_dist = as_float((uint)(atom_add(&labels[node], 0) >> 32));     \n"
+"                                                                                   \n"
+"   // light edges range from the start of the node edges to light_end,             \n"
+"   // heavy edges from light_end to the start of the next node                     \n"
+"   int edge_begin = heavy ? light_end[node] : edges_start[node];                   \n"
+"   int edge_end = light_end[node];                                                 \n"
+"   if (heavy) {                                                                    \n"
+"       edge_end = edges_start[node + 1];                                           \n"
+"   }                                                                               \n"
+"                                                                                   \n"
+"   UNROLL_HINT(RELAX_UNROLL)                                                       \n"
+"   for (int edge = edge_begin; edge < edge_end; edge++) {                          \n"
+"       const int destination = edge_destinations[edge];                            \n"
+"       const float new_dist = node_dist + edge_weights[edge];                      \n"
+"       const ulong new_label = ((ulong)as_uint(new_dist) << 32) | (uint)node;      \n"
+"                                                                                   \n"
+"       // replace the label as long as the new distance is shorter, a failed swap  \n"
+"       // returns the label another work item wrote in the meantime                \n"
+"       __global ulong* label = &labels[destination];                               \n"
+"       ulong current = atom_add(label, 0);                                         \n"
+"       while (new_dist < as_float((uint)(current >> 32))) {                        \n"
+"           const ulong previous = atom_cmpxchg(label, current, new_label);         \n"
+"           if (previous == current) {                                              \n"
+"               // append the next node to the frontier, unless it is already in it \n"
+"               if (atomic_xchg(&queued[destination], 1) == 0) {                    \n"
+"                   frontier[2 * atomic_inc(frontier_size)] = destination;          \n"
+"               }                                                                   \n"
+"               break;                                                              \n"
+"           }                                                                       \n"
+"           current = previous;                                                     \n"
+"       }                                                                           \n"
+"   }                                                                               \n"
+"}                                                                                  \n"
+"                                                                                   \n"
+"__kernel void compact_frontier_atomic(                                             \n"
+"   __global const ulong* labels,                                                   \n"
+"   __global int* queued,                                                           \n"
+"   __global int* frontier,                                                         \n"
+"   const float delta                                                               \n"
+") {                                                                                \n"
+"   int node = frontier[2 * get_global_id(0)];                                      \n"
+"                                                                                   \n"
+"   // pair the node with the bucket of its final distance of this phase            \n"
+"   const float dist = as_float((uint)(labels[node] >> 32));                        \n"
+"   frontier[2 * get_global_id(0) + 1] = (int)(dist / delta);                       \n"
+"   queued[node] = 0;                                                               \n"
+"}                                                                                  \n"
+"                                                                                   \n"
+"// edge-parallel variant with one work item per edge of the bucket nodes.          \n"
+"// edge_offsets holds the index of the first edge of every bucket node, and a      \n"
+"// binary search finds the node of an edge, so the edges of a node with many       \n"
+"// edges are spread over many work items                                           \n"
+"__kernel void process_bucket_edges_atomic(                                         \n"
+"   __global ulong* labels,                                                         \n"
+"   __global const int* edges_start,                                                \n"
+"   __global const int* light_end,                                                  \n"
+"   __global const int* edge_destinations,                                          \n"
+"   __global const float* edge_weights,                                             \n"
+"   __global const int* bucket_nodes,                                               \n"
+"   __global const int* edge_offsets,                                               \n"
+"   __global int* queued,                                                           \n"
+"   __global int* frontier,                                                         \n"
+"   __global int* frontier_size,                                                    \n"
+"   const int bucket_size,                                                          \n"
+"   const int heavy                                                                 \n"
+") {                                                                                \n"
+"   const int edge_id = get_global_id(0);                                           \n"
+"                                                                                   \n"
+"   // find the last bucket node whose edges start at or before this edge           \n"
+"   int low = 0;                                                                    \n"
+"   int high = bucket_size - 1;                                                     \n"
+"   while (low < high) {                                                            \n"
+"       const int middle = (low + high + 1) / 2;                                    \n"
+"       if (edge_offsets[middle] <= edge_id) {                                      \n"
+"           low = middle;                                                           \n"
+"       } else {                                                                    \n"
+"           high = middle - 1;                                                      \n"
+"       }                                                                           \n"
+"   }                                                                               \n"
+"   const int node = bucket_nodes[low];                                             \n"
+"   const int edge_begin = heavy ? light_end[node] : edges_start[node];             \n"
+"   const int edge = edge_begin + edge_id - edge_offsets[low];                      \n"
+"                                                                                   \n"
+"   const float node_dist = as_float((uint)(atom_add(&labels[node], 0) >> 32));     \n"
+"   const int destination = edge_destinations[edge];                                \n"
+"   const float new_dist = node_dist + edge_weights[edge];                          \n"
+"   const ulong new_label = ((ulong)as_uint(new_dist) << 32) | (uint)node;          \n"
+"                                                                                   \n"
+"   // replace the label as long as the new distance is shorter                     \n"
+"   __global ulong* label = &labels[destination];                                   \n"
+"   ulong current = atom_add(label, 0);                                             \n"
+"   while (new_dist < as_float((uint)(current >> 32))) {                            \n"
+"       const ulong previous = atom_cmpxchg(label, current, new_label);             \n"
+"       if (previous == current) {                                                  \n"
+"           if (atomic_xchg(&queued[destination], 1) == 0) {                        \n"
+"               frontier[2 * atomic_inc(frontier_size)] = destination;              \n"
+"           }                                                                       \n"
+"           break;                                                                  \n"
+"       }                                                                           \n"
+"       current = previous;                                                         \n"
+"   }                                                                               \n"
+"}";
+
+// The fixed-point kernels keep the distances as millimetres in 32-bit integers. atomic_min lowers them on any
+// OpenCL 1.2 device, and since integer sums are exact the previous nodes are found after the search: every edge
+// whose weight is exactly the difference of the distances of its ends lies on a shortest path.
+const char* fixed_kernel_source =
+KERNEL_DEFAULTS
+"__kernel void process_bucket_nodes_fixed(                                          \n"
+"   __global uint* dist,                                                            \n"
+"   __global const int* edges_start,                                                \n"
+"   __global const int* light_end,                                                  \n"
+"   __global const int* edge_destinations,                                          \n"
+"   __global const uint* edge_weights,                                              \n"
+"   __global const int* bucket_nodes,                                               \n"
+"   __global int* queued,                                                           \n"
+"   __global int* frontier,                                                         \n"
+"   __global int* frontier_size,                                                    \n"
+"   const int heavy                                                                 \n"
+") {                                                                                \n"
+"   int node = bucket_nodes[get_global_id(0)];                                      \n"
+"   const uint node_dist = dist[node];                                              \n"
+"                                                                                   \n"
+"   // light edges range from the start of the node edges to light_end,             \n"
+"   // heavy edges from light_end to the start of the next node                     \n"
+"   int edge_begin = heavy ? light_end[node] : edges_start[node];                   \n"
+"   int edge_end = light_end[node];                                                 \n"
+"   if (heavy) {                                                                    \n"
+"       edge_end = edges_start[node + 1];                                           \n"
+"   }                                                                               \n"
+"                                                                                   \n"
+"   UNROLL_HINT(RELAX_UNROLL)                                                       \n"
+"   for (int edge = edge_begin; edge < edge_end; edge++) {                          \n"
+"       const int destination = edge_destinations[edge];                            \n"
+"       const uint new_dist = add_sat(node_dist, edge_weights[edge]);               \n"
+"                                                                                   \n"
+"       // atomic_min returns the old distance, only the work item that lowered it  \n"
+"       // appends the node to the frontier                                         \n"
+"       if (new_dist < dist[destination] &&                                         \n"
+"           atomic_min(&dist[destination], new_dist) > new_dist) {                  \n"
+"           if (atomic_xchg(&queued[destination], 1) == 0) {                        \n"
+"               frontier[2 * atomic_inc(frontier_size)] = destination;              \n"
+"           }                                                                       \n"
+"       }                                                                           \n"
+"   }                                                                               \n"
+"}                                                                                  \n"
+"                                                                                   \n"
+"__kernel void compact_frontier_fixed(                                              \n"
+"   __global const uint* dist,                                                      \n"
+"   __global int* queued,                                                           \n"
+"   __global int* frontier,                                                         \n"
+"   const uint delta                                                                \n"
+") {                                                                                \n"
+"   int node = frontier[2 * get_global_id(0)];                                      \n"
+"                                                                                   \n"
+"   // the integer division gives the same bucket as on the host                    \n"
+"   frontier[2 * get_global_id(0) + 1] = (int)(dist[node] / delta);                 \n"
+"   queued[node] = 0;                                                               \n"
+"}                                                                                  \n"
+"                                                                                   \n"
+"// edge-parallel variant of the fixed-point kernel with one work item per edge,    \n"
+"// it finds the node of its edge like process_bucket_edges_atomic                  \n"
+"__kernel void process_bucket_edges_fixed(                                          \n"
+"   __global uint* dist,                                                            \n"
+"   __global const int* edges_start,                                                \n"
+"   __global const int* light_end,                                                  \n"
+"   __global const int* edge_destinations,                                          \n"
+"   __global const uint* edge_weights,                                              \n"
+"   __global const int* bucket_nodes,                                               \n"
+"   __global const int* edge_offsets,                                               \n"
+"   __global int* queued,                                                           \n"
+"   __global int* frontier,                                                         \n"
+"   __global int* frontier_size,                                                    \n"
+"   const int bucket_size,                                                          \n"
+"   const int heavy                                                                 \n"
+") {                                                                                \n"
+"   const int edge_id = get_global_id(0);                                           \n"
+"                                                                                   \n"
+"   // find the last bucket node whose edges start at or before this edge           \n"
+"   int low = 0;                                                                    \n"
+"   int high = bucket_size - 1;                                                     \n"
+"   while (low < high) {                                                            \n"
+"       const int middle = (low + high + 1) / 2;                                    \n"
+"       if (edge_offsets[middle] <= edge_id) {                                      \n"
+"           low = middle;                                                           \n"
+"       } else {                                                                    \n"
+"           high = middle - 1;                                                      \n"
+"       }                                                                           \n"
+"   }                                                                               \n"
+"   const int node = bucket_nodes[low];                                             \n"
+"   const int edge_begin = heavy ? light_end[node] : edges_start[node];             \n"
+"   const int edge = edge_begin + edge_id - edge_offsets[low];                      \n"
+"                                                                                   \n"
+"   const int destination = edge_destinations[edge];                                \n"
+"   const uint new_dist = add_sat(dist[node], edge_weights[edge]);                  \n"
+"                                                                                   \n"
+"   // atomic_min returns the old distance, only the work item that lowered it      \n"
+"   // appends the node to the frontier                                             \n"
+"   if (new_dist < dist[destination] &&                                             \n"
+"       atomic_min(&dist[destination], new_dist) > new_dist) {                      \n"
+"       if (atomic_xchg(&queued[destination], 1) == 0) {                            \n"
+"           frontier[2 * atomic_inc(frontier_size)] = destination;                  \n"
+"       }                                                                           \n"
+"   }                                                                               \n"
+"}                                                                                  \n"
+"                                                                                   \n"
+"// one work item per node, every edge that closes its distance exactly marks the   \n"
+"// node as the previous node of its destination. Any of them is a shortest path    \n"
+"// and every weight is at least 1, so the previous nodes never form a loop         \n"
+"__kernel void fixed_predecessors(                                                  \n"
+"   __global const uint* dist,                                                      \n"
+"   __global int* prev,                                                             \n"
+"   __global const int* edges_start,                                                \n"
+"   __global const int* edge_destinations,                                          \n"
+"   __global const uint* edge_weights                                               \n"
+") {                                                                                \n"
+"   int node = get_global_id(0);                                                    \n"
+"   const uint node_dist = dist[node];                                              \n"
+"   if (node_dist == UINT_MAX) {                                                    \n"
+"       return;                                                                     \n"
+"   }                                                                               \n"
+"   int edge_end = edges_start[node + 1];                                           \n"
+"                                                                                   \n"
+"   for (int edge = edges_start[node]; edge < edge_end; edge++) {                   \n"
+"       const int destination = edge_destinations[edge];                            \n"
+"       if (dist[destination] != UINT_MAX &&                                        \n"
+"           add_sat(node_dist, edge_weights[edge]) == dist[destination]) {          \n"
+"           prev[destination] = node;                                               \n"
+"       }                                                                           \n"
+"   }                                                                               \n"
+"}";
+
+const char* near_far_kernel_source =
+KERNEL_DEFAULTS
+"#pragma OPENCL EXTENSION cl_khr_int64_base_atomics : enable                        \n"
+"                                                                                   \n"
+"// labels are packed like in process_bucket_nodes_atomic. A node is appended to the\n"
+"// near list of a step or the far pile of a phase only once, the stamps hold       \n"
+"// the step or phase a node was appended in last                                   \n"
+"__kernel void near_far_relax(                                                      \n"
+"   __global ulong* labels,                                                         \n"
+"   __global const int* edges_start,                                                \n"
+"   __global const int* edge_destinations,                                          \n"
+"   __global const float* edge_weights,                                             \n"
+"   __global const int* near_in,                                                    \n"
+"   __global int* near_out,                                                         \n"
+"   __global int* far_pile,                                                         \n"
+"   __global int* counts,                                                           \n"
+"   __global int* near_stamp,                                                       \n"
+"   __global int* far_stamp,                                                        \n"
+"   const float threshold,                                                          \n"
+"   const int step,                                                                 \n"
+"   const int phase                                                                 \n"
+") {                                                                                \n"
+"   int node = near_in[get_global_id(0)];                                           \n"
+"   const float node_dist = as_float((uint)(atom_add(&labels[node], 0) >> 32));     \n"
+"   int edge_end = edges_start[node + 1];                                           \n"
+"                                                                                   \n"
+"   UNROLL_HINT(RELAX_UNROLL)                                                       \n"
+"   for (int edge = edges_start[node]; edge < edge_end; edge++) {                   \n"
+"       const int destination = edge_destinations[edge];                            \n"
+"       const float new_dist = node_dist + edge_weights[edge];                      \n"
+"       const ulong new_label = ((ulong)as_uint(new_dist) << 32) | (uint)node;      \n"
+"                                                                                   \n"
+"       // replace the label as long as the new distance is shorter                 \n"
+"       __global ulong* label = &labels[destination];                               \n"
+"       ulong current = atom_add(label, 0);                                         \n"
+"       while (new_dist < as_float((uint)(current >> 32))) {                        \n"
+"           const ulong previous = atom_cmpxchg(label, current, new_label);         \n"
+"           if (previous == current) {                                              \n"
+"               // near nodes are relaxed by the next step,                         \n"
+"               // far nodes wait until the threshold passes them                   \n"
+"               if (new_dist < threshold) {                                         \n"
+"                   if (atomic_xchg(&near_stamp[destination], step) != step) {      \n"
+"                       near_out[atomic_inc(&counts[0])] = destination;             \n"
+"                   }                                                               \n"
+"               } else if (atomic_xchg(&far_stamp[destination], phase) != phase) {  \n"
+"                   far_pile[atomic_inc(&counts[1])] = destination;                 \n"
+"               }                                                                   \n"
+"               break;                                                              \n"
+"           }                                                                       \n"
+"           current = previous;                                                     \n"
+"       }                                                                           \n"
+"   }                                                                               \n"
+"}                                                                                  \n"
+"                                                                                   \n"
+"__kernel void near_far_split(                                                      \n"
+"   __global const ulong* labels,                                                   \n"
+"   __global const int* far_in,                                                     \n"
+"   __global int* near_out,                                                         \n"
+"   __global int* far_out,                                                          \n"
+"   __global int* counts,                                                           \n"
+"   __global int* near_stamp,                                                       \n"
+"   __global int* far_stamp,                                                        \n"
+"   const float settled_below,                                                      \n"
+"   const float threshold,                                                          \n"
+"   const int step,                                                                 \n"
+"   const int phase                                                                 \n"
+") {                                                                                \n"
+"   int node = far_in[get_global_id(0)];                                            \n"
+"   const float dist = as_float((uint)(labels[node] >> 32));                        \n"
+"                                                                                   \n"
+"   // nodes closer than the previous threshold were relaxed as near nodes already  \n"
+"   if (dist < settled_below) {                                                     \n"
+"       return;                                                                     \n"
+"   }                                                                               \n"
+"   if (dist < threshold) {                                                         \n"
+"       if (atomic_xchg(&near_stamp[node], step) != step) {                         \n"
+"           near_out[atomic_inc(&counts[0])] = node;                                \n"
+"       }                                                                           \n"
+"   } else if (atomic_xchg(&far_stamp[node], phase) != phase) {                     \n"
+"       far_out[atomic_inc(&counts[1])] = node;                                     \n"
+"                                                                                   \n"
+"       // remember the closest far node, positive floats compare like their bits   \n"
+"       atomic_min(&counts[2], as_int(dist));                                       \n"
+"   }                                                                               \n"
+"}";
+
+
+// Function to pack a distance and a previous node into a label of the atomic kernel
+static cl_ulong packLabel(const float dist, const int prev) {
+    cl_uint dist_bits;
+    memcpy(&dist_bits, &dist, sizeof(dist_bits));
+    return ((cl_ulong) dist_bits << 32) | (cl_uint) prev;
+}
+
+// Function to get the distance of a label
+static float labelDistance(const cl_ulong label) {
+    const cl_uint dist_bits = (cl_uint) (label >> 32);
+    float dist;
+    memcpy(&dist, &dist_bits, sizeof(dist));
+    return dist;
+}
+
+// Function to check if the device supports the 64-bit atomics the atomic kernel needs
+static int supportsAtomicLabels(cl_device_id device) {
+    size_t extensions_size = 0;
+    if (clGetDeviceInfo(device, CL_DEVICE_EXTENSIONS, 0, NULL, &extensions_size) != CL_SUCCESS) {
+        return 0;
+    }
+    char extensions[extensions_size + 1];
+    if (clGetDeviceInfo(device, CL_DEVICE_EXTENSIONS, extensions_size, extensions, NULL) != CL_SUCCESS) {
+        return 0;
+    }
+    extensions[extensions_size] = '\0';
+    return strstr(extensions, "cl_khr_int64_base_atomics") != NULL;
+}
+
+// Function to map a buffer into the host memory, only used on devices that share their memory with the host
+static void* mapBuffer(
+    OpenCLEngine *engine,
+    cl_mem buffer,
+    const cl_map_flags flags,
+    const size_t offset,
+    const size_t size,
+    const char* name) {
+    cl_int cl_status;
+    void* mapped = clEnqueueMapBuffer(engine->queue, buffer, CL_TRUE, flags, offset, size, 0, NULL, NULL, &cl_status);
+    CHECK_ERROR(cl_status, name)
+    return mapped;
+}
+
+// Function to hand a mapped buffer back to the device
+static void unmapBuffer(OpenCLEngine *engine, cl_mem buffer, void* mapped) {
+    const cl_int cl_status = clEnqueueUnmapMemObject(engine->queue, buffer, mapped, 0, NULL, NULL);
+    CHECK_ERROR(cl_status, "clEnqueueUnmapMemObject")
+}
+
+// Function to copy host data into a buffer. On zero-copy devices the buffer is mapped and written directly,
+// otherwise the driver copies the data to the device.
+static void writeBuffer(
+    OpenCLEngine *engine,
+    cl_mem buffer,
+    const size_t offset,
+    const size_t size,
+    const void* data,
+    const char* name) {
+    if (engine->zero_copy) {
+        void* mapped = mapBuffer(engine, buffer, CL_MAP_WRITE_INVALIDATE_REGION, offset, size, name);
+        memcpy(mapped, data, size);
+        unmapBuffer(engine, buffer, mapped);
+        return;
+    }
+    const cl_int cl_status = clEnqueueWriteBuffer(engine->queue, buffer, CL_TRUE, offset, size, data, 0, NULL, NULL);
+    CHECK_ERROR(cl_status, name)
+}
+
+// Function to copy a buffer into host memory, through a mapping on zero-copy devices
+static void readBuffer(
+    OpenCLEngine *engine,
+    cl_mem buffer,
+    const size_t offset,
+    const size_t size,
+    void* data,
+    const char* name) {
+    if (engine->zero_copy) {
+        void* mapped = mapBuffer(engine, buffer, CL_MAP_READ, offset, size, name);
+        memcpy(data, mapped, size);
+        unmapBuffer(engine, buffer, mapped);
+        return;
+    }
+    const cl_int cl_status = clEnqueueReadBuffer(engine->queue, buffer, CL_TRUE, offset, size, data, 0, NULL, NULL);
+    CHECK_ERROR(cl_status, name)
+}
+
+// Function to read the current distance of the destination from the device, in millimetres for the fixed-point kernels
+static double readDestDistance(OpenCLEngine *engine, const int dest_index) {
+    if (engine->fixed) {
+        cl_uint dest_dist;
+        readBuffer(engine, engine->dist_buffer, dest_index * sizeof(cl_uint), sizeof(cl_uint), &dest_dist, "reading dest_dist");
+        return dest_dist == FIXED_INF ? INF : dest_dist;
+    }
+    if (engine->atomic) {
+        cl_ulong dest_label;
+        readBuffer(engine, engine->dist_buffer, dest_index * sizeof(cl_ulong), sizeof(cl_ulong), &dest_label, "reading dest_label");
+        return labelDistance(dest_label);
+    }
+    float dest_dist;
+    readBuffer(engine, engine->dist_buffer, dest_index * sizeof(float), sizeof(float), &dest_dist, "reading dest_dist");
+    return dest_dist;
+}
+
+// Function to move the nodes of the frontier into their buckets
+static void collectFrontier(
+    BucketsArray* bucketsArray,
+    const int* frontier,
+    const int frontier_size) {
+
+    for (int i = 0; i < frontier_size; i++) {
+        addNodeToBucket(bucketsArray, frontier[2 * i + 1], frontier[2 * i]);
+    }
+}
+
+// Function to decide from the degrees of the phase nodes if the edge-parallel kernel relaxes the phase, and to fill
+// the edge offsets it needs. A work item of the node kernel relaxes all edges of its node, so a node with many more
+// edges than the others keeps their work items waiting, while the edge kernel gives every work item one edge at the
+// cost of a binary search and a second transfer.
+static int prepareEdgeParallel(
+    OpenCLEngine *engine,
+    const int* bucket_nodes,
+    const int bucket_size,
+    const int heavy,
+    int* edge_total) {
+
+    if (engine->edge_kernel == NULL) {
+        return 0;
+    }
+
+    // prefix sum over the degrees of the light or heavy edges
+    const int* edges_start = engine->graph_edges_start;
+    const int* light_end = engine->graph_light_end;
+    int total = 0;
+    int max_degree = 0;
+    for (int i = 0; i < bucket_size; i++) {
+        const int node = bucket_nodes[i];
+        int degree = light_end[node] - edges_start[node];
+        if (heavy) {
+            const int edge_end = (node == engine->vertices - 1) ? engine->edge_count : edges_start[node + 1];
+            degree = edge_end - light_end[node];
+        }
+        engine->edge_offsets[i] = total;
+        total += degree;
+        if (degree > max_degree) {
+            max_degree = degree;
+        }
+    }
+    *edge_total = total;
+
+    // spread the edges if the largest degree is far above the average
+    return total >= EDGE_PARALLEL_MIN_EDGES && (long) max_degree * bucket_size >= (long) EDGE_PARALLEL_SKEW * total;
+}
+
+// Function to run the kernels for the given nodes and move the improved nodes into their new buckets.
+// The relaxation kernel appends every improved node to the frontier once, the compaction kernel adds the buckets,
+// so only the frontier travels back to the host, or is read in place on zero-copy devices.
+static void runBucketKernel(
+    OpenCLEngine *engine,
+    const int* bucket_nodes,
+    const int bucket_size,
+    const int heavy,
+    const int dest_index,
+    double* dest_dist) {
+
+    // check if there is stuff to do
+    if (bucket_size == 0) {
+        return;
+    }
+
+    cl_int cl_status;
+    cl_command_queue queue = engine->queue;
+
+    // set work size, one work item per node or, for phases with very uneven degrees, per edge
+    int edge_total = 0;
+    const int edge_parallel = prepareEdgeParallel(engine, bucket_nodes, bucket_size, heavy, &edge_total);
+    size_t globalWorkSize[1] = {edge_parallel ? edge_total : bucket_size};
+
+    // set the new bucket_nodes and empty the frontier in OpenCL
+    const int frontier_size_zero = 0;
+    writeBuffer(engine, engine->bucket_nodes_buffer, 0, bucket_size * sizeof(int), bucket_nodes, "writing bucket_nodes_buffer");
+    writeBuffer(engine, engine->frontier_size_buffer, 0, sizeof(int), &frontier_size_zero, "writing frontier_size_buffer");
+
+    // select the light or the heavy edges
+    cl_kernel kernel = engine->kernel;
+    if (edge_parallel) {
+        kernel = engine->edge_kernel;
+        writeBuffer(engine, engine->edge_offsets_buffer, 0, bucket_size * sizeof(int), engine->edge_offsets, "writing edge_offsets_buffer");
+        cl_status = clSetKernelArg(kernel, 10, sizeof(int), &bucket_size);
+        CHECK_ERROR(cl_status, "clSetKernelArg for bucket_size")
+        cl_status = clSetKernelArg(kernel, 11, sizeof(int), &heavy);
+        CHECK_ERROR(cl_status, "clSetKernelArg for edge heavy")
+        engine->edge_parallel_phases++;
+    } else {
+        cl_status = clSetKernelArg(kernel, engine->heavy_arg, sizeof(int), &heavy);
+        CHECK_ERROR(cl_status, "clSetKernelArg for heavy")
+    }
+
+    // execute kernels on the GPU
+    cl_status = clEnqueueNDRangeKernel(queue, kernel, 1, NULL, globalWorkSize, NULL, 0, NULL, NULL);
+    CHECK_ERROR(cl_status, "clEnqueueNDRangeKernel")
+
+    // get back the number of improved nodes, the read waits for the kernel
+    int frontier_size = 0;
+    readBuffer(engine, engine->frontier_size_buffer, 0, sizeof(int), &frontier_size, "reading frontier_size");
+
+    if (frontier_size > 0) {
+        // pair every improved node with its bucket and reset its mark
+        size_t frontierWorkSize[1] = {frontier_size};
+        cl_status = clEnqueueNDRangeKernel(queue, engine->compact_kernel, 1, NULL, frontierWorkSize, NULL, 0, NULL, NULL);
+        CHECK_ERROR(cl_status, "clEnqueueNDRangeKernel for compact_frontier")
+
+        // get the (node, bucket) pairs of the frontier
+        const size_t frontier_bytes = 2 * frontier_size * sizeof(int);
+        if (engine->zero_copy) {
+            int* frontier = mapBuffer(engine, engine->frontier_buffer, CL_MAP_READ, 0, frontier_bytes, "mapping frontier_buffer");
+            collectFrontier(&engine->buckets, frontier, frontier_size);
+            unmapBuffer(engine, engine->frontier_buffer, frontier);
+        } else {
+            readBuffer(engine, engine->frontier_buffer, 0, frontier_bytes, engine->frontier, "reading frontier_buffer");
+            collectFrontier(&engine->buckets, engine->frontier, frontier_size);
+        }
+    }
+
+    // get back the distance of the destination for the termination check
+    if (dest_index != -1) {
+        *dest_dist = readDestDistance(engine, dest_index);
+    }
+}
+
+// Function to allocate host memory of the engine
+static void* engineAlloc(const size_t size) {
+    void* memory = malloc(size > 0 ? size : 1);
+    if (memory == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the OpenCL engine.\n");
+        exit(EXIT_FAILURE);
+    }
+    return memory;
+}
+
+// Function to create the buffers, the kernel arguments and the host state of the bucket strategy
+static void createBucketState(OpenCLEngine *engine, const cl_mem_flags state_flags, const float max_weight) {
+    const int vertices = engine->vertices;
+    const float delta = engine->delta;
+    cl_context context = engine->context;
+    cl_int cl_status;
+
+    // create the kernels
+    const char* kernel_name = engine->atomic ? "process_bucket_nodes_atomic" : "process_bucket_nodes";
+    const char* compact_name = engine->atomic ? "compact_frontier_atomic" : "compact_frontier";
+    if (engine->fixed) {
+        kernel_name = "process_bucket_nodes_fixed";
+        compact_name = "compact_frontier_fixed";
+    }
+    engine->kernel = clCreateKernel(engine->program, kernel_name, &cl_status);
+    CHECK_ERROR(cl_status, "clCreateKernel")
+    engine->compact_kernel = clCreateKernel(engine->program, compact_name, &cl_status);
+    CHECK_ERROR(cl_status, "clCreateKernel for compact_frontier")
+    const int edge_parallel = engine->atomic || engine->fixed;
+    if (edge_parallel) {
+        const char* edge_name = engine->fixed ? "process_bucket_edges_fixed" : "process_bucket_edges_atomic";
+        engine->edge_kernel = clCreateKernel(engine->program, edge_name, &cl_status);
+        CHECK_ERROR(cl_status, "clCreateKernel for the edge-parallel kernel")
+    }
+
+    // create the buffers of the phases
+    engine->bucket_nodes_buffer = clCreateBuffer(context, CL_MEM_READ_ONLY | state_flags, vertices * sizeof(int), NULL, &cl_status);
+    CHECK_ERROR(cl_status, "clCreateBuffer for bucket_nodes_buffer")
+    if (edge_parallel) {
+        engine->edge_offsets_buffer = clCreateBuffer(context, CL_MEM_READ_ONLY | state_flags, vertices * sizeof(int), NULL, &cl_status);
+        CHECK_ERROR(cl_status, "clCreateBuffer for edge_offsets_buffer")
+    }
+    engine->queued_buffer = clCreateBuffer(context, CL_MEM_READ_WRITE, vertices * sizeof(int), NULL, &cl_status);
+    CHECK_ERROR(cl_status, "clCreateBuffer for queued_buffer")
+    engine->frontier_buffer = clCreateBuffer(context, CL_MEM_READ_WRITE | state_flags, 2 * vertices * sizeof(int), NULL, &cl_status);
+    CHECK_ERROR(cl_status, "clCreateBuffer for frontier_buffer")
+    engine->frontier_size_buffer = clCreateBuffer(context, CL_MEM_READ_WRITE | state_flags, sizeof(int), NULL, &cl_status);
+    CHECK_ERROR(cl_status, "clCreateBuffer for frontier_size_buffer")
+
+    // no node is in the frontier yet, the compaction kernel clears the marks again after every kernel run
+    const int not_queued = 0;
+    cl_status = clEnqueueFillBuffer(engine->queue, engine->queued_buffer, &not_queued, sizeof(int), 0, vertices * sizeof(int), 0, NULL, NULL);
+    CHECK_ERROR(cl_status, "clEnqueueFillBuffer for queued_buffer")
+
+    // set the kernel arguments, only the plain kernel has a separate prev argument
+    cl_kernel kernel = engine->kernel;
+    cl_uint arg = 0;
+    cl_status = clSetKernelArg(kernel, arg++, sizeof(cl_mem), &engine->dist_buffer);
+    CHECK_ERROR(cl_status, "clSetKernelArg for dist_buffer")
+    if (!engine->atomic && !engine->fixed) {
+        cl_status = clSetKernelArg(kernel, arg++, sizeof(cl_mem), &engine->prev_buffer);
+        CHECK_ERROR(cl_status, "clSetKernelArg for prev_buffer")
+    }
+    cl_status = clSetKernelArg(kernel, arg++, sizeof(cl_mem), &engine->edges_start_buffer);
+    CHECK_ERROR(cl_status, "clSetKernelArg for edges_start_buffer")
+    cl_status = clSetKernelArg(kernel, arg++, sizeof(cl_mem), &engine->light_end_buffer);
+    CHECK_ERROR(cl_status, "clSetKernelArg for light_end_buffer")
+    cl_status = clSetKernelArg(kernel, arg++, sizeof(cl_mem), &engine->edge_destinations_buffer);
+    CHECK_ERROR(cl_status, "clSetKernelArg for edge_destinations_buffer")
+    cl_status = clSetKernelArg(kernel, arg++, sizeof(cl_mem), &engine->edge_weights_buffer);
+    CHECK_ERROR(cl_status, "clSetKernelArg for edge_weights_buffer")
+    cl_status = clSetKernelArg(kernel, arg++, sizeof(cl_mem), &engine->bucket_nodes_buffer);
+    CHECK_ERROR(cl_status, "clSetKernelArg for bucket_nodes_buffer")
+    cl_status = clSetKernelArg(kernel, arg++, sizeof(cl_mem), &engine->queued_buffer);
+    CHECK_ERROR(cl_status, "clSetKernelArg for queued_buffer")
+    cl_status = clSetKernelArg(kernel, arg++, sizeof(cl_mem), &engine->frontier_buffer);
+    CHECK_ERROR(cl_status, "clSetKernelArg for frontier_buffer")
+    cl_status = clSetKernelArg(kernel, arg++, sizeof(cl_mem), &engine->frontier_size_buffer);
+    CHECK_ERROR(cl_status, "clSetKernelArg for frontier_size_buffer")
+    engine->heavy_arg = arg;  // set by every kernel run
+
+    // set the arguments of the edge-parallel kernel, the bucket size and heavy are set by every kernel run
+    if (edge_parallel) {
+        cl_kernel edge_kernel = engine->edge_kernel;
+        cl_status = clSetKernelArg(edge_kernel, 0, sizeof(cl_mem), &engine->dist_buffer);
+        CHECK_ERROR(cl_status, "clSetKernelArg for edge dist_buffer")
+        cl_status = clSetKernelArg(edge_kernel, 1, sizeof(cl_mem), &engine->edges_start_buffer);
+        CHECK_ERROR(cl_status, "clSetKernelArg for edge edges_start_buffer")
+        cl_status = clSetKernelArg(edge_kernel, 2, sizeof(cl_mem), &engine->light_end_buffer);
+        CHECK_ERROR(cl_status, "clSetKernelArg for edge light_end_buffer")
+        cl_status = clSetKernelArg(edge_kernel, 3, sizeof(cl_mem), &engine->edge_destinations_buffer);
+        CHECK_ERROR(cl_status, "clSetKernelArg for edge edge_destinations_buffer")
+        cl_status = clSetKernelArg(edge_kernel, 4, sizeof(cl_mem), &engine->edge_weights_buffer);
+        CHECK_ERROR(cl_status, "clSetKernelArg for edge edge_weights_buffer")
+        cl_status = clSetKernelArg(edge_kernel, 5, sizeof(cl_mem), &engine->bucket_nodes_buffer);
+        CHECK_ERROR(cl_status, "clSetKernelArg for edge bucket_nodes_buffer")
+        cl_status = clSetKernelArg(edge_kernel, 6, sizeof(cl_mem), &engine->edge_offsets_buffer);
+        CHECK_ERROR(cl_status, "clSetKernelArg for edge_offsets_buffer")
+        cl_status = clSetKernelArg(edge_kernel, 7, sizeof(cl_mem), &engine->queued_buffer);
+        CHECK_ERROR(cl_status, "clSetKernelArg for edge queued_buffer")
+        cl_status = clSetKernelArg(edge_kernel, 8, sizeof(cl_mem), &engine->frontier_buffer);
+        CHECK_ERROR(cl_status, "clSetKernelArg for edge frontier_buffer")
+        cl_status = clSetKernelArg(edge_kernel, 9, sizeof(cl_mem), &engine->frontier_size_buffer);
+        CHECK_ERROR(cl_status, "clSetKernelArg for edge frontier_size_buffer")
+    }
+
+    // set the arguments of the compaction kernel
+    cl_status = clSetKernelArg(engine->compact_kernel, 0, sizeof(cl_mem), &engine->dist_buffer);
+    CHECK_ERROR(cl_status, "clSetKernelArg for compact dist_buffer")
+    cl_status = clSetKernelArg(engine->compact_kernel, 1, sizeof(cl_mem), &engine->queued_buffer);
+    CHECK_ERROR(cl_status, "clSetKernelArg for compact queued_buffer")
+    cl_status = clSetKernelArg(engine->compact_kernel, 2, sizeof(cl_mem), &engine->frontier_buffer);
+    CHECK_ERROR(cl_status, "clSetKernelArg for compact frontier_buffer")
+    if (engine->fixed) {
+        cl_status = clSetKernelArg(engine->compact_kernel, 3, sizeof(cl_uint), &engine->fixed_delta);
+    } else {
+        cl_status = clSetKernelArg(engine->compact_kernel, 3, sizeof(float), &delta);
+    }
+    CHECK_ERROR(cl_status, "clSetKernelArg for compact delta")
+
+    // Create the cyclic buckets, no edge reaches further than max_weight / delta buckets ahead
+    if (engine->fixed) {
+        initializeBuckets(&engine->buckets, vertices, (float) to_fixed_distance(max_weight), (float) engine->fixed_delta);
+    } else {
+        initializeBuckets(&engine->buckets, vertices, max_weight, delta);
+    }
+
+    // allocate the host state of the queries
+    engine->frontier = engine->zero_copy ? NULL : engineAlloc(2 * (size_t) vertices * sizeof(int));
+    engine->settled = engineAlloc(vertices * sizeof(char));
+    engine->phase_nodes = engineAlloc(vertices * sizeof(int));
+    engine->settled_nodes = engineAlloc(vertices * sizeof(int));
+    engine->edge_offsets = edge_parallel ? engineAlloc(vertices * sizeof(int)) : NULL;
+}
+
+// Function to create the buffers and the kernel arguments of the Near-Far strategy. A node is appended to a near
+// list or a far pile at most once, so every list fits into a buffer of one entry per node.
+static void createNearFarState(OpenCLEngine *engine, const cl_mem_flags state_flags) {
+    const int vertices = engine->vertices;
+    cl_context context = engine->context;
+    cl_int cl_status;
+
+    // create the kernels
+    engine->kernel = clCreateKernel(engine->program, "near_far_relax", &cl_status);
+    CHECK_ERROR(cl_status, "clCreateKernel for near_far_relax")
+    engine->split_kernel = clCreateKernel(engine->program, "near_far_split", &cl_status);
+    CHECK_ERROR(cl_status, "clCreateKernel for near_far_split")
+
+    // create the buffers of the lists, the host only writes the start node and reads the counts
+    for (int i = 0; i < 2; i++) {
+        engine->near_buffers[i] = clCreateBuffer(context, CL_MEM_READ_WRITE | state_flags, vertices * sizeof(int), NULL, &cl_status);
+        CHECK_ERROR(cl_status, "clCreateBuffer for near_buffer")
+        engine->far_buffers[i] = clCreateBuffer(context, CL_MEM_READ_WRITE, vertices * sizeof(int), NULL, &cl_status);
+        CHECK_ERROR(cl_status, "clCreateBuffer for far_buffer")
+    }
+    engine->near_stamp_buffer = clCreateBuffer(context, CL_MEM_READ_WRITE, vertices * sizeof(int), NULL, &cl_status);
+    CHECK_ERROR(cl_status, "clCreateBuffer for near_stamp_buffer")
+    engine->far_stamp_buffer = clCreateBuffer(context, CL_MEM_READ_WRITE, vertices * sizeof(int), NULL, &cl_status);
+    CHECK_ERROR(cl_status, "clCreateBuffer for far_stamp_buffer")
+    engine->counts_buffer = clCreateBuffer(context, CL_MEM_READ_WRITE | state_flags, 3 * sizeof(int), NULL, &cl_status);
+    CHECK_ERROR(cl_status, "clCreateBuffer for counts_buffer")
+
+    // set the arguments that stay the same, the lists, the threshold and the stamps are set by every step
+    cl_kernel kernel = engine->kernel;
+    cl_status = clSetKernelArg(kernel, 0, sizeof(cl_mem), &engine->dist_buffer);
+    CHECK_ERROR(cl_status, "clSetKernelArg for dist_buffer")
+    cl_status = clSetKernelArg(kernel, 1, sizeof(cl_mem), &engine->edges_start_buffer);
+    CHECK_ERROR(cl_status, "clSetKernelArg for edges_start_buffer")
+    cl_status = clSetKernelArg(kernel, 2, sizeof(cl_mem), &engine->edge_destinations_buffer);
+    CHECK_ERROR(cl_status, "clSetKernelArg for edge_destinations_buffer")
+    cl_status = clSetKernelArg(kernel, 3, sizeof(cl_mem), &engine->edge_weights_buffer);
+    CHECK_ERROR(cl_status, "clSetKernelArg for edge_weights_buffer")
+    cl_status = clSetKernelArg(kernel, 7, sizeof(cl_mem), &engine->counts_buffer);
+    CHECK_ERROR(cl_status, "clSetKernelArg for counts_buffer")
+    cl_status = clSetKernelArg(kernel, 8, sizeof(cl_mem), &engine->near_stamp_buffer);
+    CHECK_ERROR(cl_status, "clSetKernelArg for near_stamp_buffer")
+    cl_status = clSetKernelArg(kernel, 9, sizeof(cl_mem), &engine->far_stamp_buffer);
+    CHECK_ERROR(cl_status, "clSetKernelArg for far_stamp_buffer")
+
+    cl_kernel split_kernel = engine->split_kernel;
+    cl_status = clSetKernelArg(split_kernel, 0, sizeof(cl_mem), &engine->dist_buffer);
+    CHECK_ERROR(cl_status, "clSetKernelArg for split dist_buffer")
+    cl_status = clSetKernelArg(split_kernel, 4, sizeof(cl_mem), &engine->counts_buffer);
+    CHECK_ERROR(cl_status, "clSetKernelArg for split counts_buffer")
+    cl_status = clSetKernelArg(split_kernel, 5, sizeof(cl_mem), &engine->near_stamp_buffer);
+    CHECK_ERROR(cl_status, "clSetKernelArg for split near_stamp_buffer")
+    cl_status = clSetKernelArg(split_kernel, 6, sizeof(cl_mem), &engine->far_stamp_buffer);
+    CHECK_ERROR(cl_status, "clSetKernelArg for split far_stamp_buffer")
+}
+
+// Function to create the engine for the selected device: build the program, create the buffers and upload the graph.
+// The atomic kernel is replaced by the plain one if the device has no 64-bit atomics, and Near-Far, which needs
+// the atomic labels, by the buckets. With specialize set, the unroll factor is compiled into the kernels.
+void createEngine(
+    OpenCLEngine *engine,
+    const OpenCLDevice *device,
+    EngineStrategy strategy,
+    const EngineRelaxation relaxation,
+    const int specialize,
+    const int vertices,
+    const int edge_count,
+    const int* edges_start,
+    const int* light_end,
+    const int* edge_destinations,
+    const float* edge_weights,
+    const float delta,
+    const float max_weight) {
+
+    // Variable to check the output of the opencl API calls
+    cl_int cl_status;
+
+    // fall back to the plain kernel if the device has no 64-bit atomics
+    int atomic = relaxation == RELAXATION_ATOMIC;
+    const int fixed = relaxation == RELAXATION_FIXED;
+    if (atomic && !supportsAtomicLabels(device->device)) {
+        fprintf(stderr, "The device does not support cl_khr_int64_base_atomics, using the plain relaxation\n");
+        atomic = 0;
+    }
+    if (strategy == STRATEGY_NEAR_FAR && !atomic) {
+        fprintf(stderr, "Near-Far needs the atomic relaxation, using the buckets instead\n");
+        strategy = STRATEGY_BUCKETS;
+    }
+    memset(engine, 0, sizeof(OpenCLEngine));
+    engine->vertices = vertices;
+    engine->edge_count = edge_count;
+    engine->delta = delta;
+    engine->strategy = strategy;
+    engine->atomic = atomic;
+    engine->fixed = fixed;
+    engine->specialized = specialize;
+    engine->fixed_delta = fixed ? to_fixed_distance(delta) : 0;
+    engine->graph_edges_start = edges_start;
+    engine->graph_light_end = light_end;
+
+    // CPU devices and integrated GPUs share their memory with the host, copies to them only duplicate the data
+    cl_bool unified_memory = CL_FALSE;
+    clGetDeviceInfo(device->device, CL_DEVICE_HOST_UNIFIED_MEMORY, sizeof(cl_bool), &unified_memory, NULL);
+    engine->zero_copy = unified_memory == CL_TRUE;
+
+    // create the OpenCL context for the selected device
+    engine->context = clCreateContext(NULL, 1, &device->device, NULL, NULL, &cl_status);
+    CHECK_ERROR(cl_status, "clCreateContext")
+    cl_context context = engine->context;
+
+    // create the command queue
+    engine->queue = clCreateCommandQueue(context, device->device, 0, &cl_status);
+    CHECK_ERROR(cl_status, "clCreateCommandQueue")
+    cl_command_queue queue = engine->queue;
+
+    // build the program, or load its binary if it was already compiled for this device
+    const char* program_source = atomic ? atomic_kernel_source : kernel_source;
+    if (fixed) {
+        program_source = fixed_kernel_source;
+    }
+    if (strategy == STRATEGY_NEAR_FAR) {
+        program_source = near_far_kernel_source;
+    }
+
+    // a specialized build unrolls the relaxation loops. Delta stays a kernel argument, since it is chosen per graph and
+    // the options are part of the cache key, so every kernel source keeps one binary per device and build.
+    char build_options[64];
+    snprintf(build_options, sizeof(build_options), "-D RELAX_UNROLL=%d", KERNEL_UNROLL);
+    engine->program = buildProgram(context, device->device, program_source, specialize ? build_options : NULL, &engine->program_cached);
+
+    // the kernels read the end of the edges of a node from the start of the next one, so the device copy of
+    // edges_start ends with edge_count and no work item has to check for the last node
+    engine->device_edges_start = engineAlloc((vertices + 1) * sizeof(int));
+    memcpy(engine->device_edges_start, edges_start, vertices * sizeof(int));
+    engine->device_edges_start[vertices] = edge_count;
+
+    // the fixed-point kernels read the weights in millimetres, which the engine keeps for zero-copy devices
+    if (fixed) {
+        engine->fixed_weights = engineAlloc(edge_count * sizeof(cl_uint));
+        engine->fixed_dist = engineAlloc(vertices * sizeof(cl_uint));
+        convert_to_fixed_weights(edge_count, edge_weights, engine->fixed_weights);
+    }
+    const void* weights = fixed ? (const void*) engine->fixed_weights : (const void*) edge_weights;
+
+    // create buffers for device data, the labels of the atomic kernel replace dist and prev.
+    // On zero-copy devices the kernels read the graph arrays in place, and the other buffers are allocated in
+    // host-visible memory, so the host can map them instead of copying them.
+    const cl_mem_flags graph_flags = CL_MEM_READ_ONLY | (engine->zero_copy ? CL_MEM_USE_HOST_PTR : 0);
+    const cl_mem_flags state_flags = engine->zero_copy ? CL_MEM_ALLOC_HOST_PTR : 0;
+    engine->dist_buffer = clCreateBuffer(context, CL_MEM_READ_WRITE | state_flags, vertices * (atomic ? sizeof(cl_ulong) : sizeof(float)), NULL, &cl_status);
+    CHECK_ERROR(cl_status, "clCreateBuffer for dist_buffer")
+    if (!atomic) {
+        engine->prev_buffer = clCreateBuffer(context, CL_MEM_READ_WRITE | state_flags, vertices * sizeof(int), NULL, &cl_status);
+        CHECK_ERROR(cl_status, "clCreateBuffer for prev_buffer")
+    }
+    engine->edges_start_buffer = clCreateBuffer(context, graph_flags, (vertices + 1) * sizeof(int), engine->zero_copy ? engine->device_edges_start : NULL, &cl_status);
+    CHECK_ERROR(cl_status, "clCreateBuffer for edges_start_buffer")
+    engine->light_end_buffer = clCreateBuffer(context, graph_flags, vertices * sizeof(int), engine->zero_copy ? (void*) light_end : NULL, &cl_status);
+    CHECK_ERROR(cl_status, "clCreateBuffer for light_end_buffer")
+    engine->edge_destinations_buffer = clCreateBuffer(context, graph_flags, edge_count * sizeof(int), engine->zero_copy ? (void*) edge_destinations : NULL, &cl_status);
+    CHECK_ERROR(cl_status, "clCreateBuffer for edge_destinations_buffer")
+    engine->edge_weights_buffer = clCreateBuffer(context, graph_flags, edge_count * sizeof(float), engine->zero_copy ? (void*) weights : NULL, &cl_status);
+    CHECK_ERROR(cl_status, "clCreateBuffer for edge_weights_buffer")
+
+    // copy the graph to the buffers, it stays on the device for all queries
+    if (!engine->zero_copy) {
+        cl_status = clEnqueueWriteBuffer(queue, engine->edges_start_buffer, CL_TRUE, 0, (vertices + 1) * sizeof(int), engine->device_edges_start, 0, NULL, NULL);
+        CHECK_ERROR(cl_status, "clEnqueueWriteBuffer for edges_start_buffer")
+        cl_status = clEnqueueWriteBuffer(queue, engine->light_end_buffer, CL_TRUE, 0, vertices * sizeof(int), light_end, 0, NULL, NULL);
+        CHECK_ERROR(cl_status, "clEnqueueWriteBuffer for light_end_buffer")
+        cl_status = clEnqueueWriteBuffer(queue, engine->edge_destinations_buffer, CL_TRUE, 0, edge_count * sizeof(int), edge_destinations, 0, NULL, NULL);
+        CHECK_ERROR(cl_status, "clEnqueueWriteBuffer for edge_destinations_buffer")
+        cl_status = clEnqueueWriteBuffer(queue, engine->edge_weights_buffer, CL_TRUE, 0, edge_count * sizeof(float), weights, 0, NULL, NULL);
+        CHECK_ERROR(cl_status, "clEnqueueWriteBuffer for edge_weights_buffer")
+    }
+
+    // create the kernels and the buffers of the strategy
+    if (strategy == STRATEGY_NEAR_FAR) {
+        createNearFarState(engine, state_flags);
+    } else {
+        createBucketState(engine, state_flags, max_weight);
+    }
+    engine->labels = atomic && !engine->zero_copy ? engineAlloc(vertices * sizeof(cl_ulong)) : NULL;
+
+    // the previous nodes of the fixed-point distances are found by one more kernel after the search
+    if (fixed) {
+        engine->predecessor_kernel = clCreateKernel(engine->program, "fixed_predecessors", &cl_status);
+        CHECK_ERROR(cl_status, "clCreateKernel for fixed_predecessors")
+        cl_kernel kernel = engine->predecessor_kernel;
+        cl_status = clSetKernelArg(kernel, 0, sizeof(cl_mem), &engine->dist_buffer);
+        CHECK_ERROR(cl_status, "clSetKernelArg for predecessor dist_buffer")
+        cl_status = clSetKernelArg(kernel, 1, sizeof(cl_mem), &engine->prev_buffer);
+        CHECK_ERROR(cl_status, "clSetKernelArg for predecessor prev_buffer")
+        cl_status = clSetKernelArg(kernel, 2, sizeof(cl_mem), &engine->edges_start_buffer);
+        CHECK_ERROR(cl_status, "clSetKernelArg for predecessor edges_start_buffer")
+        cl_status = clSetKernelArg(kernel, 3, sizeof(cl_mem), &engine->edge_destinations_buffer);
+        CHECK_ERROR(cl_status, "clSetKernelArg for predecessor edge_destinations_buffer")
+        cl_status = clSetKernelArg(kernel, 4, sizeof(cl_mem), &engine->edge_weights_buffer);
+        CHECK_ERROR(cl_status, "clSetKernelArg for predecessor edge_weights_buffer")
+    }
+}
+
+// Function to run the Delta-Stepping with the buckets on the host, every phase is handed to the kernels
+static void runBuckets(OpenCLEngine *engine, const int start_index, const int dest_index, const float limit) {
+    const int vertices = engine->vertices;
+
+    // the fixed-point distances and their buckets count millimetres
+    const double delta = engine->fixed ? engine->fixed_delta : engine->delta;
+    const double bound = engine->fixed ? (double) limit * FIXED_SCALE : limit;
+
+    // reset the host state
+    BucketsArray* bucketsArray = &engine->buckets;
+    resetBuckets(bucketsArray, vertices);
+    engine->edge_parallel_phases = 0;
+    memset(engine->settled, 0, vertices * sizeof(char));
+    int* phase_nodes = engine->phase_nodes;
+    int* settled_nodes = engine->settled_nodes;
+
+    // Add the start node to the first bucket
+    addNodeToBucket(bucketsArray, 0, start_index);
+
+    // distance of the destination node, read back from the device after every kernel run
+    double dest_dist = INF;
+
+    // run a loop over every bucket
+    int bucket_id = 0;
+    while (bucket_id != -1) {
+        // Stop once the destination is settled or the limit is passed,
+        // every node left has a distance of at least bucket_id * delta
+        if (dest_dist <= bucket_id * delta || bucket_id * delta > bound) {
+            break;
+        }
+
+        // Relax the light edges in phases until no node is added to the current bucket anymore
+        int settled_count = 0;
+        int phase_size;
+        while ((phase_size = takeBucketNodes(bucketsArray, phase_nodes)) > 0) {
+            // nodes can be relaxed in several phases, but they are settled only once
+            for (int i = 0; i < phase_size; i++) {
+                if (!engine->settled[phase_nodes[i]]) {
+                    engine->settled[phase_nodes[i]] = 1;
+                    settled_nodes[settled_count++] = phase_nodes[i];
+                }
+            }
+
+            runBucketKernel(engine, phase_nodes, phase_size, 0, dest_index, &dest_dist);
+        }
+
+        // Relax the heavy edges of the settled nodes once, they only lead to later buckets
+        runBucketKernel(engine, settled_nodes, settled_count, 1, dest_index, &dest_dist);
+
+        bucket_id = nextBucket(bucketsArray);
+    }
+}
+
+// Function to run Near-Far on the device. Every step relaxes all edges of the near list, the nodes it improves
+// below the threshold form the next near list and the others are put on the far pile. Once the near list is empty,
+// every node closer than the threshold is settled, the threshold moves on by delta and the far pile is split into
+// the next near list and a new far pile. The lists never leave the device, the host only reads their sizes.
+static void runNearFar(OpenCLEngine *engine, const int start_index, const int dest_index, const float limit) {
+    const int vertices = engine->vertices;
+    cl_command_queue queue = engine->queue;
+    cl_int cl_status;
+
+    // no node was appended in any step or phase yet, they are counted from 1
+    const int not_appended = 0;
+    cl_status = clEnqueueFillBuffer(queue, engine->near_stamp_buffer, &not_appended, sizeof(int), 0, vertices * sizeof(int), 0, NULL, NULL);
+    CHECK_ERROR(cl_status, "clEnqueueFillBuffer for near_stamp_buffer")
+    cl_status = clEnqueueFillBuffer(queue, engine->far_stamp_buffer, &not_appended, sizeof(int), 0, vertices * sizeof(int), 0, NULL, NULL);
+    CHECK_ERROR(cl_status, "clEnqueueFillBuffer for far_stamp_buffer")
+
+    // the start node forms the first near list, and the far pile is empty
+    int counts[3] = {0, 0, INT_MAX};  // near list size, far pile size and bits of the closest far distance
+    writeBuffer(engine, engine->near_buffers[0], 0, sizeof(int), &start_index, "writing near_buffer");
+    writeBuffer(engine, engine->counts_buffer, 0, 3 * sizeof(int), counts, "writing counts_buffer");
+    int near = 0;  // index of the buffer that holds the current near list
+    int far = 0;  // index of the buffer that holds the current far pile
+    int near_size = 1;
+    int far_size = 0;
+    int step = 0;
+    int phase = 1;
+    float settled_below = 0;
+    float threshold = engine->delta;
+
+    while (1) {
+        // relax the near list until no node below the threshold improves anymore
+        while (near_size > 0) {
+            step++;
+            counts[0] = 0;
+            writeBuffer(engine, engine->counts_buffer, 0, sizeof(int), &counts[0], "writing counts_buffer");
+
+            cl_kernel kernel = engine->kernel;
+            cl_status = clSetKernelArg(kernel, 4, sizeof(cl_mem), &engine->near_buffers[near]);
+            CHECK_ERROR(cl_status, "clSetKernelArg for near_in")
+            cl_status = clSetKernelArg(kernel, 5, sizeof(cl_mem), &engine->near_buffers[1 - near]);
+            CHECK_ERROR(cl_status, "clSetKernelArg for near_out")
+            cl_status = clSetKernelArg(kernel, 6, sizeof(cl_mem), &engine->far_buffers[far]);
+            CHECK_ERROR(cl_status, "clSetKernelArg for far_pile")
+            cl_status = clSetKernelArg(kernel, 10, sizeof(float), &threshold);
+            CHECK_ERROR(cl_status, "clSetKernelArg for threshold")
+            cl_status = clSetKernelArg(kernel, 11, sizeof(int), &step);
+            CHECK_ERROR(cl_status, "clSetKernelArg for step")
+            cl_status = clSetKernelArg(kernel, 12, sizeof(int), &phase);
+            CHECK_ERROR(cl_status, "clSetKernelArg for phase")
+
+            size_t globalWorkSize[1] = {near_size};
+            cl_status = clEnqueueNDRangeKernel(queue, kernel, 1, NULL, globalWorkSize, NULL, 0, NULL, NULL);
+            CHECK_ERROR(cl_status, "clEnqueueNDRangeKernel for near_far_relax")
+
+            // get back the sizes of the next near list and the far pile, the read waits for the kernel
+            readBuffer(engine, engine->counts_buffer, 0, 2 * sizeof(int), counts, "reading counts");
+            near_size = counts[0];
+            far_size = counts[1];
+            near = 1 - near;
+        }
+
+        // every node closer than the threshold is settled now, stop once the destination is one of them
+        // or the threshold has passed the limit
+        if (far_size == 0 || threshold > limit || (dest_index != -1 && readDestDistance(engine, dest_index) < threshold)) {
+            break;
+        }
+
+        // move the threshold on, past the closest far node if the last split left the near list empty
+        step++;
+        phase++;
+        settled_below = threshold;
+        threshold += engine->delta;
+        if (counts[2] != INT_MAX) {
+            float closest_far;
+            memcpy(&closest_far, &counts[2], sizeof(closest_far));
+            if (closest_far + engine->delta > threshold) {
+                threshold = closest_far + engine->delta;
+            }
+        }
+
+        // split the far pile into the next near list and a new far pile
+        counts[0] = 0;
+        counts[1] = 0;
+        counts[2] = INT_MAX;
+        writeBuffer(engine, engine->counts_buffer, 0, 3 * sizeof(int), counts, "writing counts_buffer");
+
+        cl_kernel split_kernel = engine->split_kernel;
+        cl_status = clSetKernelArg(split_kernel, 1, sizeof(cl_mem), &engine->far_buffers[far]);
+        CHECK_ERROR(cl_status, "clSetKernelArg for far_in")
+        cl_status = clSetKernelArg(split_kernel, 2, sizeof(cl_mem), &engine->near_buffers[near]);
+        CHECK_ERROR(cl_status, "clSetKernelArg for split near_out")
+        cl_status = clSetKernelArg(split_kernel, 3, sizeof(cl_mem), &engine->far_buffers[1 - far]);
+        CHECK_ERROR(cl_status, "clSetKernelArg for far_out")
+        cl_status = clSetKernelArg(split_kernel, 7, sizeof(float), &settled_below);
+        CHECK_ERROR(cl_status, "clSetKernelArg for settled_below")
+        cl_status = clSetKernelArg(split_kernel, 8, sizeof(float), &threshold);
+        CHECK_ERROR(cl_status, "clSetKernelArg for split threshold")
+        cl_status = clSetKernelArg(split_kernel, 9, sizeof(int), &step);
+        CHECK_ERROR(cl_status, "clSetKernelArg for split step")
+        cl_status = clSetKernelArg(split_kernel, 10, sizeof(int), &phase);
+        CHECK_ERROR(cl_status, "clSetKernelArg for split phase")
+
+        size_t farWorkSize[1] = {far_size};
+        cl_status = clEnqueueNDRangeKernel(queue, split_kernel, 1, NULL, farWorkSize, NULL, 0, NULL, NULL);
+        CHECK_ERROR(cl_status, "clEnqueueNDRangeKernel for near_far_split")
+
+        readBuffer(engine, engine->counts_buffer, 0, 3 * sizeof(int), counts, "reading counts");
+        near_size = counts[0];
+        far_size = counts[1];
+        far = 1 - far;
+
+        // the closest far distance only holds if no step appends to the pile before the next split
+        if (near_size > 0) {
+            counts[2] = INT_MAX;
+        }
+    }
+}
+
+// Function to calculate the shortest paths from start_index and read back dist and prev. The search stops once
+// dest_index is settled or every node up to limit is, nodes further away may keep a distance that is too long.
+static void runQuery(
+    OpenCLEngine *engine,
+    const int start_index,
+    const int dest_index,
+    const float limit,
+    float* dist,
+    int* prev) {
+    const int vertices = engine->vertices;
+    cl_command_queue queue = engine->queue;
+    cl_int cl_status;
+
+    // reset the distances on the device, all nodes are infinitely far away and have no previous node
+    // except the start node, which has a distance of 0
+    if (engine->fixed) {
+        const cl_uint unreached = FIXED_INF;
+        const cl_uint start_dist = 0;
+        cl_status = clEnqueueFillBuffer(queue, engine->dist_buffer, &unreached, sizeof(cl_uint), 0, vertices * sizeof(cl_uint), 0, NULL, NULL);
+        CHECK_ERROR(cl_status, "clEnqueueFillBuffer for dist_buffer")
+        writeBuffer(engine, engine->dist_buffer, start_index * sizeof(cl_uint), sizeof(cl_uint), &start_dist, "writing dist_buffer");
+    } else if (engine->atomic) {
+        const cl_ulong unreached = packLabel(INF, -1);
+        const cl_ulong start_label = packLabel(0, -1);
+        cl_status = clEnqueueFillBuffer(queue, engine->dist_buffer, &unreached, sizeof(cl_ulong), 0, vertices * sizeof(cl_ulong), 0, NULL, NULL);
+        CHECK_ERROR(cl_status, "clEnqueueFillBuffer for dist_buffer")
+        writeBuffer(engine, engine->dist_buffer, start_index * sizeof(cl_ulong), sizeof(cl_ulong), &start_label, "writing dist_buffer");
+    } else {
+        const float unreached = INF;
+        const int no_previous = -1;
+        const float start_dist = 0;
+        cl_status = clEnqueueFillBuffer(queue, engine->dist_buffer, &unreached, sizeof(float), 0, vertices * sizeof(float), 0, NULL, NULL);
+        CHECK_ERROR(cl_status, "clEnqueueFillBuffer for dist_buffer")
+        cl_status = clEnqueueFillBuffer(queue, engine->prev_buffer, &no_previous, sizeof(int), 0, vertices * sizeof(int), 0, NULL, NULL);
+        CHECK_ERROR(cl_status, "clEnqueueFillBuffer for prev_buffer")
+        writeBuffer(engine, engine->dist_buffer, start_index * sizeof(float), sizeof(float), &start_dist, "writing dist_buffer");
+    }
+
+    // run the search with the strategy of the engine
+    if (engine->strategy == STRATEGY_NEAR_FAR) {
+        runNearFar(engine, start_index, dest_index, limit);
+    } else {
+        runBuckets(engine, start_index, dest_index, limit);
+    }
+
+    // get the calculated distance and previous arrays
+    if (engine->fixed) {
+        // find the previous nodes on the device
+        const int no_previous = -1;
+        cl_status = clEnqueueFillBuffer(queue, engine->prev_buffer, &no_previous, sizeof(int), 0, vertices * sizeof(int), 0, NULL, NULL);
+        CHECK_ERROR(cl_status, "clEnqueueFillBuffer for prev_buffer")
+        size_t globalWorkSize[1] = {vertices};
+        cl_status = clEnqueueNDRangeKernel(queue, engine->predecessor_kernel, 1, NULL, globalWorkSize, NULL, 0, NULL, NULL);
+        CHECK_ERROR(cl_status, "clEnqueueNDRangeKernel for fixed_predecessors")
+
+        // keep the exact distances for the caller and convert them to meters
+        readBuffer(engine, engine->dist_buffer, 0, vertices * sizeof(cl_uint), engine->fixed_dist, "reading dist_buffer");
+        readBuffer(engine, engine->prev_buffer, 0, vertices * sizeof(int), prev, "reading prev_buffer");
+        for (int i = 0; i < vertices; i++) {
+            dist[i] = engine->fixed_dist[i] == FIXED_INF ? INF : (float) ((double) engine->fixed_dist[i] / FIXED_SCALE);
+        }
+    } else if (engine->atomic) {
+        // unpack the labels, on zero-copy devices directly from the mapped buffer
+        const cl_ulong* labels = engine->labels;
+        if (engine->zero_copy) {
+            labels = mapBuffer(engine, engine->dist_buffer, CL_MAP_READ, 0, vertices * sizeof(cl_ulong), "mapping dist_buffer");
+        } else {
+            readBuffer(engine, engine->dist_buffer, 0, vertices * sizeof(cl_ulong), engine->labels, "reading dist_buffer");
+        }
+        for (int i = 0; i < vertices; i++) {
+            dist[i] = labelDistance(labels[i]);
+            prev[i] = (int) (cl_uint) labels[i];
+        }
+        if (engine->zero_copy) {
+            unmapBuffer(engine, engine->dist_buffer, (void*) labels);
+        }
+    } else {
+        readBuffer(engine, engine->dist_buffer, 0, vertices * sizeof(float), dist, "reading dist_buffer");
+        readBuffer(engine, engine->prev_buffer, 0, vertices * sizeof(int), prev, "reading prev_buffer");
+    }
+}
+
+// Function to calculate the shortest paths from start_index with the engine and read back dist and prev.
+// The search stops once dest_index is settled, pass -1 to calculate the distances to all nodes.
+void runEngineQuery(OpenCLEngine *engine, const int start_index, const int dest_index, float* dist, int* prev) {
+    runQuery(engine, start_index, dest_index, INF, dist, prev);
+}
+
+// Function to calculate the distances from start_index up to limit with the engine, the buckets or thresholds beyond
+// it are not processed. Only distances up to limit are final.
+void runEngineBoundedQuery(OpenCLEngine *engine, const int start_index, const float limit, float* dist, int* prev) {
+    runQuery(engine, start_index, -1, limit, dist, prev);
+}
+
+// Function to release a buffer the strategy of the engine may not have created
+static void releaseBuffer(cl_mem buffer) {
+    if (buffer != NULL) {
+        clReleaseMemObject(buffer);
+    }
+}
+
+// Function to release the OpenCL objects and the memory of the engine
+void freeEngine(OpenCLEngine *engine) {
+    clReleaseMemObject(engine->dist_buffer);
+    releaseBuffer(engine->prev_buffer);
+    clReleaseMemObject(engine->edges_start_buffer);
+    clReleaseMemObject(engine->edge_destinations_buffer);
+    clReleaseMemObject(engine->edge_weights_buffer);
+    clReleaseMemObject(engine->light_end_buffer);
+    releaseBuffer(engine->bucket_nodes_buffer);
+    releaseBuffer(engine->edge_offsets_buffer);
+    releaseBuffer(engine->queued_buffer);
+    releaseBuffer(engine->frontier_buffer);
+    releaseBuffer(engine->frontier_size_buffer);
+    for (int i = 0; i < 2; i++) {
+        releaseBuffer(engine->near_buffers[i]);
+        releaseBuffer(engine->far_buffers[i]);
+    }
+    releaseBuffer(engine->near_stamp_buffer);
+    releaseBuffer(engine->far_stamp_buffer);
+    releaseBuffer(engine->counts_buffer);
+    clReleaseKernel(engine->kernel);
+    if (engine->edge_kernel != NULL) {
+        clReleaseKernel(engine->edge_kernel);
+    }
+    if (engine->compact_kernel != NULL) {
+        clReleaseKernel(engine->compact_kernel);
+    }
+    if (engine->split_kernel != NULL) {
+        clReleaseKernel(engine->split_kernel);
+    }
+    if (engine->predecessor_kernel != NULL) {
+        clReleaseKernel(engine->predecessor_kernel);
+    }
+    clReleaseProgram(engine->program);
+    clReleaseCommandQueue(engine->queue);
+    clReleaseContext(engine->context);
+
+    // Free each bucket's allocated memory and the host state
+    if (engine->strategy == STRATEGY_BUCKETS) {
+        freeBuckets(&engine->buckets);
+    }
+    free(engine->frontier);
+    free(engine->settled);
+    free(engine->phase_nodes);
+    free(engine->settled_nodes);
+    free(engine->edge_offsets);
+    free(engine->labels);
+    free(engine->fixed_weights);
+    free(engine->fixed_dist);
+    free(engine->device_edges_start);
+}
@@ -0,0 +1,104 @@
+#ifndef OPENCL_ENGINE_H
+#define OPENCL_ENGINE_H
+
+#include "opencl_utils.h"  // For OpenCLDevice struct
+#include "bucket_utils.h"  // For BucketsArray struct
+
+// Strategies to process the frontier on the device
+typedef enum {
+    STRATEGY_BUCKETS,  // Delta-Stepping, the host keeps the buckets and hands every phase to the kernels
+    STRATEGY_NEAR_FAR  // Near-Far, the near list and the far pile stay on the device, the host only reads their sizes
+} EngineStrategy;
+
+// Kernels to lower the distance of a node
+typedef enum {
+    RELAXATION_PLAIN,  // float distances written without atomics, a shorter distance can get lost between work items
+    RELAXATION_ATOMIC,  // distance and previous node packed into 64-bit labels, needs cl_khr_int64_base_atomics
+    RELAXATION_FIXED  // millimetres as 32-bit integers lowered by atomic_min, the previous nodes follow after the search
+} EngineRelaxation;
+
+// Define the OpenCL engine. It uploads the graph once and keeps the context, the kernels and all
+// buffers, so any number of queries only reset the distances on the device and run the kernels.
+// The buckets read the degrees of the phase nodes from the graph arrays passed to createEngine, and on zero-copy
+// devices the kernels read these arrays in place, so they have to stay valid until freeEngine.
+typedef struct {
+    int vertices;
+    int edge_count;
+    float delta;
+    EngineStrategy strategy;
+    int atomic;  // 1 if the kernel packs distance and previous node into 64-bit labels
+    int fixed;  // 1 if the kernels use fixed-point distances in millimetres
+    int specialized;  // 1 if the unroll factor was compiled into the kernels
+    cl_uint fixed_delta;  // bucket width in millimetres, only used by the fixed-point kernels
+    int program_cached;  // 1 if the program binary was loaded from the cache
+    int zero_copy;  // 1 if the device shares its memory with the host and buffers are mapped instead of copied
+
+    // OpenCL objects
+    cl_context context;
+    cl_command_queue queue;
+    cl_program program;
+    cl_kernel kernel;
+    cl_kernel edge_kernel;  // edge-parallel relaxation, NULL for the plain kernel and Near-Far
+    cl_kernel compact_kernel;  // NULL for Near-Far
+    cl_kernel split_kernel;  // NULL for the buckets
+    cl_kernel predecessor_kernel;  // finds the previous nodes of the fixed-point distances, NULL without them
+    cl_uint heavy_arg;  // index of the kernel argument that selects the light or heavy edges
+
+    // device buffers, the graph is written once, the labels or dist and prev are reset by every query
+    cl_mem dist_buffer;
+    cl_mem prev_buffer;  // NULL for the atomic kernel
+    cl_mem edges_start_buffer;
+    cl_mem light_end_buffer;
+    cl_mem edge_destinations_buffer;
+    cl_mem edge_weights_buffer;
+
+    // device buffers of the buckets, NULL for Near-Far
+    cl_mem bucket_nodes_buffer;
+    cl_mem edge_offsets_buffer;  // index of the first edge of every bucket node for the edge-parallel kernel
+    cl_mem queued_buffer;
+    cl_mem frontier_buffer;
+    cl_mem frontier_size_buffer;
+
+    // device buffers of Near-Far, NULL for the buckets. The near lists and far piles are used in turns.
+    cl_mem near_buffers[2];
+    cl_mem far_buffers[2];
+    cl_mem near_stamp_buffer;  // the step a node was appended to a near list in last
+    cl_mem far_stamp_buffer;  // the phase a node was appended to a far pile in last
+    cl_mem counts_buffer;  // sizes of the near list and the far pile and the bits of the closest far distance
+
+    // host state of a query, allocated once, only used by the buckets
+    const int *graph_edges_start;
+    const int *graph_light_end;
+    int edge_parallel_phases;  // number of phases of the last query relaxed by the edge-parallel kernel
+    BucketsArray buckets;
+    int *frontier;  // the nodes improved by a kernel run as (node, bucket) pairs, NULL on zero-copy devices
+    char *settled;  // settled[i] is set once node i was taken out of its final bucket
+    int *phase_nodes;  // the nodes of the current phase
+    int *settled_nodes;  // the nodes settled in the current bucket
+    int *edge_offsets;  // the edge offsets of the current phase, NULL without the edge-parallel kernel
+    cl_ulong *labels;  // the labels read back from the atomic kernel, NULL for the plain kernel and zero-copy devices
+    cl_uint *fixed_weights;  // the edge weights in millimetres, NULL without the fixed-point kernels
+    cl_uint *fixed_dist;  // the distances of the last query in millimetres, NULL without the fixed-point kernels
+    int *device_edges_start;  // edges_start with edge_count appended, the copy the kernels read
+} OpenCLEngine;
+
+// Engine functions
+void createEngine(
+    OpenCLEngine *engine,
+    const OpenCLDevice *device,
+    EngineStrategy strategy,
+    EngineRelaxation relaxation,
+    const int specialize,
+    const int vertices,
+    const int edge_count,
+    const int* edges_start,
+    const int* light_end,
+    const int* edge_destinations,
+    const float* edge_weights,
+    const float delta,
+    const float max_weight);
+void runEngineQuery(OpenCLEngine *engine, const int start_index, const int dest_index, float* dist, int* prev);
+void runEngineBoundedQuery(OpenCLEngine *engine, const int start_index, const float limit, float* dist, int* prev);
+void freeEngine(OpenCLEngine *engine);
+
+#endif //OPENCL_ENGINE_H
@@ -0,0 +1,510 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <unistd.h>  // For getpid
+
+#include "opencl_utils.h"
+#include "cache_utils.h"  // Include cache path and hash functions
+#include "cli_utils.h"  // Include wallTimeMs function
+
+#define PROGRAM_FILE_MAGIC 0x42434C4F  // "OLCB"
+#define PROGRAM_FILE_VERSION 1
+#define DEVICE_FILE_MAGIC 0x56444C4F  // "OLDV"
+#define DEVICE_FILE_VERSION 1
+
+#define MAX_DEVICE_CANDIDATES 32  // Number of devices the automatic selection compares at most
+#define CALIBRATION_ITEMS (1 << 18)  // Number of work items of the calibration kernel
+#define CALIBRATION_RUNS 3  // Number of timed calibration runs, the fastest one counts
+
+static const char* calibration_kernel_source =
+"__kernel void calibrate(                                                           \n"
+"   __global const int* next,                                                       \n"
+"   __global int* result                                                            \n"
+") {                                                                                \n"
+"   // follow a chain of random indices like the relaxation follows edges           \n"
+"   int index = get_global_id(0);                                                   \n"
+"   int sum = 0;                                                                    \n"
+"   for (int step = 0; step < 16; step++) {                                         \n"
+"       index = next[index];                                                        \n"
+"       sum += index;                                                               \n"
+"   }                                                                               \n"
+"   result[get_global_id(0)] = sum;                                                 \n"
+"}";
+
+// Function to extend a hash with a text device property, like the device name or driver version
+static uint64_t hashDeviceInfo(uint64_t hash, cl_device_id device, const cl_device_info info) {
+    size_t size = 0;
+    if (clGetDeviceInfo(device, info, 0, NULL, &size) != CL_SUCCESS || size == 0) {
+        return hash;
+    }
+    char value[size];
+    if (clGetDeviceInfo(device, info, size, value, NULL) != CL_SUCCESS) {
+        return hash;
+    }
+    return hashBytes(hash, value, size);
+}
+
+// Function to identify a program binary by the device and driver that compiled it and by its source and options,
+// so an updated driver or kernel never loads a stale binary
+static uint64_t programKey(cl_device_id device, const char* source, const char* options) {
+    uint64_t hash = hashBytes(0, source, strlen(source));
+    if (options != NULL) {
+        hash = hashBytes(hash, options, strlen(options));
+    }
+    hash = hashDeviceInfo(hash, device, CL_DEVICE_NAME);
+    hash = hashDeviceInfo(hash, device, CL_DEVICE_VENDOR);
+    hash = hashDeviceInfo(hash, device, CL_DRIVER_VERSION);
+    return hash;
+}
+
+// Function to read a program binary written by saveProgramBinary, returns NULL if the file doesn't match the key
+static unsigned char* loadProgramBinary(const char* path, const uint64_t key, size_t* size) {
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        return NULL;
+    }
+
+    int header[2];
+    uint64_t file_key;
+    uint64_t binary_size;
+    if (fread(header, sizeof(int), 2, file) != 2 ||
+        fread(&file_key, sizeof(uint64_t), 1, file) != 1 ||
+        fread(&binary_size, sizeof(uint64_t), 1, file) != 1 ||
+        header[0] != PROGRAM_FILE_MAGIC || header[1] != PROGRAM_FILE_VERSION ||
+        file_key != key || binary_size == 0) {
+        fclose(file);
+        return NULL;
+    }
+
+    unsigned char* binary = malloc(binary_size);
+    if (binary == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the program binary.\n");
+        exit(EXIT_FAILURE);
+    }
+    if (fread(binary, 1, binary_size, file) != binary_size) {
+        fclose(file);
+        free(binary);
+        return NULL;
+    }
+
+    fclose(file);
+    *size = binary_size;
+    return binary;
+}
+
+// Function to write the binary of a built program to the cache. The file is written under a temporary name and
+// renamed afterwards, so a query running at the same time never reads a half written binary.
+static void saveProgramBinary(cl_program program, cl_device_id device, const char* path, const uint64_t key) {
+    // the program holds one binary for every device of its context, find the one of the device
+    cl_uint device_count = 0;
+    if (clGetProgramInfo(program, CL_PROGRAM_NUM_DEVICES, sizeof(cl_uint), &device_count, NULL) != CL_SUCCESS ||
+        device_count == 0) {
+        return;
+    }
+    cl_device_id devices[device_count];
+    size_t binary_sizes[device_count];
+    unsigned char* binaries[device_count];
+    if (clGetProgramInfo(program, CL_PROGRAM_DEVICES, sizeof(devices), devices, NULL) != CL_SUCCESS ||
+        clGetProgramInfo(program, CL_PROGRAM_BINARY_SIZES, sizeof(binary_sizes), binary_sizes, NULL) != CL_SUCCESS) {
+        return;
+    }
+    int index = -1;
+    for (cl_uint i = 0; i < device_count; i++) {
+        binaries[i] = NULL;  // binaries of the other devices are skipped
+        if (devices[i] == device) {
+            index = (int) i;
+        }
+    }
+    if (index == -1 || binary_sizes[index] == 0) {
+        return;
+    }
+
+    const size_t binary_size = binary_sizes[index];
+    unsigned char* binary = malloc(binary_size);
+    if (binary == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the program binary.\n");
+        exit(EXIT_FAILURE);
+    }
+    binaries[index] = binary;
+    if (clGetProgramInfo(program, CL_PROGRAM_BINARIES, sizeof(binaries), binaries, NULL) != CL_SUCCESS) {
+        free(binary);
+        return;
+    }
+
+    char temporary_path[1100];
+    snprintf(temporary_path, sizeof(temporary_path), "%s.%ld.tmp", path, (long) getpid());
+    FILE *file = fopen(temporary_path, "wb");
+    if (file == NULL) {
+        fprintf(stderr, "Error: Could not open %s for writing.\n", temporary_path);
+        free(binary);
+        return;
+    }
+
+    const int header[2] = {PROGRAM_FILE_MAGIC, PROGRAM_FILE_VERSION};
+    const uint64_t size = binary_size;
+    int ok = fwrite(header, sizeof(int), 2, file) == 2 &&
+             fwrite(&key, sizeof(uint64_t), 1, file) == 1 &&
+             fwrite(&size, sizeof(uint64_t), 1, file) == 1 &&
+             fwrite(binary, 1, binary_size, file) == binary_size;
+    free(binary);
+
+    ok = fclose(file) == 0 && ok;
+    if (!ok || rename(temporary_path, path) != 0) {
+        fprintf(stderr, "Error: Could not write the program binary to %s.\n", path);
+        remove(temporary_path);
+    }
+}
+
+// Function to load the program for one device from the cache or compile it and store its binary in the cache.
+// Returns NULL if the program cannot be built, the build log is kept in the program if build_log is set.
+static cl_program loadOrBuildProgram(
+        cl_context context,
+        cl_device_id device,
+        const char* source,
+        const char* options,
+        int* from_cache,
+        char** build_log) {
+    cl_int cl_status;
+    *from_cache = 0;
+
+    const uint64_t key = programKey(device, source, options);
+    char path[1024];
+    const int has_cache = getCachePath(path, sizeof(path), "program", key, "bin") == 0;
+
+    // try the cached binary first, a driver can still reject it, e.g. after an update that kept its version string
+    if (has_cache) {
+        size_t binary_size = 0;
+        unsigned char* binary = loadProgramBinary(path, key, &binary_size);
+        if (binary != NULL) {
+            cl_int binary_status;
+            cl_program program = clCreateProgramWithBinary(
+                context, 1, &device, &binary_size, (const unsigned char **) &binary, &binary_status, &cl_status);
+            free(binary);
+            if (cl_status == CL_SUCCESS && binary_status == CL_SUCCESS) {
+                if (clBuildProgram(program, 1, &device, options, NULL, NULL) == CL_SUCCESS) {
+                    *from_cache = 1;
+                    return program;
+                }
+                clReleaseProgram(program);
+            }
+            remove(path);
+        }
+    }
+
+    // compile the source
+    cl_program program = clCreateProgramWithSource(context, 1, &source, NULL, &cl_status);
+    if (cl_status != CL_SUCCESS) {
+        fprintf(stderr, "clCreateProgramWithSource failed with error code %d\n", cl_status);
+        return NULL;
+    }
+    cl_status = clBuildProgram(program, 1, &device, options, NULL, NULL);
+    if (cl_status != CL_SUCCESS) {
+        if (build_log != NULL) {
+            size_t log_size;
+            clGetProgramBuildInfo(program, device, CL_PROGRAM_BUILD_LOG, 0, NULL, &log_size);
+            *build_log = (char *)malloc(log_size);
+            clGetProgramBuildInfo(program, device, CL_PROGRAM_BUILD_LOG, log_size, *build_log, NULL);
+        }
+        clReleaseProgram(program);
+        return NULL;
+    }
+
+    if (has_cache) {
+        saveProgramBinary(program, device, path, key);
+    }
+    return program;
+}
+
+// Function to build a program for one device. The build of a program created from a binary is cheap,
+// the compilation of the source only happens if the cache has no binary for this device, driver, source and options.
+// from_cache is set to 1 if the binary was loaded from the cache.
+cl_program buildProgram(
+        cl_context context,
+        cl_device_id device,
+        const char* source,
+        const char* options,
+        int* from_cache) {
+    char* log = NULL;
+    cl_program program = loadOrBuildProgram(context, device, source, options, from_cache, &log);
+    if (program == NULL) {
+        if (log != NULL) {
+            fprintf(stderr, "Kernel build log:\n%s\n", log);
+            free(log);
+        }
+        exit(EXIT_FAILURE);
+    }
+    return program;
+}
+
+// Function to get the name of a device type as printed by OpenCL_check
+const char* deviceTypeName(const cl_device_type type) {
+    if (type & CL_DEVICE_TYPE_CPU) {
+        return "CPU";
+    }
+    if (type & CL_DEVICE_TYPE_GPU) {
+        return "GPU";
+    }
+    if (type & CL_DEVICE_TYPE_ACCELERATOR) {
+        return "Accelerator";
+    }
+    return "Unknown";
+}
+
+// Function to estimate the speed of a device from the properties OpenCL_check prints, used if the calibration fails
+static double estimatedSpeed(cl_device_id device) {
+    cl_uint compute_units = 0;
+    cl_uint clock_frequency = 0;
+    clGetDeviceInfo(device, CL_DEVICE_MAX_COMPUTE_UNITS, sizeof(cl_uint), &compute_units, NULL);
+    clGetDeviceInfo(device, CL_DEVICE_MAX_CLOCK_FREQUENCY, sizeof(cl_uint), &clock_frequency, NULL);
+    return (double) compute_units * clock_frequency;
+}
+
+// Function to time the calibration kernel on a device, returns the fastest run in ms or -1 if the device failed.
+// Every run uploads the input, launches the kernel and reads one value back, like a phase of the Delta-Stepping.
+static double calibrateDevice(cl_device_id device) {
+    cl_int cl_status;
+    cl_context context = clCreateContext(NULL, 1, &device, NULL, NULL, &cl_status);
+    if (cl_status != CL_SUCCESS) {
+        return -1;
+    }
+    cl_command_queue queue = clCreateCommandQueue(context, device, 0, &cl_status);
+    if (cl_status != CL_SUCCESS) {
+        clReleaseContext(context);
+        return -1;
+    }
+    int from_cache;
+    cl_program program = loadOrBuildProgram(context, device, calibration_kernel_source, NULL, &from_cache, NULL);
+    cl_kernel kernel = NULL;
+    if (program != NULL) {
+        kernel = clCreateKernel(program, "calibrate", &cl_status);
+    }
+
+    int* next = malloc(CALIBRATION_ITEMS * sizeof(int));
+    if (next == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the device calibration.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < CALIBRATION_ITEMS; i++) {
+        next[i] = (int) (((long) i * 7919 + 13) % CALIBRATION_ITEMS);  // a permutation, 7919 is odd
+    }
+
+    cl_mem next_buffer = clCreateBuffer(context, CL_MEM_READ_ONLY, CALIBRATION_ITEMS * sizeof(int), NULL, &cl_status);
+    cl_mem result_buffer = clCreateBuffer(context, CL_MEM_WRITE_ONLY, CALIBRATION_ITEMS * sizeof(int), NULL, &cl_status);
+    int ok = kernel != NULL && next_buffer != NULL && result_buffer != NULL &&
+             clSetKernelArg(kernel, 0, sizeof(cl_mem), &next_buffer) == CL_SUCCESS &&
+             clSetKernelArg(kernel, 1, sizeof(cl_mem), &result_buffer) == CL_SUCCESS;
+
+    double fastest = -1;
+    const size_t globalWorkSize[1] = {CALIBRATION_ITEMS};
+    for (int run = 0; ok && run < CALIBRATION_RUNS; run++) {
+        int result;
+        const double start = wallTimeMs();
+        ok = clEnqueueWriteBuffer(queue, next_buffer, CL_TRUE, 0, CALIBRATION_ITEMS * sizeof(int), next, 0, NULL, NULL) == CL_SUCCESS &&
+             clEnqueueNDRangeKernel(queue, kernel, 1, NULL, globalWorkSize, NULL, 0, NULL, NULL) == CL_SUCCESS &&
+             clEnqueueReadBuffer(queue, result_buffer, CL_TRUE, 0, sizeof(int), &result, 0, NULL, NULL) == CL_SUCCESS;
+        const double elapsed = wallTimeMs() - start;
+        if (ok && (fastest < 0 || elapsed < fastest)) {
+            fastest = elapsed;
+        }
+    }
+    if (!ok) {
+        fastest = -1;
+    }
+
+    free(next);
+    if (next_buffer != NULL) {
+        clReleaseMemObject(next_buffer);
+    }
+    if (result_buffer != NULL) {
+        clReleaseMemObject(result_buffer);
+    }
+    if (kernel != NULL) {
+        clReleaseKernel(kernel);
+    }
+    if (program != NULL) {
+        clReleaseProgram(program);
+    }
+    clReleaseCommandQueue(queue);
+    clReleaseContext(context);
+    return fastest;
+}
+
+// Function to read the device chosen by an earlier calibration of the same candidates, returns -1 if there is none
+static int loadDeviceChoice(const char* path, const uint64_t key, const int candidate_count) {
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        return -1;
+    }
+    int header[3];
+    uint64_t file_key;
+    const int ok = fread(header, sizeof(int), 3, file) == 3 &&
+                   fread(&file_key, sizeof(uint64_t), 1, file) == 1 &&
+                   header[0] == DEVICE_FILE_MAGIC && header[1] == DEVICE_FILE_VERSION &&
+                   file_key == key && header[2] >= 0 && header[2] < candidate_count;
+    fclose(file);
+    return ok ? header[2] : -1;
+}
+
+// Function to store the device chosen by the calibration, so later runs skip it
+static void saveDeviceChoice(const char* path, const uint64_t key, const int choice) {
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) {
+        return;
+    }
+    const int header[3] = {DEVICE_FILE_MAGIC, DEVICE_FILE_VERSION, choice};
+    int ok = fwrite(header, sizeof(int), 3, file) == 3 &&
+             fwrite(&key, sizeof(uint64_t), 1, file) == 1;
+    ok = fclose(file) == 0 && ok;
+    if (!ok) {
+        remove(path);
+    }
+}
+
+// Function to check if a device can run the kernels
+static int deviceUsable(cl_device_id device) {
+    cl_bool available = CL_FALSE;
+    cl_bool compiler_available = CL_FALSE;
+    clGetDeviceInfo(device, CL_DEVICE_AVAILABLE, sizeof(cl_bool), &available, NULL);
+    clGetDeviceInfo(device, CL_DEVICE_COMPILER_AVAILABLE, sizeof(cl_bool), &compiler_available, NULL);
+    return available && compiler_available;
+}
+
+// Function to fill in the description of a device
+static void describeDevice(OpenCLDevice* description, cl_platform_id platform, cl_device_id device) {
+    description->platform = platform;
+    description->device = device;
+    description->type = 0;
+    description->name[0] = '\0';
+    clGetDeviceInfo(device, CL_DEVICE_TYPE, sizeof(cl_device_type), &description->type, NULL);
+    clGetDeviceInfo(device, CL_DEVICE_NAME, sizeof(description->name), description->name, NULL);
+    description->name[sizeof(description->name) - 1] = '\0';
+}
+
+// Function to select the OpenCL device, returns -1 if no usable device matches the options.
+// platform_option is the index of a platform, all platforms are searched if it is NULL.
+// device_option is the index of a device inside the platform as listed by OpenCL_check, a device type (gpu, cpu or
+// accelerator) or auto. If several devices match, they are ranked by a short calibration run and the fastest is
+// selected. The ranking is cached, so it only runs again when the devices or drivers change.
+int selectDevice(OpenCLDevice* selected, const char* platform_option, const char* device_option) {
+    cl_device_type type = CL_DEVICE_TYPE_ALL;
+    long device_index = -1;
+    if (device_option == NULL || strcmp(device_option, "auto") == 0) {
+        type = CL_DEVICE_TYPE_ALL;
+    } else if (strcmp(device_option, "gpu") == 0) {
+        type = CL_DEVICE_TYPE_GPU;
+    } else if (strcmp(device_option, "cpu") == 0) {
+        type = CL_DEVICE_TYPE_CPU;
+    } else if (strcmp(device_option, "accelerator") == 0) {
+        type = CL_DEVICE_TYPE_ACCELERATOR;
+    } else {
+        char* end;
+        device_index = strtol(device_option, &end, 10);
+        if (end == device_option || *end != '\0' || device_index < 0) {
+            fprintf(stderr, "Unknown device '%s', use auto, gpu, cpu, accelerator or a device index\n", device_option);
+            return -1;
+        }
+    }
+
+    // get the platforms
+    cl_uint platform_count = 0;
+    if (clGetPlatformIDs(0, NULL, &platform_count) != CL_SUCCESS || platform_count == 0) {
+        fprintf(stderr, "No OpenCL platform found\n");
+        return -1;
+    }
+    cl_platform_id platforms[platform_count];
+    clGetPlatformIDs(platform_count, platforms, NULL);
+
+    cl_uint first_platform = 0;
+    cl_uint last_platform = platform_count - 1;
+    if (platform_option != NULL) {
+        char* end;
+        const long platform_index = strtol(platform_option, &end, 10);
+        if (end == platform_option || *end != '\0' || platform_index < 0 || platform_index >= platform_count) {
+            fprintf(stderr, "Unknown platform '%s', there are %u platforms\n", platform_option, platform_count);
+            return -1;
+        }
+        first_platform = last_platform = (cl_uint) platform_index;
+    } else if (device_index >= 0) {
+        last_platform = 0;  // a device index refers to the first platform unless a platform is given
+    }
+
+    // a device index selects the device directly
+    if (device_index >= 0) {
+        cl_uint device_count = 0;
+        clGetDeviceIDs(platforms[first_platform], CL_DEVICE_TYPE_ALL, 0, NULL, &device_count);
+        if (device_index >= device_count) {
+            fprintf(stderr, "Unknown device %ld, platform %u has %u devices\n", device_index, first_platform, device_count);
+            return -1;
+        }
+        cl_device_id devices[device_count];
+        clGetDeviceIDs(platforms[first_platform], CL_DEVICE_TYPE_ALL, device_count, devices, NULL);
+        describeDevice(selected, platforms[first_platform], devices[device_index]);
+        return 0;
+    }
+
+    // collect the usable devices of the requested type
+    OpenCLDevice candidates[MAX_DEVICE_CANDIDATES];
+    int candidate_count = 0;
+    for (cl_uint p = first_platform; p <= last_platform; p++) {
+        cl_uint device_count = 0;
+        if (clGetDeviceIDs(platforms[p], type, 0, NULL, &device_count) != CL_SUCCESS || device_count == 0) {
+            continue;  // platforms without a device of this type report CL_DEVICE_NOT_FOUND
+        }
+        cl_device_id devices[device_count];
+        clGetDeviceIDs(platforms[p], type, device_count, devices, NULL);
+        for (cl_uint d = 0; d < device_count && candidate_count < MAX_DEVICE_CANDIDATES; d++) {
+            if (deviceUsable(devices[d])) {
+                describeDevice(&candidates[candidate_count++], platforms[p], devices[d]);
+            }
+        }
+    }
+    if (candidate_count == 0) {
+        fprintf(stderr, "No usable OpenCL device of type %s found\n", device_option != NULL ? device_option : "auto");
+        return -1;
+    }
+    if (candidate_count == 1) {
+        *selected = candidates[0];
+        return 0;
+    }
+
+    // reuse the ranking of an earlier run if the candidates, their drivers and the calibration are the same
+    uint64_t key = hashBytes(0, calibration_kernel_source, strlen(calibration_kernel_source));
+    key = hashBytes(key, &type, sizeof(type));
+    for (int c = 0; c < candidate_count; c++) {
+        key = hashDeviceInfo(key, candidates[c].device, CL_DEVICE_NAME);
+        key = hashDeviceInfo(key, candidates[c].device, CL_DEVICE_VENDOR);
+        key = hashDeviceInfo(key, candidates[c].device, CL_DRIVER_VERSION);
+    }
+    char path[1024];
+    const int has_cache = getCachePath(path, sizeof(path), "devices", key, "bin") == 0;
+    int choice = has_cache ? loadDeviceChoice(path, key, candidate_count) : -1;
+
+    if (choice == -1) {
+        // rank the devices by the calibration, devices that fail it only count if none passes
+        double fastest = -1;
+        double best_estimate = -1;
+        int best_estimated = 0;
+        for (int c = 0; c < candidate_count; c++) {
+            const double time = calibrateDevice(candidates[c].device);
+            if (time >= 0 && (fastest < 0 || time < fastest)) {
+                fastest = time;
+                choice = c;
+            }
+            const double estimate = estimatedSpeed(candidates[c].device);
+            if (estimate > best_estimate) {
+                best_estimate = estimate;
+                best_estimated = c;
+            }
+        }
+        if (choice == -1) {
+            choice = best_estimated;
+        }
+        if (has_cache) {
+            saveDeviceChoice(path, key, choice);
+        }
+    }
+
+    *selected = candidates[choice];
+    return 0;
+}
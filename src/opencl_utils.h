@@ -0,0 +1,31 @@
+#ifndef OPENCL_UTILS_H
+#define OPENCL_UTILS_H
+
+// set OpenCL Version
+#ifndef CL_TARGET_OPENCL_VERSION
+#define CL_TARGET_OPENCL_VERSION 120
+#endif
+
+#include <CL/cl.h>
+
+// Define the OpenCL device the kernels run on
+typedef struct {
+    cl_platform_id platform;
+    cl_device_id device;
+    cl_device_type type;
+    char name[128];
+} OpenCLDevice;
+
+// Device functions
+int selectDevice(OpenCLDevice* selected, const char* platform_option, const char* device_option);
+const char* deviceTypeName(cl_device_type type);
+
+// Program functions
+cl_program buildProgram(
+    cl_context context,
+    cl_device_id device,
+    const char* source,
+    const char* options,
+    int* from_cache);
+
+#endif //OPENCL_UTILS_H
@@ -0,0 +1,184 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "output_utils.h"
+
+#define MAX_POINT_LENGTH 32  // Longest text of one route point in either format, including the separator
+#define DEFAULT_ROUTE_POINTS 256  // Points a route buffer is sized for if the caller does not know their number
+
+// The route format of all routes of the response, set once by selectRouteFormat
+static RouteFormat route_format = ROUTE_ARRAY;
+
+// Function to make room for at least extra more characters, the capacity doubles so appending stays linear
+static void reserveOutput(OutputBuffer *buffer, const size_t extra) {
+    if (buffer->length + extra <= buffer->capacity) {
+        return;
+    }
+    size_t capacity = buffer->capacity;
+    while (buffer->length + extra > capacity) {
+        capacity *= 2;
+    }
+    char *data = realloc(buffer->data, capacity);
+    if (data == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the output buffer.\n");
+        exit(EXIT_FAILURE);
+    }
+    buffer->data = data;
+    buffer->capacity = capacity;
+}
+
+// Function to create an empty buffer that holds capacity characters before it has to grow
+void initializeOutputBuffer(OutputBuffer *buffer, const size_t capacity) {
+    buffer->length = 0;
+    buffer->capacity = capacity > 0 ? capacity : 1;
+    buffer->data = malloc(buffer->capacity);
+    if (buffer->data == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the output buffer.\n");
+        exit(EXIT_FAILURE);
+    }
+}
+
+// Function to append a string to the buffer
+void appendText(OutputBuffer *buffer, const char *text) {
+    const size_t length = strlen(text);
+    reserveOutput(buffer, length);
+    memcpy(buffer->data + buffer->length, text, length);
+    buffer->length += length;
+}
+
+// Function to append a coordinate with six decimals like "%f". The value is rounded to an integer of millionths
+// once and its digits are written directly, which avoids the locale and format parsing of printf.
+// A float times 10^6 is exact as a double, so ties are rounded to even like printf does.
+void appendCoordinate(OutputBuffer *buffer, const float value) {
+    reserveOutput(buffer, 24);
+    char *out = buffer->data + buffer->length;
+
+    double scaled_value = (double) value * 1000000.0;
+    if (scaled_value < 0) {
+        *out++ = '-';
+        scaled_value = -scaled_value;
+    }
+    int64_t scaled = (int64_t) scaled_value;
+    const double remainder = scaled_value - (double) scaled;
+    if (remainder > 0.5 || (remainder == 0.5 && scaled % 2 == 1)) {
+        scaled++;
+    }
+
+    // write the integer part, its digits come out in reverse order
+    int64_t integer = scaled / 1000000;
+    char digits[20];
+    int digit_count = 0;
+    do {
+        digits[digit_count++] = (char) ('0' + integer % 10);
+        integer /= 10;
+    } while (integer > 0);
+    while (digit_count > 0) {
+        *out++ = digits[--digit_count];
+    }
+
+    // write the six decimals including their leading zeros
+    int fraction = (int) (scaled % 1000000);
+    *out++ = '.';
+    for (int i = 5; i >= 0; i--) {
+        out[i] = (char) ('0' + fraction % 10);
+        fraction /= 10;
+    }
+    out += 6;
+
+    buffer->length = out - buffer->data;
+}
+
+// Function to write the whole buffer to a stream with one call
+void writeOutputBuffer(const OutputBuffer *buffer, FILE *stream) {
+    fwrite(buffer->data, 1, buffer->length, stream);
+}
+
+// Function to free the memory of the buffer
+void freeOutputBuffer(OutputBuffer *buffer) {
+    free(buffer->data);
+    buffer->data = NULL;
+    buffer->length = 0;
+    buffer->capacity = 0;
+}
+
+// Function to select the format of the routes from the route option, "array" by default or "polyline"
+RouteFormat selectRouteFormat(const char *option) {
+    route_format = ROUTE_ARRAY;
+    if (option != NULL && strcmp(option, "polyline") == 0) {
+        route_format = ROUTE_POLYLINE;
+    } else if (option != NULL && strcmp(option, "array") != 0) {
+        fprintf(stderr, "Ignoring unknown route format '%s', using the array instead\n", option);
+    }
+    return route_format;
+}
+
+// Function to round a coordinate to the 1e-5 degrees of the encoded polyline format
+static int32_t polylineUnits(const float value) {
+    const double scaled = (double) value * 100000.0;
+    return (int32_t) (scaled < 0 ? scaled - 0.5 : scaled + 0.5);
+}
+
+// Function to append one value of the encoded polyline format: the difference is shifted left with its sign in the
+// lowest bit and written in groups of 5 bits, lowest first, each offset by 63 and flagged with 0x20 if more follow.
+// The only character of the format that JSON needs to escape is the backslash.
+static void appendPolylineValue(OutputBuffer *buffer, const int32_t difference) {
+    uint32_t bits = (uint32_t) difference << 1;
+    if (difference < 0) {
+        bits = ~bits;
+    }
+    while (1) {
+        const uint32_t group = bits & 0x1f;
+        bits >>= 5;
+        const char character = (char) ((bits > 0 ? (group | 0x20) : group) + 63);
+        if (character == '\\') {
+            buffer->data[buffer->length++] = '\\';
+        }
+        buffer->data[buffer->length++] = character;
+        if (bits == 0) {
+            break;
+        }
+    }
+}
+
+// Function to start a route of the response with the given name. point_count sizes the buffer, pass 0 if the number
+// of points is not known yet and the buffer grows while the points are added.
+void beginRoute(RouteWriter *route, const char *name, const int point_count) {
+    route->format = route_format;
+    route->point_count = 0;
+    route->previous_lat = 0;
+    route->previous_lon = 0;
+    const size_t points = point_count > 0 ? (size_t) point_count : DEFAULT_ROUTE_POINTS;
+    initializeOutputBuffer(&route->buffer, strlen(name) + 16 + points * MAX_POINT_LENGTH);
+
+    appendText(&route->buffer, "\t\"");
+    appendText(&route->buffer, name);
+    appendText(&route->buffer, route->format == ROUTE_POLYLINE ? "\": \"" : "\": [");
+}
+
+// Function to add the next point to the route
+void addRoutePoint(RouteWriter *route, const float lat, const float lon) {
+    OutputBuffer *buffer = &route->buffer;
+    if (route->format == ROUTE_POLYLINE) {
+        reserveOutput(buffer, MAX_POINT_LENGTH);
+        const int32_t lat_units = polylineUnits(lat);
+        const int32_t lon_units = polylineUnits(lon);
+        appendPolylineValue(buffer, lat_units - route->previous_lat);
+        appendPolylineValue(buffer, lon_units - route->previous_lon);
+        route->previous_lat = lat_units;
+        route->previous_lon = lon_units;
+    } else {
+        appendText(buffer, route->point_count > 0 ? ", [" : "[");
+        appendCoordinate(buffer, lat);
+        appendText(buffer, ", ");
+        appendCoordinate(buffer, lon);
+        appendText(buffer, "]");
+    }
+    route->point_count++;
+}
+
+// Function to close the route, write it to stdout at once and free its buffer
+void endRoute(RouteWriter *route) {
+    appendText(&route->buffer, route->format == ROUTE_POLYLINE ? "\",\n" : "],\n");
+    writeOutputBuffer(&route->buffer, stdout);
+    freeOutputBuffer(&route->buffer);
+}
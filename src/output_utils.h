@@ -0,0 +1,42 @@
+#ifndef OUTPUT_UTILS_H
+#define OUTPUT_UTILS_H
+
+#include <stdio.h>  // For FILE
+#include <stdint.h>
+
+// Formats of the route in the JSON response
+typedef enum {
+    ROUTE_ARRAY,  // [[lat, lon], ...] with six decimals, the default
+    ROUTE_POLYLINE  // one string in the encoded polyline format with five decimals
+} RouteFormat;
+
+// Define a growing character buffer, a part of the response is built in it and written at once
+typedef struct {
+    char *data;
+    size_t length;
+    size_t capacity;
+} OutputBuffer;
+
+// Define a writer for one route of the response
+typedef struct {
+    OutputBuffer buffer;
+    RouteFormat format;
+    int point_count;
+    int32_t previous_lat;  // the last point in 1e-5 degrees, a polyline stores the differences between the points
+    int32_t previous_lon;
+} RouteWriter;
+
+// Output functions
+void initializeOutputBuffer(OutputBuffer *buffer, const size_t capacity);
+void appendText(OutputBuffer *buffer, const char *text);
+void appendCoordinate(OutputBuffer *buffer, const float value);
+void writeOutputBuffer(const OutputBuffer *buffer, FILE *stream);
+void freeOutputBuffer(OutputBuffer *buffer);
+
+// Route functions
+RouteFormat selectRouteFormat(const char *option);
+void beginRoute(RouteWriter *route, const char *name, const int point_count);
+void addRoutePoint(RouteWriter *route, const float lat, const float lon);
+void endRoute(RouteWriter *route);
+
+#endif //OUTPUT_UTILS_H
@@ -0,0 +1,679 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>  // For cos and atan2
+#include <float.h>  // For FLT_MAX
+
+#include "overlay_utils.h"
+#include "heap_utils.h"  // Include MinHeap functions
+#include "task_utils.h"  // Include parallelFor function
+
+#define INF FLT_MAX
+
+#define OVERLAY_FILE_MAGIC 0x4F4C4C4F  // "OLLO"
+#define OVERLAY_FILE_VERSION 2
+
+// Define a struct for a node and its position along the axis its cell is split at
+typedef struct {
+    float key;
+    int node;
+} ProjectedNode;
+
+// Define a struct holding the arguments of one parallel bisection step
+typedef struct {
+    const Node* nodes;
+    int vertices;
+    int depth;  // the cells of this step are the 2^depth segments of order
+    ProjectedNode *order;  // all nodes, every cell is a contiguous segment
+} BisectionTask;
+
+// Define the state of one search on the overlay, reused by all searches of a thread.
+// A distance is only valid if the stamp of its node holds the number of the current search.
+typedef struct {
+    float *dist;
+    int *stamp;
+    int *prev;  // previous node of every node, only kept by the queries
+    int *prev_level;  // level of the clique arc that reached every node, 0 for original edges
+    int search;  // number of the current search, counted from 1
+    MinHeap heap;
+} OverlaySearch;
+
+// Define a struct holding the arguments of the parallel clique calculation of one level
+typedef struct {
+    const PartitionOverlay *overlay;
+    int level;
+    int edge_count;
+    const int* edges_start;
+    const int* edge_destinations;
+    const float* edge_weights;
+    OverlaySearch *searches;  // One search state per thread of the task pool
+} CliqueTask;
+
+// Function to get the cell of node v on a level, level 0 is the node itself
+static int cellOf(const PartitionOverlay *overlay, const int level, const int v) {
+    return level == 0 ? v : overlay->leaf_cell[v] >> ((level - 1) * overlay->cell_bits);
+}
+
+// Function to compare two projected nodes by their position along the split axis
+static int compareProjected(const void *a, const void *b) {
+    const float key_a = ((const ProjectedNode *) a)->key;
+    const float key_b = ((const ProjectedNode *) b)->key;
+    return (key_a > key_b) - (key_a < key_b);
+}
+
+// Function to sort the nodes of the cells begin to end - 1 along their principal axis, so each cell can be split
+// into two halves at its middle. This is an inertial bisection: the axis is the direction the nodes spread the most.
+static void bisectCells(void *context, const int begin, const int end, const int worker_id) {
+    const BisectionTask *task = context;
+    for (int cell = begin; cell < end; cell++) {
+        const int first = (int) (((long long) cell * task->vertices) >> task->depth);
+        const int last = (int) (((long long) (cell + 1) * task->vertices) >> task->depth);
+        const int count = last - first;
+        if (count < 2) {
+            continue;
+        }
+        ProjectedNode *segment = task->order + first;
+
+        // Center of the cell, longitudes are scaled so both axes measure about the same distance
+        double mean_lat = 0;
+        double mean_lon = 0;
+        for (int i = 0; i < count; i++) {
+            mean_lat += task->nodes[segment[i].node].lat;
+            mean_lon += task->nodes[segment[i].node].lon;
+        }
+        mean_lat /= count;
+        mean_lon /= count;
+        const double lon_scale = cos(mean_lat * M_PI / 180.0);
+
+        // The principal axis of the covariance matrix
+        double xx = 0;
+        double xy = 0;
+        double yy = 0;
+        for (int i = 0; i < count; i++) {
+            const double x = (task->nodes[segment[i].node].lon - mean_lon) * lon_scale;
+            const double y = task->nodes[segment[i].node].lat - mean_lat;
+            xx += x * x;
+            xy += x * y;
+            yy += y * y;
+        }
+        const double angle = 0.5 * atan2(2 * xy, xx - yy);
+        const double axis_x = cos(angle);
+        const double axis_y = sin(angle);
+
+        for (int i = 0; i < count; i++) {
+            const double x = (task->nodes[segment[i].node].lon - mean_lon) * lon_scale;
+            const double y = task->nodes[segment[i].node].lat - mean_lat;
+            segment[i].key = (float) (x * axis_x + y * axis_y);
+        }
+        qsort(segment, count, sizeof(ProjectedNode), compareProjected);
+    }
+}
+
+// Function to split the nodes into 2^depth cells of equal size by recursive inertial bisection,
+// all cells of one depth are split in parallel. cell[v] receives the cell of node v.
+void partitionNodes(const Node* nodes, const int vertices, const int depth, int *cell) {
+    ProjectedNode *order = malloc((vertices > 0 ? vertices : 1) * sizeof(ProjectedNode));
+    if (order == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the partition.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Split every cell into two halves along its principal axis
+    for (int i = 0; i < vertices; i++) {
+        order[i].node = i;
+    }
+    for (int d = 0; d < depth; d++) {
+        BisectionTask task = {nodes, vertices, d, order};
+        parallelFor(0, 1 << d, 1, bisectCells, &task);
+    }
+    for (int c = 0; c < (1 << depth); c++) {
+        const int first = (int) (((long long) c * vertices) >> depth);
+        const int last = (int) (((long long) (c + 1) * vertices) >> depth);
+        for (int i = first; i < last; i++) {
+            cell[order[i].node] = c;
+        }
+    }
+    free(order);
+}
+
+// Function to relax the arcs of a node on the overlay of level arc_level, level 0 relaxes the original edges.
+// On a higher level these are the clique arcs of its cell and the original edges that leave the cell.
+// With a filter_level above 0 only nodes inside filter_cell on that level are reached.
+static void relaxOverlayNode(
+    const PartitionOverlay *overlay,
+    OverlaySearch *search,
+    const int edge_count,
+    const int* edges_start,
+    const int* edge_destinations,
+    const float* edge_weights,
+    const int node,
+    const float node_dist,
+    const int arc_level,
+    const int filter_level,
+    const int filter_cell) {
+
+    // clique arcs of the cell of the node, they never leave the cell
+    if (arc_level > 0) {
+        const OverlayLevel *level = &overlay->levels[arc_level - 1];
+        const int cell = cellOf(overlay, arc_level, node);
+        const int first = level->boundary_start[cell];
+        const int boundary_count = level->boundary_start[cell + 1] - first;
+        const float *row = level->clique_weights + level->clique_start[cell] +
+                           (size_t) level->boundary_index[node] * boundary_count;
+
+        for (int j = 0; j < boundary_count; j++) {
+            const int destination = level->boundary_nodes[first + j];
+            const float new_dist = node_dist + row[j];
+            if (row[j] != INF && (search->stamp[destination] != search->search || new_dist < search->dist[destination])) {
+                search->stamp[destination] = search->search;
+                search->dist[destination] = new_dist;
+                if (search->prev != NULL) {
+                    search->prev[destination] = node;
+                    search->prev_level[destination] = arc_level;
+                }
+                pushHeap(&search->heap, destination, new_dist);
+            }
+        }
+    }
+
+    // original edges, on a higher level only the ones that leave the cell of the node
+    const int cell = cellOf(overlay, arc_level, node);
+    const int edge_end = (node == overlay->vertices - 1) ? edge_count : edges_start[node + 1];
+    for (int edge = edges_start[node]; edge < edge_end; edge++) {
+        const int destination = edge_destinations[edge];
+        if (arc_level > 0 && cellOf(overlay, arc_level, destination) == cell) {
+            continue;
+        }
+        if (filter_level > 0 && cellOf(overlay, filter_level, destination) != filter_cell) {
+            continue;
+        }
+        const float new_dist = node_dist + edge_weights[edge];
+        if (search->stamp[destination] != search->search || new_dist < search->dist[destination]) {
+            search->stamp[destination] = search->search;
+            search->dist[destination] = new_dist;
+            if (search->prev != NULL) {
+                search->prev[destination] = node;
+                search->prev_level[destination] = 0;
+            }
+            pushHeap(&search->heap, destination, new_dist);
+        }
+    }
+}
+
+// Function to start a new search from source, all distances of the previous one become invalid
+static void startOverlaySearch(OverlaySearch *search, const int source) {
+    search->search++;
+    search->stamp[source] = search->search;
+    search->dist[source] = 0;
+    if (search->prev != NULL) {
+        search->prev[source] = -1;
+        search->prev_level[source] = 0;
+    }
+    clearHeap(&search->heap);
+    pushHeap(&search->heap, source, 0);
+}
+
+// Function to calculate the cliques of the cells begin to end - 1 of a level. Every boundary node runs a Dijkstra
+// search on the overlay of the level below that stays inside the cell, level 1 searches the original edges.
+static void calculateCliques(void *context, const int begin, const int end, const int worker_id) {
+    const CliqueTask *task = context;
+    const PartitionOverlay *overlay = task->overlay;
+    const OverlayLevel *level = &overlay->levels[task->level - 1];
+    OverlaySearch *search = &task->searches[worker_id];
+
+    for (int cell = begin; cell < end; cell++) {
+        const int first = level->boundary_start[cell];
+        const int boundary_count = level->boundary_start[cell + 1] - first;
+
+        for (int i = 0; i < boundary_count; i++) {
+            startOverlaySearch(search, level->boundary_nodes[first + i]);
+
+            int node;
+            float key;
+            while (popHeap(&search->heap, &node, &key)) {
+                // Skip outdated heap entries
+                if (key > search->dist[node]) {
+                    continue;
+                }
+                relaxOverlayNode(
+                    overlay, search, task->edge_count, task->edges_start, task->edge_destinations, task->edge_weights,
+                    node, key, task->level - 1, task->level, cell);
+            }
+
+            float *row = level->clique_weights + level->clique_start[cell] + (size_t) i * boundary_count;
+            for (int j = 0; j < boundary_count; j++) {
+                const int destination = level->boundary_nodes[first + j];
+                row[j] = search->stamp[destination] == search->search ? search->dist[destination] : INF;
+            }
+        }
+    }
+}
+
+// Function to allocate the state of a search on the overlay, prev is only needed by the queries
+static void initializeOverlaySearch(OverlaySearch *search, const int vertices, const int keep_prev) {
+    search->dist = malloc((vertices > 0 ? vertices : 1) * sizeof(float));
+    search->stamp = calloc(vertices > 0 ? vertices : 1, sizeof(int));
+    search->prev = keep_prev ? malloc((vertices > 0 ? vertices : 1) * sizeof(int)) : NULL;
+    search->prev_level = keep_prev ? malloc((vertices > 0 ? vertices : 1) * sizeof(int)) : NULL;
+    search->search = 0;
+    if (search->dist == NULL || search->stamp == NULL || (keep_prev && (search->prev == NULL || search->prev_level == NULL))) {
+        fprintf(stderr, "Error: Unable to allocate memory for the overlay search.\n");
+        exit(EXIT_FAILURE);
+    }
+    initializeHeap(&search->heap, 1024);
+}
+
+// Function to free the state of a search on the overlay
+static void freeOverlaySearch(OverlaySearch *search) {
+    free(search->dist);
+    free(search->stamp);
+    free(search->prev);
+    free(search->prev_level);
+    freeHeap(&search->heap);
+}
+
+// Function to fill the position of every boundary node among the boundary nodes of its cell
+static void indexBoundaryNodes(OverlayLevel *level, const int vertices) {
+    level->boundary_index = malloc((vertices > 0 ? vertices : 1) * sizeof(int));
+    if (level->boundary_index == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the overlay.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int v = 0; v < vertices; v++) {
+        level->boundary_index[v] = -1;
+    }
+    for (int cell = 0; cell < level->cell_count; cell++) {
+        for (int i = level->boundary_start[cell]; i < level->boundary_start[cell + 1]; i++) {
+            level->boundary_index[level->boundary_nodes[i]] = i - level->boundary_start[cell];
+        }
+    }
+}
+
+// Function to collect the boundary nodes of every cell of a level and allocate the cliques
+static void collectBoundaryNodes(
+    PartitionOverlay *overlay,
+    const int level_number,
+    const int edge_count,
+    const int* edges_start,
+    const int* edge_destinations) {
+
+    const int vertices = overlay->vertices;
+    OverlayLevel *level = &overlay->levels[level_number - 1];
+    level->cell_count = 1 << (overlay->depth - (level_number - 1) * overlay->cell_bits);
+
+    // a node is a boundary node if one of its edges, in either direction, connects it to another cell
+    char *is_boundary = calloc(vertices > 0 ? vertices : 1, sizeof(char));
+    level->boundary_start = calloc(level->cell_count + 1, sizeof(int));
+    level->clique_start = malloc((level->cell_count + 1) * sizeof(int));
+    if (is_boundary == NULL || level->boundary_start == NULL || level->clique_start == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the overlay.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int v = 0; v < vertices; v++) {
+        const int edge_end = (v == vertices - 1) ? edge_count : edges_start[v + 1];
+        for (int edge = edges_start[v]; edge < edge_end; edge++) {
+            const int destination = edge_destinations[edge];
+            if (cellOf(overlay, level_number, v) != cellOf(overlay, level_number, destination)) {
+                is_boundary[v] = 1;
+                is_boundary[destination] = 1;
+            }
+        }
+    }
+
+    // count the boundary nodes of every cell and sort them by cell
+    level->boundary_count = 0;
+    for (int v = 0; v < vertices; v++) {
+        if (is_boundary[v]) {
+            level->boundary_start[cellOf(overlay, level_number, v) + 1]++;
+            level->boundary_count++;
+        }
+    }
+    for (int cell = 0; cell < level->cell_count; cell++) {
+        level->boundary_start[cell + 1] += level->boundary_start[cell];
+    }
+    level->boundary_nodes = malloc((level->boundary_count > 0 ? level->boundary_count : 1) * sizeof(int));
+    int *fill = malloc(level->cell_count * sizeof(int));
+    if (level->boundary_nodes == NULL || fill == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the overlay.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int cell = 0; cell < level->cell_count; cell++) {
+        fill[cell] = level->boundary_start[cell];
+    }
+    for (int v = 0; v < vertices; v++) {
+        if (is_boundary[v]) {
+            level->boundary_nodes[fill[cellOf(overlay, level_number, v)]++] = v;
+        }
+    }
+    indexBoundaryNodes(level, vertices);
+
+    // every cell stores one distance for each pair of its boundary nodes
+    level->clique_start[0] = 0;
+    for (int cell = 0; cell < level->cell_count; cell++) {
+        const int boundary_count = level->boundary_start[cell + 1] - level->boundary_start[cell];
+        level->clique_start[cell + 1] = level->clique_start[cell] + boundary_count * boundary_count;
+    }
+    level->clique_size = level->clique_start[level->cell_count];
+    level->clique_weights = malloc((level->clique_size > 0 ? level->clique_size : 1) * sizeof(float));
+    if (level->clique_weights == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the overlay.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    free(fill);
+    free(is_boundary);
+}
+
+// Function to build the multi-level partition overlay of the graph.
+// The nodes are split by recursive inertial bisection until no cell on level 1 holds more than cell_size nodes, and
+// every level above groups 2^cell_bits cells of the level below, with cell_bits chosen to get about level_count levels.
+// The cliques are calculated level by level, the cells of one level in parallel on the threads of the task pool.
+void buildPartitionOverlay(
+    PartitionOverlay *overlay,
+    const Node* nodes,
+    const int vertices,
+    const int edge_count,
+    const int* edges_start,
+    const int* edge_destinations,
+    const float* edge_weights,
+    const int cell_size,
+    const int level_count) {
+
+    // choose the depth of the partition and how many bisections one level spans
+    int depth = 1;
+    while (depth < 30 && ((long long) vertices >> depth) > cell_size) {
+        depth++;
+    }
+    const int wanted_levels = level_count > 0 ? level_count : 1;
+    overlay->vertices = vertices;
+    overlay->depth = depth;
+    overlay->cell_bits = (depth + wanted_levels - 1) / wanted_levels;
+    overlay->level_count = (depth + overlay->cell_bits - 1) / overlay->cell_bits;
+
+    overlay->leaf_cell = malloc((vertices > 0 ? vertices : 1) * sizeof(int));
+    overlay->levels = calloc(overlay->level_count, sizeof(OverlayLevel));
+    if (overlay->leaf_cell == NULL || overlay->levels == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the overlay.\n");
+        exit(EXIT_FAILURE);
+    }
+    partitionNodes(nodes, vertices, depth, overlay->leaf_cell);
+
+    // Calculate the cliques bottom-up, every level searches the overlay of the level below
+    const int thread_count = taskThreadCount();
+    OverlaySearch *searches = malloc(thread_count * sizeof(OverlaySearch));
+    if (searches == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the overlay.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < thread_count; i++) {
+        initializeOverlaySearch(&searches[i], vertices, 0);
+    }
+    for (int level = 1; level <= overlay->level_count; level++) {
+        collectBoundaryNodes(overlay, level, edge_count, edges_start, edge_destinations);
+
+        CliqueTask task = {overlay, level, edge_count, edges_start, edge_destinations, edge_weights, searches};
+        parallelFor(0, overlay->levels[level - 1].cell_count, 1, calculateCliques, &task);
+    }
+    for (int i = 0; i < thread_count; i++) {
+        freeOverlaySearch(&searches[i]);
+    }
+    free(searches);
+}
+
+// Function to get the overlay level a query explores at a node: the highest level whose cell of the node holds
+// neither the start nor the destination, 0 if the node shares its level 1 cell with one of them
+static int queryLevel(const PartitionOverlay *overlay, const int node, const int start_index, const int dest_index) {
+    for (int level = 1; level <= overlay->level_count; level++) {
+        const int cell = cellOf(overlay, level, node);
+        if (cell == cellOf(overlay, level, start_index) || cell == cellOf(overlay, level, dest_index)) {
+            return level - 1;
+        }
+    }
+    return overlay->level_count;
+}
+
+// Function to replace a clique arc by the original edges, with a Dijkstra search inside the cell of the arc.
+// The nodes after from are appended to path.
+static void unpackCliqueArc(
+    const PartitionOverlay *overlay,
+    OverlaySearch *search,
+    const int edge_count,
+    const int* edges_start,
+    const int* edge_destinations,
+    const float* edge_weights,
+    const int from,
+    const int to,
+    const int level,
+    int *path,
+    int *path_length) {
+
+    startOverlaySearch(search, from);
+    int node;
+    float key;
+    while (popHeap(&search->heap, &node, &key)) {
+        // Skip outdated heap entries
+        if (key > search->dist[node]) {
+            continue;
+        }
+        if (node == to) {
+            break;
+        }
+        relaxOverlayNode(
+            overlay, search, edge_count, edges_start, edge_destinations, edge_weights, node, key, 0, level,
+            cellOf(overlay, level, from));
+    }
+
+    // append the nodes in the order from the arc start to its end
+    int count = 0;
+    for (int current = to; current != from; current = search->prev[current]) {
+        count++;
+    }
+    int current = to;
+    for (int i = count - 1; i >= 0; i--) {
+        path[*path_length + i] = current;
+        current = search->prev[current];
+    }
+    *path_length += count;
+}
+
+// Dijkstra search on the overlay from start to destination. Nodes in the cells of start or destination relax the
+// original edges, all other nodes only the cliques and the edges between the cells of the highest level that holds
+// neither of them. Writes the unpacked node sequence from start to destination to path (room for vertices entries)
+// and returns the distance, INF if the destination can't be reached.
+float queryPartitionOverlay(
+    const PartitionOverlay *overlay,
+    const int edge_count,
+    const int* edges_start,
+    const int* edge_destinations,
+    const float* edge_weights,
+    const int start_index,
+    const int dest_index,
+    int *path,
+    int *path_length) {
+
+    *path_length = 0;
+    OverlaySearch search;
+    initializeOverlaySearch(&search, overlay->vertices, 1);
+    startOverlaySearch(&search, start_index);
+
+    int node;
+    float key;
+    while (popHeap(&search.heap, &node, &key)) {
+        // Skip outdated heap entries
+        if (key > search.dist[node]) {
+            continue;
+        }
+        if (node == dest_index) {
+            break;
+        }
+        relaxOverlayNode(
+            overlay, &search, edge_count, edges_start, edge_destinations, edge_weights, node, key,
+            queryLevel(overlay, node, start_index, dest_index), 0, 0);
+    }
+
+    if (search.stamp[dest_index] != search.search) {
+        freeOverlaySearch(&search);
+        return INF;
+    }
+    const float distance = search.dist[dest_index];
+
+    // collect the arcs of the overlay path, from the destination back to the start
+    int arc_count = 0;
+    for (int current = dest_index; current != start_index; current = search.prev[current]) {
+        arc_count++;
+    }
+    int *arc_nodes = malloc((arc_count + 1) * sizeof(int));
+    int *arc_levels = malloc((arc_count + 1) * sizeof(int));
+    if (arc_nodes == NULL || arc_levels == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the path.\n");
+        exit(EXIT_FAILURE);
+    }
+    int current = dest_index;
+    for (int i = arc_count; i > 0; i--) {
+        arc_nodes[i] = current;
+        arc_levels[i] = search.prev_level[current];
+        current = search.prev[current];
+    }
+    arc_nodes[0] = start_index;
+
+    // Unpack the path, clique arcs are replaced by the original edges they stand for
+    path[(*path_length)++] = start_index;
+    for (int i = 1; i <= arc_count; i++) {
+        if (arc_levels[i] == 0) {
+            path[(*path_length)++] = arc_nodes[i];
+        } else {
+            unpackCliqueArc(
+                overlay, &search, edge_count, edges_start, edge_destinations, edge_weights, arc_nodes[i - 1],
+                arc_nodes[i], arc_levels[i], path, path_length);
+        }
+    }
+
+    free(arc_nodes);
+    free(arc_levels);
+    freeOverlaySearch(&search);
+    return distance;
+}
+
+// Function to write the overlay to a binary file, together with the fingerprint of the graph it belongs to
+int savePartitionOverlay(const PartitionOverlay *overlay, const char *path, const uint64_t fingerprint) {
+    FILE *file = fopen(path, "wb");
+    if (file == NULL) {
+        fprintf(stderr, "Error: Could not open %s for writing.\n", path);
+        return -1;
+    }
+
+    const int header[6] = {
+        OVERLAY_FILE_MAGIC, OVERLAY_FILE_VERSION, overlay->vertices, overlay->depth, overlay->cell_bits,
+        overlay->level_count};
+    const size_t vertices = overlay->vertices;
+    int ok = fwrite(header, sizeof(int), 6, file) == 6 &&
+             fwrite(&fingerprint, sizeof(uint64_t), 1, file) == 1 &&
+             fwrite(overlay->leaf_cell, sizeof(int), vertices, file) == vertices;
+
+    for (int l = 0; ok && l < overlay->level_count; l++) {
+        const OverlayLevel *level = &overlay->levels[l];
+        const int sizes[3] = {level->cell_count, level->boundary_count, level->clique_size};
+        const size_t cell_count = level->cell_count;
+        const size_t boundary_count = level->boundary_count;
+        const size_t clique_size = level->clique_size;
+        ok = fwrite(sizes, sizeof(int), 3, file) == 3 &&
+             fwrite(level->boundary_start, sizeof(int), cell_count + 1, file) == cell_count + 1 &&
+             fwrite(level->boundary_nodes, sizeof(int), boundary_count, file) == boundary_count &&
+             fwrite(level->clique_start, sizeof(int), cell_count + 1, file) == cell_count + 1 &&
+             fwrite(level->clique_weights, sizeof(float), clique_size, file) == clique_size;
+    }
+
+    ok = fclose(file) == 0 && ok;
+    if (!ok) {
+        fprintf(stderr, "Error: Could not write the partition overlay to %s.\n", path);
+        remove(path);
+        return -1;
+    }
+    return 0;
+}
+
+// Function to read an overlay written by savePartitionOverlay, returns -1 if the file doesn't match the graph
+int loadPartitionOverlay(PartitionOverlay *overlay, const char *path, const int vertices, const uint64_t fingerprint) {
+    FILE *file = fopen(path, "rb");
+    if (file == NULL) {
+        return -1;
+    }
+
+    int header[6];
+    uint64_t file_fingerprint;
+    if (fread(header, sizeof(int), 6, file) != 6 ||
+        fread(&file_fingerprint, sizeof(uint64_t), 1, file) != 1 ||
+        header[0] != OVERLAY_FILE_MAGIC || header[1] != OVERLAY_FILE_VERSION ||
+        header[2] != vertices || header[3] < 1 || header[3] > 30 || header[4] < 1 || header[5] < 1 ||
+        file_fingerprint != fingerprint) {
+        fclose(file);
+        return -1;
+    }
+
+    overlay->vertices = vertices;
+    overlay->depth = header[3];
+    overlay->cell_bits = header[4];
+    overlay->level_count = header[5];
+    overlay->leaf_cell = malloc((vertices > 0 ? vertices : 1) * sizeof(int));
+    overlay->levels = calloc(overlay->level_count, sizeof(OverlayLevel));
+    if (overlay->leaf_cell == NULL || overlay->levels == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the overlay.\n");
+        exit(EXIT_FAILURE);
+    }
+    int ok = fread(overlay->leaf_cell, sizeof(int), vertices, file) == (size_t) vertices;
+
+    for (int l = 0; ok && l < overlay->level_count; l++) {
+        OverlayLevel *level = &overlay->levels[l];
+        int sizes[3];
+        if (fread(sizes, sizeof(int), 3, file) != 3 || sizes[0] < 1 || sizes[1] < 0 || sizes[2] < 0) {
+            ok = 0;
+            break;
+        }
+        level->cell_count = sizes[0];
+        level->boundary_count = sizes[1];
+        level->clique_size = sizes[2];
+        const size_t cell_count = level->cell_count;
+        const size_t boundary_count = level->boundary_count;
+        const size_t clique_size = level->clique_size;
+        level->boundary_start = malloc((cell_count + 1) * sizeof(int));
+        level->boundary_nodes = malloc((boundary_count > 0 ? boundary_count : 1) * sizeof(int));
+        level->clique_start = malloc((cell_count + 1) * sizeof(int));
+        level->clique_weights = malloc((clique_size > 0 ? clique_size : 1) * sizeof(float));
+        if (level->boundary_start == NULL || level->boundary_nodes == NULL || level->clique_start == NULL ||
+            level->clique_weights == NULL) {
+            fprintf(stderr, "Error: Unable to allocate memory for the overlay.\n");
+            exit(EXIT_FAILURE);
+        }
+        ok = fread(level->boundary_start, sizeof(int), cell_count + 1, file) == cell_count + 1 &&
+             fread(level->boundary_nodes, sizeof(int), boundary_count, file) == boundary_count &&
+             fread(level->clique_start, sizeof(int), cell_count + 1, file) == cell_count + 1 &&
+             fread(level->clique_weights, sizeof(float), clique_size, file) == clique_size;
+        if (ok) {
+            indexBoundaryNodes(level, vertices);
+        }
+    }
+    fclose(file);
+
+    if (!ok) {
+        freePartitionOverlay(overlay);
+        return -1;
+    }
+    return 0;
+}
+
+// Function to free the overlay memory
+void freePartitionOverlay(PartitionOverlay *overlay) {
+    if (overlay == NULL) {
+        return;
+    }
+    for (int l = 0; overlay->levels != NULL && l < overlay->level_count; l++) {
+        free(overlay->levels[l].boundary_start);
+        free(overlay->levels[l].boundary_nodes);
+        free(overlay->levels[l].clique_start);
+        free(overlay->levels[l].clique_weights);
+        free(overlay->levels[l].boundary_index);
+    }
+    free(overlay->levels);
+    free(overlay->leaf_cell);
+    overlay->levels = NULL;
+    overlay->leaf_cell = NULL;
+}
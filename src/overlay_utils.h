@@ -0,0 +1,57 @@
+#ifndef OVERLAY_UTILS_H
+#define OVERLAY_UTILS_H
+
+#include <stdint.h>
+
+#include "graph_utils.h"  // For Node struct
+
+// Define a struct for one level of the overlay. Every cell stores the shortest distances inside the cell between all
+// of its boundary nodes, the nodes with an edge to another cell of the level.
+typedef struct {
+    int cell_count;  // Number of cells on this level
+    int boundary_count;  // Number of boundary nodes of all cells
+    int clique_size;  // Number of distances of all cells
+    int *boundary_start;  // the boundary nodes of cell c are boundary_nodes[boundary_start[c]] to [boundary_start[c + 1] - 1]
+    int *boundary_nodes;  // Boundary nodes sorted by cell
+    int *clique_start;  // the distances of cell c start at clique_weights[clique_start[c]] (cell_count + 1 entries)
+    float *clique_weights;  // row-major matrix of every cell from each boundary node to each boundary node, INF if unreachable
+    int *boundary_index;  // boundary_index[v] holds the position of v among the boundary nodes of its cell, -1 inside the cell
+} OverlayLevel;
+
+// Define a struct to store a multi-level partition of the graph together with its overlay
+typedef struct {
+    int vertices;  // Number of vertices in the graph
+    int depth;  // The partition has 2^depth cells on level 1
+    int cell_bits;  // Every cell on level l + 1 holds 2^cell_bits cells of level l
+    int level_count;  // Number of levels of the overlay
+    int *leaf_cell;  // leaf_cell[v] holds the cell of v on level 1
+    OverlayLevel *levels;  // levels[l - 1] holds level l
+} PartitionOverlay;
+
+// Partition overlay functions
+void partitionNodes(const Node* nodes, const int vertices, const int depth, int *cell);
+void buildPartitionOverlay(
+    PartitionOverlay *overlay,
+    const Node* nodes,
+    const int vertices,
+    const int edge_count,
+    const int* edges_start,
+    const int* edge_destinations,
+    const float* edge_weights,
+    const int cell_size,
+    const int level_count);
+float queryPartitionOverlay(
+    const PartitionOverlay *overlay,
+    const int edge_count,
+    const int* edges_start,
+    const int* edge_destinations,
+    const float* edge_weights,
+    const int start_index,
+    const int dest_index,
+    int *path,
+    int *path_length);
+int savePartitionOverlay(const PartitionOverlay *overlay, const char *path, const uint64_t fingerprint);
+int loadPartitionOverlay(PartitionOverlay *overlay, const char *path, const int vertices, const uint64_t fingerprint);
+void freePartitionOverlay(PartitionOverlay *overlay);
+
+#endif //OVERLAY_UTILS_H
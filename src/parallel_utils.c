@@ -4,6 +4,7 @@
 #include "graph_utils.h"
 
 #include "parallel_utils.h"  // For Node struct
+#include "task_utils.h"  // Include parallelFor function
 
 void convert_to_device_arrays(
     const Node* nodes,
@@ -60,4 +61,82 @@ void convert_to_device_arrays(
         fprintf(stderr, "Error: Unable to reallocate memory to fit exact edge count.\n");
         exit(EXIT_FAILURE);
     }
-}
\ No newline at end of file
+}
+
+// Define a struct holding the arguments of the parallel light and heavy partition
+typedef struct {
+    int nodeCount;
+    int edge_count;
+    const int* edges_start;
+    int* edge_destinations;
+    float* edge_weights;
+    float delta;
+    int* light_end;
+} EdgePartition;
+
+// Function to partition the edges of the nodes begin to end - 1
+static void partitionNodeEdges(void* context, const int begin, const int end, const int worker_id) {
+    const EdgePartition* partition = context;
+    int* edge_destinations = partition->edge_destinations;
+    float* edge_weights = partition->edge_weights;
+
+    for (int i = begin; i < end; i++) {
+        int light = partition->edges_start[i];  // next position for a light edge
+        // position after the last unchecked edge
+        int heavy = (i == partition->nodeCount - 1) ? partition->edge_count : partition->edges_start[i + 1];
+
+        // swap heavy edges from the front with light edges from the back until both meet
+        while (light < heavy) {
+            if (edge_weights[light] <= partition->delta) {
+                light++;
+                continue;
+            }
+            heavy--;
+
+            const int destination = edge_destinations[light];
+            const float weight = edge_weights[light];
+            edge_destinations[light] = edge_destinations[heavy];
+            edge_weights[light] = edge_weights[heavy];
+            edge_destinations[heavy] = destination;
+            edge_weights[heavy] = weight;
+        }
+        partition->light_end[i] = light;
+    }
+}
+
+// Function to reorder the edges of every node so its light edges (weight <= delta) come before its heavy edges.
+// light_end[i] holds the index of the first heavy edge of node i, the heavy edges end where the edges of i end.
+// The nodes own disjoint parts of the edge arrays, so they are partitioned in parallel.
+void partition_light_heavy_edges(
+    const int nodeCount,
+    const int edge_count,
+    const int* edges_start,
+    int* edge_destinations,
+    float* edge_weights,
+    const float delta,
+    int* light_end) {
+
+    EdgePartition partition = {nodeCount, edge_count, edges_start, edge_destinations, edge_weights, delta, light_end};
+    parallelFor(0, nodeCount, 4096, partitionNodeEdges, &partition);
+}
+
+// Function to round a distance in meters to whole millimetres. Every distance is at least 1 mm, so a path of
+// fixed-point weights always gets longer and following the equal distances back can't loop.
+uint32_t to_fixed_distance(const float distance) {
+    const float millimetres = distance * FIXED_SCALE + 0.5f;
+    if (millimetres < 1) {
+        return 1;
+    }
+    if (millimetres >= (float) (FIXED_INF - 1)) {
+        return FIXED_INF - 1;
+    }
+    return (uint32_t) millimetres;
+}
+
+// Function to convert the edge weights to fixed-point millimetres for the integer distance mode.
+// The rounding keeps the order of the weights, so the light and heavy partition of the float weights stays valid.
+void convert_to_fixed_weights(const int edge_count, const float* edge_weights, uint32_t* fixed_weights) {
+    for (int edge = 0; edge < edge_count; edge++) {
+        fixed_weights[edge] = to_fixed_distance(edge_weights[edge]);
+    }
+}
@@ -1,6 +1,13 @@
 #ifndef PARALLEL_UTILS_H
 #define PARALLEL_UTILS_H
 
+#include <stdint.h>
+
+#include "graph_utils.h"  // For Node struct
+
+#define FIXED_SCALE 1000  // Fixed-point distances count millimetres
+#define FIXED_INF UINT32_MAX  // Fixed-point distance of a node that was not reached
+
 void convert_to_device_arrays(
     const Node* nodes,
     const int nodeCount,
@@ -9,4 +16,17 @@ void convert_to_device_arrays(
     float** edge_weights,
     int* edge_count);
 
+void partition_light_heavy_edges(
+    const int nodeCount,
+    const int edge_count,
+    const int* edges_start,
+    int* edge_destinations,
+    float* edge_weights,
+    const float delta,
+    int* light_end);
+
+uint32_t to_fixed_distance(const float distance);
+
+void convert_to_fixed_weights(const int edge_count, const float* edge_weights, uint32_t* fixed_weights);
+
 #endif //PARALLEL_UTILS_H
\ No newline at end of file
@@ -0,0 +1,749 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <float.h>  // For FLT_MAX
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+
+#include "shard_utils.h"
+#include "heap_utils.h"  // Include MinHeap functions
+#include "overlay_utils.h"  // Include partitionNodes function
+
+#define INF FLT_MAX
+
+// Requests a worker understands, every request starts with one of these as int
+typedef enum {
+    SHARD_LOAD,  // receive the shard: vertices, edge count, boundary count, edges_start, destinations, weights, boundary
+    SHARD_CLIQUE,  // answer the distances between all boundary nodes
+    SHARD_FROM,  // answer the distances from a source to all boundary nodes and to a target (-1 for none)
+    SHARD_TO,  // answer the distances from all boundary nodes to a target
+    SHARD_PATH,  // answer the nodes of the shortest path between two nodes of the shard
+    SHARD_EXIT
+} ShardRequest;
+
+// Define the shard a worker holds, with local node indices
+typedef struct {
+    int vertices;
+    int edge_count;
+    int boundary_count;
+    int *edges_start;
+    int *edge_destinations;
+    float *edge_weights;
+    int *in_start;  // the incoming edges of node v are in_start[v] to in_start[v + 1] - 1
+    int *in_sources;
+    float *in_weights;
+    int *boundary;  // local index of every boundary node
+
+    // search state, a distance is only valid if the stamp of its node holds the number of the current search
+    float *dist;
+    int *prev;
+    int *stamp;
+    int search;
+    MinHeap heap;
+} ShardGraph;
+
+// Function to write all bytes to a socket, a worker that died doesn't raise SIGPIPE
+static int writeAll(const int fd, const void *data, size_t size) {
+    const char *bytes = data;
+    while (size > 0) {
+        const ssize_t written = send(fd, bytes, size, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return -1;
+        }
+        bytes += written;
+        size -= written;
+    }
+    return 0;
+}
+
+// Function to read exactly size bytes from a socket, -1 if it was closed before
+static int readAll(const int fd, void *data, size_t size) {
+    char *bytes = data;
+    while (size > 0) {
+        const ssize_t received = recv(fd, bytes, size, 0);
+        if (received < 0 && errno == EINTR) continue;
+        if (received <= 0) {
+            return -1;
+        }
+        bytes += received;
+        size -= received;
+    }
+    return 0;
+}
+
+// Function to allocate memory for a worker, a worker that runs out of memory ends without flushing stdout
+static void *shardAlloc(const size_t size) {
+    void *memory = malloc(size > 0 ? size : 1);
+    if (memory == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the shard.\n");
+        _exit(EXIT_FAILURE);
+    }
+    return memory;
+}
+
+// Function to read the shard of a worker and collect the incoming edges of every node
+static int loadShard(const int fd, ShardGraph *shard) {
+    int header[3];
+    if (readAll(fd, header, sizeof(header)) != 0) {
+        return -1;
+    }
+    const int vertices = header[0];
+    const int edge_count = header[1];
+    shard->vertices = vertices;
+    shard->edge_count = edge_count;
+    shard->boundary_count = header[2];
+    shard->edges_start = shardAlloc(vertices * sizeof(int));
+    shard->edge_destinations = shardAlloc(edge_count * sizeof(int));
+    shard->edge_weights = shardAlloc(edge_count * sizeof(float));
+    shard->boundary = shardAlloc(shard->boundary_count * sizeof(int));
+    if (readAll(fd, shard->edges_start, vertices * sizeof(int)) != 0 ||
+        readAll(fd, shard->edge_destinations, edge_count * sizeof(int)) != 0 ||
+        readAll(fd, shard->edge_weights, edge_count * sizeof(float)) != 0 ||
+        readAll(fd, shard->boundary, shard->boundary_count * sizeof(int)) != 0) {
+        return -1;
+    }
+
+    // count the incoming edges of every node, then fill them in
+    shard->in_start = calloc(vertices + 1, sizeof(int));
+    shard->in_sources = shardAlloc(edge_count * sizeof(int));
+    shard->in_weights = shardAlloc(edge_count * sizeof(float));
+    int *fill = shardAlloc(vertices * sizeof(int));
+    if (shard->in_start == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the shard.\n");
+        _exit(EXIT_FAILURE);
+    }
+    for (int edge = 0; edge < edge_count; edge++) {
+        shard->in_start[shard->edge_destinations[edge] + 1]++;
+    }
+    for (int v = 0; v < vertices; v++) {
+        shard->in_start[v + 1] += shard->in_start[v];
+        fill[v] = shard->in_start[v];
+    }
+    for (int v = 0; v < vertices; v++) {
+        const int edge_end = (v == vertices - 1) ? edge_count : shard->edges_start[v + 1];
+        for (int edge = shard->edges_start[v]; edge < edge_end; edge++) {
+            const int position = fill[shard->edge_destinations[edge]]++;
+            shard->in_sources[position] = v;
+            shard->in_weights[position] = shard->edge_weights[edge];
+        }
+    }
+    free(fill);
+
+    shard->dist = shardAlloc(vertices * sizeof(float));
+    shard->prev = shardAlloc(vertices * sizeof(int));
+    shard->stamp = calloc(vertices > 0 ? vertices : 1, sizeof(int));
+    if (shard->stamp == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the shard.\n");
+        _exit(EXIT_FAILURE);
+    }
+    shard->search = 0;
+    initializeHeap(&shard->heap, 1024);
+    return 0;
+}
+
+// Function to get the distance of a node in the current search of the shard
+static float shardDistance(const ShardGraph *shard, const int node) {
+    return shard->stamp[node] == shard->search ? shard->dist[node] : INF;
+}
+
+// Dijkstra search inside the shard from source, on the incoming edges if reverse is set.
+// Stops once stop_at is settled, -1 searches the whole shard.
+static void searchShard(ShardGraph *shard, const int source, const int reverse, const int stop_at) {
+    shard->search++;
+    shard->stamp[source] = shard->search;
+    shard->dist[source] = 0;
+    shard->prev[source] = -1;
+    clearHeap(&shard->heap);
+    pushHeap(&shard->heap, source, 0);
+
+    int node;
+    float key;
+    while (popHeap(&shard->heap, &node, &key)) {
+        // Skip outdated heap entries
+        if (key > shard->dist[node]) {
+            continue;
+        }
+        if (node == stop_at) {
+            break;
+        }
+
+        const int first = reverse ? shard->in_start[node] : shard->edges_start[node];
+        const int last = reverse ? shard->in_start[node + 1]
+                                 : (node == shard->vertices - 1) ? shard->edge_count : shard->edges_start[node + 1];
+        for (int edge = first; edge < last; edge++) {
+            const int destination = reverse ? shard->in_sources[edge] : shard->edge_destinations[edge];
+            const float new_dist = key + (reverse ? shard->in_weights[edge] : shard->edge_weights[edge]);
+            if (new_dist < shardDistance(shard, destination)) {
+                shard->stamp[destination] = shard->search;
+                shard->dist[destination] = new_dist;
+                shard->prev[destination] = node;
+                pushHeap(&shard->heap, destination, new_dist);
+            }
+        }
+    }
+}
+
+// Function to send the distances of the current search to all boundary nodes
+static int writeBoundaryDistances(const int fd, const ShardGraph *shard, float *row) {
+    for (int i = 0; i < shard->boundary_count; i++) {
+        row[i] = shardDistance(shard, shard->boundary[i]);
+    }
+    return writeAll(fd, row, shard->boundary_count * sizeof(float));
+}
+
+// Function to answer the requests of the coordinator until it sends SHARD_EXIT or closes the socket
+static void runShardWorker(const int fd) {
+    ShardGraph shard = {0};
+    float *row = NULL;
+    int request;
+    int ok = 1;
+
+    while (ok && readAll(fd, &request, sizeof(int)) == 0 && request != SHARD_EXIT) {
+        int arguments[2];
+        switch (request) {
+            case SHARD_LOAD: {
+                const int status = loadShard(fd, &shard);
+                row = shardAlloc(shard.boundary_count * sizeof(float));
+                ok = status == 0 && writeAll(fd, &status, sizeof(int)) == 0;
+                break;
+            }
+            case SHARD_CLIQUE:
+                for (int i = 0; ok && i < shard.boundary_count; i++) {
+                    searchShard(&shard, shard.boundary[i], 0, -1);
+                    ok = writeBoundaryDistances(fd, &shard, row) == 0;
+                }
+                break;
+            case SHARD_FROM: {
+                ok = readAll(fd, arguments, sizeof(arguments)) == 0;
+                if (!ok) break;
+                searchShard(&shard, arguments[0], 0, -1);
+                const float target_dist = arguments[1] == -1 ? INF : shardDistance(&shard, arguments[1]);
+                ok = writeBoundaryDistances(fd, &shard, row) == 0 && writeAll(fd, &target_dist, sizeof(float)) == 0;
+                break;
+            }
+            case SHARD_TO:
+                ok = readAll(fd, arguments, sizeof(int)) == 0;
+                if (!ok) break;
+                searchShard(&shard, arguments[0], 1, -1);
+                ok = writeBoundaryDistances(fd, &shard, row) == 0;
+                break;
+            case SHARD_PATH: {
+                ok = readAll(fd, arguments, sizeof(arguments)) == 0;
+                if (!ok) break;
+                searchShard(&shard, arguments[0], 0, arguments[1]);
+
+                // send the nodes from the start to the end of the path, none if it can't be reached
+                int count = 0;
+                if (shardDistance(&shard, arguments[1]) != INF) {
+                    for (int current = arguments[1]; current != -1; current = shard.prev[current]) {
+                        count++;
+                    }
+                }
+                int *nodes = shardAlloc(count * sizeof(int));
+                int current = arguments[1];
+                for (int i = count - 1; i >= 0; i--) {
+                    nodes[i] = current;
+                    current = shard.prev[current];
+                }
+                ok = writeAll(fd, &count, sizeof(int)) == 0 && writeAll(fd, nodes, count * sizeof(int)) == 0;
+                free(nodes);
+                break;
+            }
+            default:
+                ok = 0;
+        }
+    }
+
+    free(row);
+    free(shard.edges_start);
+    free(shard.edge_destinations);
+    free(shard.edge_weights);
+    free(shard.in_start);
+    free(shard.in_sources);
+    free(shard.in_weights);
+    free(shard.boundary);
+    free(shard.dist);
+    free(shard.prev);
+    free(shard.stamp);
+    if (shard.heap.entries != NULL) {
+        freeHeap(&shard.heap);
+    }
+    close(fd);
+}
+
+// Function to send shard k with local node indices to its worker, edges to other shards stay with the coordinator
+static int sendShard(
+    const ShardCluster *cluster,
+    const int k,
+    const int edge_count,
+    const int* edges_start,
+    const int* edge_destinations,
+    const float* edge_weights) {
+
+    const int first = cluster->shard_start[k];
+    const int vertices = cluster->shard_start[k + 1] - first;
+    int *local_start = malloc((vertices > 0 ? vertices : 1) * sizeof(int));
+    int local_count = 0;
+    for (int i = 0; i < vertices; i++) {
+        const int v = cluster->shard_nodes[first + i];
+        const int edge_end = (v == cluster->vertices - 1) ? edge_count : edges_start[v + 1];
+        local_count += edge_end - edges_start[v] - (cluster->cut_start[v + 1] - cluster->cut_start[v]);
+    }
+    int *local_destinations = malloc((local_count > 0 ? local_count : 1) * sizeof(int));
+    float *local_weights = malloc((local_count > 0 ? local_count : 1) * sizeof(float));
+    int *local_boundary = malloc(
+        (cluster->boundary_start[k + 1] > cluster->boundary_start[k] ? cluster->boundary_start[k + 1] - cluster->boundary_start[k] : 1) * sizeof(int));
+    if (local_start == NULL || local_destinations == NULL || local_weights == NULL || local_boundary == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the shard.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    int position = 0;
+    for (int i = 0; i < vertices; i++) {
+        const int v = cluster->shard_nodes[first + i];
+        local_start[i] = position;
+        const int edge_end = (v == cluster->vertices - 1) ? edge_count : edges_start[v + 1];
+        for (int edge = edges_start[v]; edge < edge_end; edge++) {
+            if (cluster->shard_of[edge_destinations[edge]] == k) {
+                local_destinations[position] = cluster->local_index[edge_destinations[edge]];
+                local_weights[position] = edge_weights[edge];
+                position++;
+            }
+        }
+    }
+    const int boundary_count = cluster->boundary_start[k + 1] - cluster->boundary_start[k];
+    for (int i = 0; i < boundary_count; i++) {
+        local_boundary[i] = cluster->local_index[cluster->boundary_nodes[cluster->boundary_start[k] + i]];
+    }
+
+    const int request = SHARD_LOAD;
+    const int header[3] = {vertices, local_count, boundary_count};
+    const int fd = cluster->sockets[k];
+    const int status = writeAll(fd, &request, sizeof(int)) == 0 &&
+                       writeAll(fd, header, sizeof(header)) == 0 &&
+                       writeAll(fd, local_start, vertices * sizeof(int)) == 0 &&
+                       writeAll(fd, local_destinations, local_count * sizeof(int)) == 0 &&
+                       writeAll(fd, local_weights, local_count * sizeof(float)) == 0 &&
+                       writeAll(fd, local_boundary, boundary_count * sizeof(int)) == 0 ? 0 : -1;
+
+    free(local_start);
+    free(local_destinations);
+    free(local_weights);
+    free(local_boundary);
+    return status;
+}
+
+// Function to start one worker process per shard, connected to the coordinator by a Unix domain socket.
+// shard_count is rounded up to a power of two for the recursive bisection. The workers are forked before the graph is
+// imported, so they don't inherit a copy-on-write image of it. Returns -1 if a worker could not be started.
+int startShardWorkers(ShardCluster *cluster, const int shard_count) {
+    int depth = 0;
+    while ((1 << depth) < shard_count && depth < 16) {
+        depth++;
+    }
+    const int shards = 1 << depth;
+    *cluster = (ShardCluster) {0};
+    cluster->sockets = malloc(shards * sizeof(int));
+    cluster->workers = malloc(shards * sizeof(pid_t));
+    if (cluster->sockets == NULL || cluster->workers == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the shards.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // buffered output is written first so the children don't inherit it
+    fflush(stdout);
+    fflush(stderr);
+    for (int k = 0; k < shards; k++) {
+        int pair[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, pair) != 0) {
+            perror("socketpair");
+            break;
+        }
+        const pid_t pid = fork();
+        if (pid < 0) {
+            perror("fork");
+            close(pair[0]);
+            close(pair[1]);
+            break;
+        }
+        if (pid == 0) {
+            // the worker only keeps its own socket
+            for (int i = 0; i < k; i++) {
+                close(cluster->sockets[i]);
+            }
+            close(pair[0]);
+            runShardWorker(pair[1]);
+            _exit(EXIT_SUCCESS);
+        }
+        close(pair[1]);
+        cluster->sockets[k] = pair[0];
+        cluster->workers[k] = pid;
+        cluster->shard_count++;
+    }
+
+    if (cluster->shard_count != shards) {
+        fprintf(stderr, "Error: The shard workers could not be started.\n");
+        stopShardCluster(cluster);
+        return -1;
+    }
+    return 0;
+}
+
+// Function to split the graph into geographic shards for the started workers. The shards are cut by recursive
+// inertial bisection of the node coordinates. Every worker receives its part of the graph and calculates the distances
+// between its boundary nodes, all workers at the same time. Only the coordinates of nodes are read, their edge lists
+// may already be freed. Returns -1 if a worker failed.
+int loadShardCluster(
+    ShardCluster *cluster,
+    const Node* nodes,
+    const int vertices,
+    const int edge_count,
+    const int* edges_start,
+    const int* edge_destinations,
+    const float* edge_weights) {
+
+    const int shards = cluster->shard_count;
+    int depth = 0;
+    while ((1 << depth) < shards) {
+        depth++;
+    }
+    cluster->vertices = vertices;
+    cluster->shard_of = malloc((vertices > 0 ? vertices : 1) * sizeof(int));
+    cluster->local_index = malloc((vertices > 0 ? vertices : 1) * sizeof(int));
+    cluster->shard_start = calloc(shards + 1, sizeof(int));
+    cluster->shard_nodes = malloc((vertices > 0 ? vertices : 1) * sizeof(int));
+    cluster->boundary_start = calloc(shards + 1, sizeof(int));
+    cluster->boundary_position = malloc((vertices > 0 ? vertices : 1) * sizeof(int));
+    cluster->clique_start = malloc((shards + 1) * sizeof(int));
+    cluster->cut_start = calloc(vertices + 1, sizeof(int));
+    if (cluster->shard_of == NULL || cluster->local_index == NULL || cluster->shard_start == NULL ||
+        cluster->shard_nodes == NULL || cluster->boundary_start == NULL || cluster->boundary_position == NULL ||
+        cluster->clique_start == NULL || cluster->cut_start == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the shards.\n");
+        exit(EXIT_FAILURE);
+    }
+    partitionNodes(nodes, vertices, depth, cluster->shard_of);
+
+    // sort the nodes by shard, a node keeps its relative order inside the shard
+    for (int v = 0; v < vertices; v++) {
+        cluster->shard_start[cluster->shard_of[v] + 1]++;
+    }
+    for (int k = 0; k < shards; k++) {
+        cluster->shard_start[k + 1] += cluster->shard_start[k];
+    }
+    int *fill = malloc(shards * sizeof(int));
+    if (fill == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the shards.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int k = 0; k < shards; k++) {
+        fill[k] = cluster->shard_start[k];
+    }
+    for (int v = 0; v < vertices; v++) {
+        const int position = fill[cluster->shard_of[v]]++;
+        cluster->shard_nodes[position] = v;
+        cluster->local_index[v] = position - cluster->shard_start[cluster->shard_of[v]];
+    }
+
+    // the edges between shards stay with the coordinator, their ends are the boundary nodes
+    char *is_boundary = calloc(vertices > 0 ? vertices : 1, sizeof(char));
+    if (is_boundary == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the shards.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int v = 0; v < vertices; v++) {
+        const int edge_end = (v == vertices - 1) ? edge_count : edges_start[v + 1];
+        for (int edge = edges_start[v]; edge < edge_end; edge++) {
+            if (cluster->shard_of[edge_destinations[edge]] != cluster->shard_of[v]) {
+                cluster->cut_start[v + 1]++;
+                is_boundary[v] = 1;
+                is_boundary[edge_destinations[edge]] = 1;
+            }
+        }
+    }
+    for (int v = 0; v < vertices; v++) {
+        cluster->cut_start[v + 1] += cluster->cut_start[v];
+    }
+    const int cut_count = cluster->cut_start[vertices];
+    cluster->cut_destinations = malloc((cut_count > 0 ? cut_count : 1) * sizeof(int));
+    cluster->cut_weights = malloc((cut_count > 0 ? cut_count : 1) * sizeof(float));
+    if (cluster->cut_destinations == NULL || cluster->cut_weights == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the shards.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int v = 0; v < vertices; v++) {
+        int position = cluster->cut_start[v];
+        const int edge_end = (v == vertices - 1) ? edge_count : edges_start[v + 1];
+        for (int edge = edges_start[v]; edge < edge_end; edge++) {
+            if (cluster->shard_of[edge_destinations[edge]] != cluster->shard_of[v]) {
+                cluster->cut_destinations[position] = edge_destinations[edge];
+                cluster->cut_weights[position] = edge_weights[edge];
+                position++;
+            }
+        }
+    }
+
+    // list the boundary nodes of every shard in the order of the shard nodes
+    int boundary_count = 0;
+    for (int v = 0; v < vertices; v++) {
+        cluster->boundary_position[v] = -1;
+        if (is_boundary[v]) {
+            cluster->boundary_start[cluster->shard_of[v] + 1]++;
+            boundary_count++;
+        }
+    }
+    for (int k = 0; k < shards; k++) {
+        cluster->boundary_start[k + 1] += cluster->boundary_start[k];
+        fill[k] = cluster->boundary_start[k];
+    }
+    cluster->boundary_nodes = malloc((boundary_count > 0 ? boundary_count : 1) * sizeof(int));
+    if (cluster->boundary_nodes == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the shards.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < vertices; i++) {
+        const int v = cluster->shard_nodes[i];
+        if (is_boundary[v]) {
+            const int k = cluster->shard_of[v];
+            cluster->boundary_position[v] = fill[k] - cluster->boundary_start[k];
+            cluster->boundary_nodes[fill[k]++] = v;
+        }
+    }
+    free(is_boundary);
+    free(fill);
+
+    cluster->clique_start[0] = 0;
+    for (int k = 0; k < shards; k++) {
+        const int count = cluster->boundary_start[k + 1] - cluster->boundary_start[k];
+        cluster->clique_start[k + 1] = cluster->clique_start[k] + count * count;
+    }
+    cluster->cliques = malloc((cluster->clique_start[shards] > 0 ? cluster->clique_start[shards] : 1) * sizeof(float));
+    if (cluster->cliques == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the shards.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Send every worker its shard, then let all of them calculate their cliques at the same time
+    int ok = 1;
+    for (int k = 0; ok && k < shards; k++) {
+        ok = sendShard(cluster, k, edge_count, edges_start, edge_destinations, edge_weights) == 0;
+    }
+    for (int k = 0; ok && k < shards; k++) {
+        int status;
+        ok = readAll(cluster->sockets[k], &status, sizeof(int)) == 0 && status == 0;
+    }
+    const int request = SHARD_CLIQUE;
+    for (int k = 0; ok && k < shards; k++) {
+        ok = writeAll(cluster->sockets[k], &request, sizeof(int)) == 0;
+    }
+    for (int k = 0; ok && k < shards; k++) {
+        const size_t size = (size_t) (cluster->clique_start[k + 1] - cluster->clique_start[k]) * sizeof(float);
+        ok = readAll(cluster->sockets[k], cluster->cliques + cluster->clique_start[k], size) == 0;
+    }
+
+    if (!ok) {
+        fprintf(stderr, "Error: The shard workers could not load their shards.\n");
+        stopShardCluster(cluster);
+        return -1;
+    }
+    return 0;
+}
+
+// Search across the shards from start to destination. The workers of the start and the destination shard send the
+// distances from the start to their boundary nodes and from their boundary nodes to the destination, the coordinator
+// runs Dijkstra on the boundary nodes with the cliques and the edges between the shards, and the workers unpack the
+// arcs of the found path inside their shards. Writes the node sequence from start to destination to path (room for
+// vertices entries) and returns the distance, INF if the destination can't be reached and -1 if a worker failed.
+float queryShardCluster(
+    const ShardCluster *cluster,
+    const int start_index,
+    const int dest_index,
+    int *path,
+    int *path_length) {
+
+    *path_length = 0;
+    const int vertices = cluster->vertices;
+    const int start_shard = cluster->shard_of[start_index];
+    const int dest_shard = cluster->shard_of[dest_index];
+    const int start_boundary = cluster->boundary_start[start_shard + 1] - cluster->boundary_start[start_shard];
+    const int dest_boundary = cluster->boundary_start[dest_shard + 1] - cluster->boundary_start[dest_shard];
+
+    // Ask both workers at the same time, a single shard answers both requests in order
+    float *from_start = malloc((start_boundary + 1) * sizeof(float));
+    float *to_dest = malloc((dest_boundary > 0 ? dest_boundary : 1) * sizeof(float));
+    float *dist = malloc(vertices * sizeof(float));
+    int *prev = malloc(vertices * sizeof(int));
+    int *prev_shard = malloc(vertices * sizeof(int));  // shard of the arc that reached a node, -1 for an edge between shards
+    char *reached = calloc(vertices, sizeof(char));
+    if (from_start == NULL || to_dest == NULL || dist == NULL || prev == NULL || prev_shard == NULL || reached == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the shard query.\n");
+        exit(EXIT_FAILURE);
+    }
+    const int from_request[3] = {
+        SHARD_FROM, cluster->local_index[start_index], start_shard == dest_shard ? cluster->local_index[dest_index] : -1};
+    const int to_request[2] = {SHARD_TO, cluster->local_index[dest_index]};
+    int ok = writeAll(cluster->sockets[start_shard], from_request, sizeof(from_request)) == 0 &&
+             writeAll(cluster->sockets[dest_shard], to_request, sizeof(to_request)) == 0 &&
+             readAll(cluster->sockets[start_shard], from_start, (start_boundary + 1) * sizeof(float)) == 0 &&
+             readAll(cluster->sockets[dest_shard], to_dest, dest_boundary * sizeof(float)) == 0;
+
+    // Dijkstra on the boundary nodes, the start and the destination
+    MinHeap heap;
+    initializeHeap(&heap, 1024);
+    dist[start_index] = 0;
+    prev[start_index] = -1;
+    reached[start_index] = 1;
+    pushHeap(&heap, start_index, 0);
+
+    int node;
+    float key;
+    while (ok && popHeap(&heap, &node, &key)) {
+        // Skip outdated heap entries
+        if (key > dist[node]) {
+            continue;
+        }
+        if (node == dest_index) {
+            break;
+        }
+
+        const int shard = cluster->shard_of[node];
+        const int first = cluster->boundary_start[shard];
+        const int count = cluster->boundary_start[shard + 1] - first;
+        const float *row = NULL;
+        if (node == start_index) {
+            row = from_start;
+        } else if (cluster->boundary_position[node] != -1) {
+            row = cluster->cliques + cluster->clique_start[shard] + (size_t) cluster->boundary_position[node] * count;
+        }
+
+        // arcs inside the shard: to its boundary nodes and, in the destination shard, to the destination
+        int arc_count = row != NULL ? count : 0;
+        for (int j = 0; j <= arc_count; j++) {
+            int destination;
+            float weight;
+            if (j < arc_count) {
+                destination = cluster->boundary_nodes[first + j];
+                weight = row[j];
+            } else if (shard == dest_shard) {
+                destination = dest_index;
+                weight = node == start_index ? from_start[start_boundary]
+                       : cluster->boundary_position[node] != -1 ? to_dest[cluster->boundary_position[node]] : INF;
+            } else {
+                break;
+            }
+            if (weight != INF && (!reached[destination] || key + weight < dist[destination])) {
+                reached[destination] = 1;
+                dist[destination] = key + weight;
+                prev[destination] = node;
+                prev_shard[destination] = shard;
+                pushHeap(&heap, destination, key + weight);
+            }
+        }
+
+        // edges to other shards
+        for (int edge = cluster->cut_start[node]; edge < cluster->cut_start[node + 1]; edge++) {
+            const int destination = cluster->cut_destinations[edge];
+            const float new_dist = key + cluster->cut_weights[edge];
+            if (!reached[destination] || new_dist < dist[destination]) {
+                reached[destination] = 1;
+                dist[destination] = new_dist;
+                prev[destination] = node;
+                prev_shard[destination] = -1;
+                pushHeap(&heap, destination, new_dist);
+            }
+        }
+    }
+    freeHeap(&heap);
+
+    float distance = ok && reached[dest_index] ? dist[dest_index] : INF;
+    if (ok && distance != INF) {
+        // collect the arcs from the destination back to the start
+        int arc_count = 0;
+        for (int current = dest_index; current != start_index; current = prev[current]) {
+            arc_count++;
+        }
+        int *arc_nodes = malloc((arc_count + 1) * sizeof(int));
+        if (arc_nodes == NULL) {
+            fprintf(stderr, "Error: Unable to allocate memory for the path.\n");
+            exit(EXIT_FAILURE);
+        }
+        int current = dest_index;
+        for (int i = arc_count; i >= 0; i--) {
+            arc_nodes[i] = current;
+            current = i > 0 ? prev[current] : -1;
+        }
+
+        // Request the paths of all arcs inside the shards first, so the workers unpack them at the same time
+        for (int i = 1; ok && i <= arc_count; i++) {
+            const int shard = prev_shard[arc_nodes[i]];
+            if (shard != -1) {
+                const int request[3] = {
+                    SHARD_PATH, cluster->local_index[arc_nodes[i - 1]], cluster->local_index[arc_nodes[i]]};
+                ok = writeAll(cluster->sockets[shard], request, sizeof(request)) == 0;
+            }
+        }
+        path[(*path_length)++] = start_index;
+        for (int i = 1; ok && i <= arc_count; i++) {
+            const int shard = prev_shard[arc_nodes[i]];
+            if (shard == -1) {
+                path[(*path_length)++] = arc_nodes[i];
+                continue;
+            }
+            int count;
+            ok = readAll(cluster->sockets[shard], &count, sizeof(int)) == 0 && count > 0 &&
+                 *path_length + count - 1 <= vertices;
+            for (int j = 0; ok && j < count; j++) {
+                int local;
+                ok = readAll(cluster->sockets[shard], &local, sizeof(int)) == 0;
+                // the first node of the arc is already on the path
+                if (ok && j > 0) {
+                    path[(*path_length)++] = cluster->shard_nodes[cluster->shard_start[shard] + local];
+                }
+            }
+        }
+        free(arc_nodes);
+    }
+
+    free(from_start);
+    free(to_dest);
+    free(dist);
+    free(prev);
+    free(prev_shard);
+    free(reached);
+    if (!ok) {
+        fprintf(stderr, "Error: A shard worker stopped answering.\n");
+        return -1;
+    }
+    return distance;
+}
+
+// Function to stop the workers and free the coordinator memory
+void stopShardCluster(ShardCluster *cluster) {
+    const int request = SHARD_EXIT;
+    for (int k = 0; k < cluster->shard_count; k++) {
+        writeAll(cluster->sockets[k], &request, sizeof(int));
+        close(cluster->sockets[k]);
+        waitpid(cluster->workers[k], NULL, 0);
+    }
+    free(cluster->shard_of);
+    free(cluster->local_index);
+    free(cluster->shard_start);
+    free(cluster->shard_nodes);
+    free(cluster->boundary_start);
+    free(cluster->boundary_nodes);
+    free(cluster->boundary_position);
+    free(cluster->clique_start);
+    free(cluster->cliques);
+    free(cluster->cut_start);
+    free(cluster->cut_destinations);
+    free(cluster->cut_weights);
+    free(cluster->sockets);
+    free(cluster->workers);
+    cluster->shard_count = 0;
+    cluster->shard_of = NULL;
+    cluster->cliques = NULL;
+    cluster->sockets = NULL;
+    cluster->workers = NULL;
+}
@@ -0,0 +1,51 @@
+#ifndef SHARD_UTILS_H
+#define SHARD_UTILS_H
+
+#include <sys/types.h>  // For pid_t
+
+#include "graph_utils.h"  // For Node struct
+
+// Define a struct for a graph that is split into geographic shards, each held by its own worker process.
+// The coordinator keeps only the boundary nodes, the distances between them inside every shard and the edges
+// that connect the shards.
+typedef struct {
+    int shard_count;
+    int vertices;  // Number of vertices of the whole graph
+    int *shard_of;  // shard_of[v] holds the shard of node v
+    int *local_index;  // local_index[v] holds the index of node v inside its shard
+    int *shard_start;  // the nodes of shard k are shard_nodes[shard_start[k]] to shard_nodes[shard_start[k + 1] - 1]
+    int *shard_nodes;  // Nodes sorted by shard, shard_nodes[shard_start[k] + i] is node i of shard k
+
+    int *boundary_start;  // the boundary nodes of shard k are boundary_nodes[boundary_start[k]] to [boundary_start[k + 1] - 1]
+    int *boundary_nodes;  // Nodes with an edge to or from another shard, sorted by shard
+    int *boundary_position;  // boundary_position[v] holds the position of v among the boundary nodes of its shard, -1 inside
+    int *clique_start;  // the distances of shard k start at cliques[clique_start[k]]
+    float *cliques;  // row-major matrix of every shard from each boundary node to each boundary node, INF if unreachable
+
+    int *cut_start;  // the edges that leave node v to another shard are cut_start[v] to cut_start[v + 1] - 1
+    int *cut_destinations;
+    float *cut_weights;
+
+    int *sockets;  // Unix domain socket of every worker
+    pid_t *workers;  // Process ID of every worker
+} ShardCluster;
+
+// Shard functions
+int startShardWorkers(ShardCluster *cluster, const int shard_count);
+int loadShardCluster(
+    ShardCluster *cluster,
+    const Node* nodes,
+    const int vertices,
+    const int edge_count,
+    const int* edges_start,
+    const int* edge_destinations,
+    const float* edge_weights);
+float queryShardCluster(
+    const ShardCluster *cluster,
+    const int start_index,
+    const int dest_index,
+    int *path,
+    int *path_length);
+void stopShardCluster(ShardCluster *cluster);
+
+#endif //SHARD_UTILS_H
@@ -0,0 +1,145 @@
+#include <stdio.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#include "simd_utils.h"
+
+// The vector kernels use the x86 intrinsics and are compiled for their instruction set function by function,
+// so the executables still start on CPUs without AVX2 and pick the kernel at runtime
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_X86
+#include <immintrin.h>
+#endif
+
+// Function to read the distances of the destinations from their labels. The labels are written by other threads with
+// a compare-and-swap at the same time, so they are read with relaxed atomic loads and never with a vector gather.
+static void loadLabelDistances(const void* distances, const int* destinations, const int count, float* current) {
+    for (int i = 0; i < count; i++) {
+        const uint64_t label = atomic_load_explicit(
+            (const _Atomic uint64_t*) distances + destinations[i], memory_order_relaxed);
+        const uint32_t distance_bits = (uint32_t) (label >> 32);
+        memcpy(&current[i], &distance_bits, sizeof(float));
+    }
+}
+
+// Function to compare the edges one at a time, works on every CPU
+static uint32_t relaxMaskScalar(
+    const void* distances,
+    const DistanceLayout layout,
+    const int* destinations,
+    const float* weights,
+    const int count,
+    const float node_dist) {
+
+    float labels[RELAX_WIDTH];
+    if (layout == DISTANCE_LABELS) {
+        loadLabelDistances(distances, destinations, count, labels);
+    }
+
+    uint32_t mask = 0;
+    for (int i = 0; i < count; i++) {
+        const float current = layout == DISTANCE_LABELS ? labels[i] : ((const float*) distances)[destinations[i]];
+        mask |= (uint32_t) (node_dist + weights[i] < current) << i;
+    }
+    return mask;
+}
+
+#ifdef SIMD_X86
+// Function to compare the edges 8 at a time. The lanes behind count are masked, so no memory beyond the edges of the
+// node is read. Only plain float distances are gathered, the distances of labels are loaded atomically beforehand.
+__attribute__((target("avx2")))
+static uint32_t relaxMaskAvx2(
+    const void* distances,
+    const DistanceLayout layout,
+    const int* destinations,
+    const float* weights,
+    const int count,
+    const float node_dist) {
+
+    float labels[RELAX_WIDTH];
+    if (layout == DISTANCE_LABELS) {
+        loadLabelDistances(distances, destinations, count, labels);
+    }
+
+    const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const __m256 node = _mm256_set1_ps(node_dist);
+    uint32_t mask = 0;
+    for (int first = 0; first < count; first += 8) {
+        const __m256i active = _mm256_cmpgt_epi32(_mm256_set1_epi32(count - first), lanes);
+        const __m256 candidate = _mm256_add_ps(node, _mm256_maskload_ps(weights + first, active));
+        const __m256 current = layout == DISTANCE_LABELS
+            ? _mm256_maskload_ps(labels + first, active)
+            : _mm256_mask_i32gather_ps(_mm256_setzero_ps(), (const float*) distances,
+                                       _mm256_maskload_epi32(destinations + first, active),
+                                       _mm256_castsi256_ps(active), 4);
+        const __m256 shorter = _mm256_and_ps(_mm256_cmp_ps(candidate, current, _CMP_LT_OQ), _mm256_castsi256_ps(active));
+        mask |= (uint32_t) _mm256_movemask_ps(shorter) << first;
+    }
+    return mask;
+}
+
+// Function to compare up to 16 edges at once with the mask registers of AVX-512
+__attribute__((target("avx512f")))
+static uint32_t relaxMaskAvx512(
+    const void* distances,
+    const DistanceLayout layout,
+    const int* destinations,
+    const float* weights,
+    const int count,
+    const float node_dist) {
+
+    float labels[RELAX_WIDTH];
+    if (layout == DISTANCE_LABELS) {
+        loadLabelDistances(distances, destinations, count, labels);
+    }
+
+    const __mmask16 active = (__mmask16) ((1u << count) - 1);
+    const __m512 candidate = _mm512_add_ps(_mm512_set1_ps(node_dist), _mm512_maskz_loadu_ps(active, weights));
+    const __m512 current = layout == DISTANCE_LABELS
+        ? _mm512_maskz_loadu_ps(active, labels)
+        : _mm512_mask_i32gather_ps(_mm512_setzero_ps(), active, _mm512_maskz_loadu_epi32(active, destinations),
+                                   distances, 4);
+    return _mm512_mask_cmp_ps_mask(active, candidate, current, _CMP_LT_OQ);
+}
+#endif
+
+// Function to select the relaxation kernel from the simd option (auto, avx512, avx2 or scalar).
+// auto and unset take the widest kernel the CPU supports, a kernel the CPU lacks falls back the same way.
+RelaxKernel selectRelaxKernel(const char *option, const char **name) {
+    int avx2 = 0;
+    int avx512 = 0;
+#ifdef SIMD_X86
+    __builtin_cpu_init();
+    avx2 = __builtin_cpu_supports("avx2");
+    avx512 = __builtin_cpu_supports("avx512f");
+#endif
+
+    int wanted_avx2 = avx2;
+    int wanted_avx512 = avx512;
+    if (option != NULL && strcmp(option, "auto") != 0) {
+        if (strcmp(option, "scalar") == 0) {
+            wanted_avx2 = 0;
+            wanted_avx512 = 0;
+        } else if (strcmp(option, "avx2") == 0 && avx2) {
+            wanted_avx512 = 0;
+        } else if (!(strcmp(option, "avx512") == 0 && avx512)) {
+            fprintf(stderr, "Ignoring unsupported simd option '%s', using the widest kernel of this CPU instead\n", option);
+        }
+    }
+
+#ifdef SIMD_X86
+    if (wanted_avx512) {
+        *name = "avx512";
+        return relaxMaskAvx512;
+    }
+    if (wanted_avx2) {
+        *name = "avx2";
+        return relaxMaskAvx2;
+    }
+#else
+    (void) wanted_avx2;
+    (void) wanted_avx512;
+#endif
+    *name = "scalar";
+    return relaxMaskScalar;
+}
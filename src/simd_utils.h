@@ -0,0 +1,28 @@
+#ifndef SIMD_UTILS_H
+#define SIMD_UTILS_H
+
+#include <stdint.h>
+
+#define RELAX_WIDTH 16  // Largest number of edges one call of a relaxation kernel compares
+
+// Define how the distances a relaxation kernel compares against are stored
+typedef enum {
+    DISTANCE_FLOATS,  // a float per node
+    DISTANCE_LABELS  // the distance in the upper 32 bits of an _Atomic 64-bit label per node, read with atomic loads
+} DistanceLayout;
+
+// Define a relaxation kernel. It compares the candidate distances node_dist + weights[i] of count (at most RELAX_WIDTH)
+// edges with the current distances of their destinations and returns a mask with bit i set if edge i is shorter.
+// The caller still checks every set bit against the distance, so two edges to the same node are handled correctly.
+typedef uint32_t (*RelaxKernel)(
+    const void* distances,
+    const DistanceLayout layout,
+    const int* destinations,
+    const float* weights,
+    const int count,
+    const float node_dist);
+
+// SIMD functions
+RelaxKernel selectRelaxKernel(const char *option, const char **name);
+
+#endif //SIMD_UTILS_H
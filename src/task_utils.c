@@ -0,0 +1,281 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <sched.h>  // For sched_yield
+#include <stdatomic.h>
+#include <unistd.h>  // For sysconf
+
+#include "task_utils.h"
+
+#define DEQUE_CAPACITY 64  // Number of ranges a deque can hold, every split halves a range so 32 are enough for any loop
+#define CHUNKS_PER_THREAD 8  // Number of chunks every thread gets on average, more chunks balance better
+
+// Define a range of loop iterations, begin to end - 1
+typedef struct {
+    int begin;
+    int end;
+} TaskRange;
+
+// Define the deque of ranges every thread owns. The owner takes the newest range from the bottom,
+// idle threads steal the oldest and therefore largest range from the top.
+typedef struct {
+    pthread_mutex_t mutex;
+    TaskRange ranges[DEQUE_CAPACITY];
+    int top;  // Index of the oldest range
+    int bottom;  // Index after the newest range
+} TaskDeque;
+
+// Define the pool of threads that runs the parallel loops of the whole program
+typedef struct {
+    int thread_count;  // Number of threads including the calling thread, which works as thread 0
+    TaskDeque *deques;  // One deque per thread
+
+    pthread_mutex_t mutex;  // Guards the fields below
+    pthread_cond_t work_available;  // Signalled when a new loop starts
+    pthread_cond_t work_done;  // Signalled when the last worker thread leaves a loop
+    unsigned int generation;  // Incremented for every loop
+    int busy;  // Number of worker threads inside the current loop
+
+    // the loop that runs at the moment
+    RangeTask task;
+    void *context;
+    int grain;  // Ranges up to this size are not split anymore
+    atomic_int remaining;  // Number of iterations not processed yet
+
+    pthread_mutex_t submit_mutex;  // Lets only one thread start a loop at a time
+} TaskPool;
+
+static TaskPool pool;
+static pthread_mutex_t pool_init_mutex = PTHREAD_MUTEX_INITIALIZER;
+static atomic_int pool_ready = 0;
+
+// Index of the pool thread the calling thread works as, -1 outside of a loop
+static _Thread_local int current_worker = -1;
+
+// Function to add a range at the bottom of a deque, returns 0 if the deque is full
+static int pushRange(TaskDeque *deque, const TaskRange range) {
+    int pushed = 0;
+    pthread_mutex_lock(&deque->mutex);
+    if (deque->bottom < DEQUE_CAPACITY) {
+        deque->ranges[deque->bottom++] = range;
+        pushed = 1;
+    }
+    pthread_mutex_unlock(&deque->mutex);
+    return pushed;
+}
+
+// Function to take the newest range from the bottom of the own deque, returns 0 if the deque is empty
+static int popRange(TaskDeque *deque, TaskRange *range) {
+    int popped = 0;
+    pthread_mutex_lock(&deque->mutex);
+    if (deque->bottom > deque->top) {
+        *range = deque->ranges[--deque->bottom];
+        popped = 1;
+    }
+    if (deque->bottom == deque->top) {
+        deque->top = deque->bottom = 0;  // reuse the whole array once the deque is empty
+    }
+    pthread_mutex_unlock(&deque->mutex);
+    return popped;
+}
+
+// Function to steal the oldest range from the deque of another thread, returns 0 if all other deques are empty
+static int stealRange(const int thief, TaskRange *range) {
+    for (int i = 1; i < pool.thread_count; i++) {
+        TaskDeque *deque = &pool.deques[(thief + i) % pool.thread_count];
+        pthread_mutex_lock(&deque->mutex);
+        if (deque->bottom > deque->top) {
+            *range = deque->ranges[deque->top++];
+            if (deque->bottom == deque->top) {
+                deque->top = deque->bottom = 0;
+            }
+            pthread_mutex_unlock(&deque->mutex);
+            return 1;
+        }
+        pthread_mutex_unlock(&deque->mutex);
+    }
+    return 0;
+}
+
+// Function to process ranges of the current loop until all of its iterations are done.
+// A range larger than the grain is halved and its upper half pushed onto the own deque first, so the chunks adapt to
+// the loop: threads that run out of work steal large halves, while busy threads work through small chunks.
+static void runTasks(const int worker_id) {
+    TaskDeque *own = &pool.deques[worker_id];
+    for (;;) {
+        TaskRange range;
+        if (!popRange(own, &range) && !stealRange(worker_id, &range)) {
+            if (atomic_load(&pool.remaining) == 0) {
+                return;
+            }
+            sched_yield();  // the last ranges are still processed by other threads
+            continue;
+        }
+
+        while (range.end - range.begin > pool.grain) {
+            const int middle = range.begin + (range.end - range.begin) / 2;
+            if (!pushRange(own, (TaskRange) {middle, range.end})) {
+                break;  // process the whole range if the deque is full
+            }
+            range.end = middle;
+        }
+
+        pool.task(pool.context, range.begin, range.end, worker_id);
+        atomic_fetch_sub(&pool.remaining, range.end - range.begin);
+    }
+}
+
+// Worker thread that waits for loops and helps processing them
+static void *taskWorker(void *arg) {
+    const int worker_id = (int) (intptr_t) arg;
+    current_worker = worker_id;
+
+    unsigned int seen_generation = 0;
+    pthread_mutex_lock(&pool.mutex);
+    for (;;) {
+        while (pool.generation == seen_generation) {
+            pthread_cond_wait(&pool.work_available, &pool.mutex);
+        }
+        seen_generation = pool.generation;
+        pool.busy++;
+        pthread_mutex_unlock(&pool.mutex);
+
+        runTasks(worker_id);
+
+        pthread_mutex_lock(&pool.mutex);
+        if (--pool.busy == 0) {
+            pthread_cond_broadcast(&pool.work_done);
+        }
+    }
+    return NULL;
+}
+
+// Function to start the thread pool with thread_count threads, or one thread per core if thread_count is not positive.
+// It has to be called before the first parallel loop to take effect, later calls keep the running pool.
+void initializeTaskPool(int thread_count) {
+    pthread_mutex_lock(&pool_init_mutex);
+    if (atomic_load(&pool_ready)) {
+        pthread_mutex_unlock(&pool_init_mutex);
+        return;
+    }
+
+    if (thread_count <= 0) {
+        const long cores = sysconf(_SC_NPROCESSORS_ONLN);
+        thread_count = cores > 0 ? (int) cores : 1;
+    }
+
+    pool.deques = malloc(thread_count * sizeof(TaskDeque));
+    if (pool.deques == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the task deques.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int t = 0; t < thread_count; t++) {
+        pthread_mutex_init(&pool.deques[t].mutex, NULL);
+        pool.deques[t].top = 0;
+        pool.deques[t].bottom = 0;
+    }
+    pthread_mutex_init(&pool.mutex, NULL);
+    pthread_cond_init(&pool.work_available, NULL);
+    pthread_cond_init(&pool.work_done, NULL);
+    pthread_mutex_init(&pool.submit_mutex, NULL);
+    pool.generation = 0;
+    pool.busy = 0;
+    atomic_init(&pool.remaining, 0);
+
+    // the calling thread is thread 0, the worker threads sleep until the first loop starts
+    pool.thread_count = 1;
+    for (int t = 1; t < thread_count; t++) {
+        pthread_t thread;
+        if (pthread_create(&thread, NULL, taskWorker, (void *) (intptr_t) t) != 0) {
+            fprintf(stderr, "Could only start %d of %d threads\n", t, thread_count);
+            break;
+        }
+        pthread_detach(thread);
+        pool.thread_count++;
+    }
+
+    atomic_store(&pool_ready, 1);
+    pthread_mutex_unlock(&pool_init_mutex);
+}
+
+// Function to get the number of threads in the pool, which starts the pool if it is not running yet
+int taskThreadCount(void) {
+    if (!atomic_load(&pool_ready)) {
+        initializeTaskPool(0);
+    }
+    return pool.thread_count;
+}
+
+// Function to run task over the iterations begin to end - 1 on all threads of the pool and wait for it to finish.
+// Every thread starts with an equal share and steals from the others once it is done, no chunk gets smaller than
+// min_chunk iterations. Loops of at most min_chunk iterations and loops started inside another loop run on the
+// calling thread.
+void parallelFor(const int begin, const int end, int min_chunk, const RangeTask task, void *context) {
+    if (end <= begin) {
+        return;
+    }
+    if (current_worker >= 0) {
+        task(context, begin, end, current_worker);
+        return;
+    }
+
+    const int thread_count = taskThreadCount();
+    const int count = end - begin;
+    if (min_chunk < 1) {
+        min_chunk = 1;
+    }
+    if (thread_count == 1 || count <= min_chunk) {
+        current_worker = 0;
+        task(context, begin, end, 0);
+        current_worker = -1;
+        return;
+    }
+
+    pthread_mutex_lock(&pool.submit_mutex);
+    pthread_mutex_lock(&pool.mutex);
+
+    // a worker thread that woke up late can still be inside the previous loop
+    while (pool.busy > 0) {
+        pthread_cond_wait(&pool.work_done, &pool.mutex);
+    }
+
+    pool.task = task;
+    pool.context = context;
+    pool.grain = count / (thread_count * CHUNKS_PER_THREAD);
+    if (pool.grain < min_chunk) {
+        pool.grain = min_chunk;
+    }
+    atomic_store(&pool.remaining, count);
+
+    // hand every thread an equal share to start with
+    for (int t = 0; t < thread_count; t++) {
+        TaskDeque *deque = &pool.deques[t];
+        const int share_begin = begin + (int) ((long) count * t / thread_count);
+        const int share_end = begin + (int) ((long) count * (t + 1) / thread_count);
+        pthread_mutex_lock(&deque->mutex);
+        deque->top = 0;
+        deque->bottom = 0;
+        if (share_end > share_begin) {
+            deque->ranges[deque->bottom++] = (TaskRange) {share_begin, share_end};
+        }
+        pthread_mutex_unlock(&deque->mutex);
+    }
+
+    pool.generation++;
+    pthread_cond_broadcast(&pool.work_available);
+    pthread_mutex_unlock(&pool.mutex);
+
+    // work on the loop as thread 0
+    current_worker = 0;
+    runTasks(0);
+    current_worker = -1;
+
+    // wait until no worker thread touches the loop anymore
+    pthread_mutex_lock(&pool.mutex);
+    while (pool.busy > 0) {
+        pthread_cond_wait(&pool.work_done, &pool.mutex);
+    }
+    pthread_mutex_unlock(&pool.mutex);
+    pthread_mutex_unlock(&pool.submit_mutex);
+}
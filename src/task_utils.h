@@ -0,0 +1,13 @@
+#ifndef TASK_UTILS_H
+#define TASK_UTILS_H
+
+// Define the function type that processes the iterations begin to end - 1 of a parallel loop.
+// worker_id lies between 0 and taskThreadCount() - 1 and can be used to index per-thread data.
+typedef void (*RangeTask)(void *context, int begin, int end, int worker_id);
+
+// Task functions
+void initializeTaskPool(int thread_count);
+int taskThreadCount(void);
+void parallelFor(int begin, int end, int min_chunk, RangeTask task, void *context);
+
+#endif //TASK_UTILS_H
@@ -0,0 +1,369 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <float.h>  // For FLT_MAX
+
+#include "threaded_utils.h"
+#include "bucket_utils.h"  // Include Bucket functions
+#include "task_utils.h"  // Include parallelFor function
+#include "parallel_utils.h"  // For FIXED_INF
+
+#define INF FLT_MAX
+
+#define MIN_PHASE_CHUNK 64  // Smallest number of nodes a thread takes at once, smaller phases run on the calling thread
+#define INITIAL_BIN_CAPACITY 256  // Number of nodes every insertion bin can hold before it grows the first time
+
+// Define a growable list of the nodes one thread improved during a phase
+typedef struct {
+    int *nodes;
+    int size;
+    int capacity;
+} InsertionBin;
+
+// Define a struct holding everything the threads of one search share
+typedef struct {
+    // the flattened graph
+    int vertices;
+    int edge_count;
+    const int* edges_start;
+    const int* light_end;
+    const int* edge_destinations;
+    const float* edge_weights;
+    const uint32_t* fixed_weights;  // fixed-point weights in millimetres, NULL for float distances
+
+    // label[i] holds the distance of node i in the upper and its previous node in the lower 32 bits
+    _Atomic uint64_t* labels;
+
+    // the phase that is relaxed at the moment
+    const int* phase_nodes;
+    int heavy;  // 0 to relax the light edges, 1 for the heavy edges
+
+    RelaxKernel kernel;  // finds the edges of a node that may be shorter
+    float delta;  // bucket width of the float distances
+    uint32_t fixed_delta;  // bucket width of the fixed-point distances
+    float limit;  // nodes further away are never put into a bucket
+    int thread_count;
+    InsertionBin* bins;  // one bin per thread of the task pool
+} ThreadedSearch;
+
+// Function to pack a distance and a previous node into one label.
+// Distances are never negative, so the bits of the float grow with its value and two labels compare like their distances.
+uint64_t packLabel(const float distance, const int previous) {
+    uint32_t distance_bits;
+    memcpy(&distance_bits, &distance, sizeof(distance_bits));
+    return ((uint64_t) distance_bits << 32) | (uint32_t) previous;
+}
+
+// Function to get the distance of a label
+float labelDistance(const uint64_t label) {
+    const uint32_t distance_bits = (uint32_t) (label >> 32);
+    float distance;
+    memcpy(&distance, &distance_bits, sizeof(distance));
+    return distance;
+}
+
+// Function to pack a fixed-point distance in millimetres and a previous node into one label
+uint64_t packFixedLabel(const uint32_t distance, const int previous) {
+    return ((uint64_t) distance << 32) | (uint32_t) previous;
+}
+
+// Function to get the fixed-point distance of a label
+uint32_t labelFixedDistance(const uint64_t label) {
+    return (uint32_t) (label >> 32);
+}
+
+// Function to get the previous node of a label
+int labelPrevious(const uint64_t label) {
+    return (int) (uint32_t) label;
+}
+
+// Function to append a node to an insertion bin, growing the bin geometrically if necessary
+static void addNodeToBin(InsertionBin* bin, const int node) {
+    if (bin->size == bin->capacity) {
+        bin->capacity *= 2;
+        bin->nodes = (int *)realloc(bin->nodes, bin->capacity * sizeof(int));
+        if (bin->nodes == NULL) {
+            fprintf(stderr, "Error: Unable to reallocate memory for the insertion bins.\n");
+            exit(EXIT_FAILURE);
+        }
+    }
+    bin->nodes[bin->size++] = node;
+}
+
+// Function to lower the label of destination to new_dist if that is shorter, without a lock.
+// The compare-and-swap fails if another thread changed the label in the meantime, then the new label is compared again.
+static void relaxLabel(ThreadedSearch* search, InsertionBin* bin, const int node, const int destination, const float new_dist) {
+    _Atomic uint64_t* label = &search->labels[destination];
+    const uint64_t new_label = packLabel(new_dist, node);
+
+    uint64_t current = atomic_load_explicit(label, memory_order_relaxed);
+    while (new_dist < labelDistance(current)) {
+        if (atomic_compare_exchange_weak_explicit(label, &current, new_label, memory_order_relaxed, memory_order_relaxed)) {
+            // the bucket is derived from the final distance when the bins are merged
+            addNodeToBin(bin, destination);
+            return;
+        }
+    }
+}
+
+// Function to lower the fixed-point label of destination to new_dist if that is shorter, like relaxLabel
+static void relaxFixedLabel(ThreadedSearch* search, InsertionBin* bin, const int node, const int destination, const uint32_t new_dist) {
+    _Atomic uint64_t* label = &search->labels[destination];
+    const uint64_t new_label = packFixedLabel(new_dist, node);
+
+    uint64_t current = atomic_load_explicit(label, memory_order_relaxed);
+    while (new_dist < labelFixedDistance(current)) {
+        if (atomic_compare_exchange_weak_explicit(label, &current, new_label, memory_order_relaxed, memory_order_relaxed)) {
+            addNodeToBin(bin, destination);
+            return;
+        }
+    }
+}
+
+// Function to get the bucket of a label, -1 if it is beyond the limit
+static int labelBucket(const ThreadedSearch* search, const uint64_t label) {
+    if (search->fixed_weights != NULL) {
+        return (int) (labelFixedDistance(label) / search->fixed_delta);
+    }
+    const float distance = labelDistance(label);
+    return distance <= search->limit ? (int) (distance / search->delta) : -1;
+}
+
+// Function to check if the distance of a label is at most the start of bucket bucket_id
+static int labelBefore(const ThreadedSearch* search, const uint64_t label, const int bucket_id) {
+    if (search->fixed_weights != NULL) {
+        return labelFixedDistance(label) <= (uint64_t) bucket_id * search->fixed_delta;
+    }
+    return labelDistance(label) <= bucket_id * search->delta;
+}
+
+// Function to relax either the light or the heavy edges of the nodes phase_nodes[first] to phase_nodes[last - 1]
+static void relaxPhaseNodes(void* context, const int first, const int last, const int worker_id) {
+    ThreadedSearch* search = context;
+    InsertionBin* bin = &search->bins[worker_id];
+
+    for (int i = first; i < last; i++) {
+        const int node = search->phase_nodes[i];
+        const uint64_t node_label = atomic_load_explicit(&search->labels[node], memory_order_relaxed);
+
+        // light edges range from the start of the node edges to light_end, heavy edges from there to the next node
+        const int edge_end = (node == search->vertices - 1) ? search->edge_count : search->edges_start[node + 1];
+        const int edge_begin = search->heavy ? search->light_end[node] : search->edges_start[node];
+        const int edge_stop = search->heavy ? edge_end : search->light_end[node];
+
+        // fixed-point sums are compared one edge at a time, they can't wrap around
+        if (search->fixed_weights != NULL) {
+            const uint32_t node_dist = labelFixedDistance(node_label);
+            for (int edge = edge_begin; edge < edge_stop; edge++) {
+                const uint64_t new_dist = (uint64_t) node_dist + search->fixed_weights[edge];
+                if (new_dist < FIXED_INF) {
+                    relaxFixedLabel(search, bin, node, search->edge_destinations[edge], (uint32_t) new_dist);
+                }
+            }
+            continue;
+        }
+        const float node_dist = labelDistance(node_label);
+
+        // the kernel only preselects the edges, the compare-and-swap still decides for every edge it finds
+        for (int first = edge_begin; first < edge_stop; first += RELAX_WIDTH) {
+            const int count = (edge_stop - first < RELAX_WIDTH) ? edge_stop - first : RELAX_WIDTH;
+            uint32_t mask = search->kernel((const void*) search->labels, DISTANCE_LABELS, search->edge_destinations + first,
+                                           search->edge_weights + first, count, node_dist);
+            while (mask != 0) {
+                const int edge = first + __builtin_ctz(mask);
+                mask &= mask - 1;
+                relaxLabel(search, bin, node, search->edge_destinations[edge], node_dist + search->edge_weights[edge]);
+            }
+        }
+    }
+}
+
+// Function to relax one phase on the threads of the task pool, which balance the nodes of different degree by stealing.
+// Afterwards the nodes of all insertion bins are moved into the bucket of their final distance.
+// Nodes beyond the limit keep their distance but are never relaxed.
+static void runPhase(
+        ThreadedSearch* search,
+        BucketsArray* bucketsArray,
+        const int* phase_nodes,
+        const int phase_size,
+        const int heavy) {
+
+    search->phase_nodes = phase_nodes;
+    search->heavy = heavy;
+
+    parallelFor(0, phase_size, MIN_PHASE_CHUNK, relaxPhaseNodes, search);
+
+    // merge the bins, a node improved by several threads ends up in its bucket only once
+    for (int t = 0; t < search->thread_count; t++) {
+        InsertionBin* bin = &search->bins[t];
+        for (int i = 0; i < bin->size; i++) {
+            const int node = bin->nodes[i];
+            const int bucket = labelBucket(search, atomic_load_explicit(&search->labels[node], memory_order_relaxed));
+            if (bucket != -1) {
+                addNodeToBucket(bucketsArray, bucket, node);
+            }
+        }
+        bin->size = 0;
+    }
+}
+
+// Function to run the Delta-Stepping of a prepared search on the threads of the task pool. It stops once dest_index is
+// settled, pass -1 to settle every node. The buckets are sized from the largest weight and the width of the mode.
+static void runThreadedSearch(
+        ThreadedSearch* search,
+        const float bucket_max_weight,
+        const float bucket_delta,
+        const int start_index,
+        const int dest_index) {
+
+    const int vertices = search->vertices;
+
+    // settled[i] is set once node i was taken out of its final bucket
+    char* settled = calloc(vertices, sizeof(char));
+
+    // the nodes of the current phase and the nodes settled in the current bucket
+    int* phase_nodes = malloc(vertices * sizeof(int));
+    int* settled_nodes = malloc(vertices * sizeof(int));
+    if (settled == NULL || phase_nodes == NULL || settled_nodes == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the threaded search.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    // Initialize all distances as INFINITE and previous as -1, the distance of the source from itself is always 0
+    const uint64_t unreached = search->fixed_weights != NULL ? packFixedLabel(FIXED_INF, -1) : packLabel(INF, -1);
+    for (int i = 0; i < vertices; i++) {
+        atomic_init(&search->labels[i], unreached);
+    }
+    atomic_init(&search->labels[start_index], search->fixed_weights != NULL ? packFixedLabel(0, -1) : packLabel(0, -1));
+
+    // Set up one insertion bin per thread
+    const int thread_count = search->thread_count;
+    search->bins = malloc(thread_count * sizeof(InsertionBin));
+    if (search->bins == NULL) {
+        fprintf(stderr, "Error: Unable to allocate memory for the insertion bins.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int t = 0; t < thread_count; t++) {
+        search->bins[t].nodes = malloc(INITIAL_BIN_CAPACITY * sizeof(int));
+        if (search->bins[t].nodes == NULL) {
+            fprintf(stderr, "Error: Unable to allocate memory for the insertion bins.\n");
+            exit(EXIT_FAILURE);
+        }
+        search->bins[t].size = 0;
+        search->bins[t].capacity = INITIAL_BIN_CAPACITY;
+    }
+
+    // Create the cyclic buckets, no edge reaches further than max_weight / delta buckets ahead
+    BucketsArray bucketsArray;
+    initializeBuckets(&bucketsArray, vertices, bucket_max_weight, bucket_delta);
+
+    // Add the start node to the first bucket
+    addNodeToBucket(&bucketsArray, 0, start_index);
+
+    // run a loop over every bucket, only nodes within the limit are put into the buckets
+    int bucket_id = 0;
+    while (bucket_id != -1) {
+        // Stop once the destination is settled, every node left has a distance of at least bucket_id * delta
+        if (dest_index != -1 && labelBefore(search, atomic_load(&search->labels[dest_index]), bucket_id)) {
+            break;
+        }
+
+        // Relax the light edges in phases until no node is added to the current bucket anymore
+        int settled_count = 0;
+        int phase_size;
+        while ((phase_size = takeBucketNodes(&bucketsArray, phase_nodes)) > 0) {
+            // nodes can be relaxed in several phases, but they are settled only once
+            for (int i = 0; i < phase_size; i++) {
+                if (!settled[phase_nodes[i]]) {
+                    settled[phase_nodes[i]] = 1;
+                    settled_nodes[settled_count++] = phase_nodes[i];
+                }
+            }
+
+            runPhase(search, &bucketsArray, phase_nodes, phase_size, 0);
+        }
+
+        // Relax the heavy edges of the settled nodes once, they only lead to later buckets
+        runPhase(search, &bucketsArray, settled_nodes, settled_count, 1);
+
+        bucket_id = nextBucket(&bucketsArray);
+    }
+
+    // Free the insertion bins
+    for (int t = 0; t < thread_count; t++) {
+        free(search->bins[t].nodes);
+    }
+    free(search->bins);
+
+    // Free each bucket's allocated memory
+    freeBuckets(&bucketsArray);
+
+    free(settled);
+    free(phase_nodes);
+    free(settled_nodes);
+}
+
+// Multi-threaded Delta-Stepping algorithm. labels[i] receives the distance from the start to i and the previous node
+// on the path. It stops once dest_index is settled, pass -1 to settle every node. Only nodes up to limit are settled,
+// the labels of nodes beyond it are not final, pass INF to search the whole graph.
+void threadedDeltaStepping(
+        const int vertices,
+        const int edge_count,
+        const int* edges_start,
+        const int* light_end,
+        const float delta,
+        const float max_weight,
+        const int* edge_destinations,
+        const float* edge_weights,
+        const RelaxKernel kernel,
+        const int start_index,
+        const int dest_index,
+        const float limit,
+        _Atomic uint64_t* labels) {
+
+    ThreadedSearch search = {
+        .vertices = vertices,
+        .edge_count = edge_count,
+        .edges_start = edges_start,
+        .light_end = light_end,
+        .edge_destinations = edge_destinations,
+        .edge_weights = edge_weights,
+        .labels = labels,
+        .kernel = kernel,
+        .delta = delta,
+        .limit = limit,
+        .thread_count = taskThreadCount()
+    };
+    runThreadedSearch(&search, max_weight, delta, start_index, dest_index);
+}
+
+// Multi-threaded Delta-Stepping algorithm on fixed-point distances in millimetres. labels[i] receives the distance
+// packed with packFixedLabel. The sums are exact integers, so it finds the same distances as the serial fixed-point
+// versions no matter in which order the threads relax the edges.
+void threadedFixedDeltaStepping(
+        const int vertices,
+        const int edge_count,
+        const int* edges_start,
+        const int* light_end,
+        const uint32_t delta,
+        const uint32_t max_weight,
+        const int* edge_destinations,
+        const uint32_t* fixed_weights,
+        const int start_index,
+        const int dest_index,
+        _Atomic uint64_t* labels) {
+
+    ThreadedSearch search = {
+        .vertices = vertices,
+        .edge_count = edge_count,
+        .edges_start = edges_start,
+        .light_end = light_end,
+        .edge_destinations = edge_destinations,
+        .fixed_weights = fixed_weights,
+        .labels = labels,
+        .fixed_delta = delta,
+        .limit = INF,
+        .thread_count = taskThreadCount()
+    };
+    runThreadedSearch(&search, (float) max_weight, (float) delta, start_index, dest_index);
+}
@@ -0,0 +1,46 @@
+#ifndef THREADED_UTILS_H
+#define THREADED_UTILS_H
+
+#include <stdint.h>
+#include <stdatomic.h>
+
+#include "simd_utils.h"  // For RelaxKernel
+
+#define PHASE_COST_PER_THREAD 64.0f  // Number of edge relaxations a thread could do in the time a phase takes to start
+
+// Label functions, a label holds the distance of a node in the upper and its previous node in the lower 32 bits
+uint64_t packLabel(const float distance, const int previous);
+float labelDistance(const uint64_t label);
+int labelPrevious(const uint64_t label);
+uint64_t packFixedLabel(const uint32_t distance, const int previous);
+uint32_t labelFixedDistance(const uint64_t label);
+
+// Threaded Delta-Stepping functions
+void threadedDeltaStepping(
+    const int vertices,
+    const int edge_count,
+    const int* edges_start,
+    const int* light_end,
+    const float delta,
+    const float max_weight,
+    const int* edge_destinations,
+    const float* edge_weights,
+    const RelaxKernel kernel,
+    const int start_index,
+    const int dest_index,
+    const float limit,
+    _Atomic uint64_t* labels);
+void threadedFixedDeltaStepping(
+    const int vertices,
+    const int edge_count,
+    const int* edges_start,
+    const int* light_end,
+    const uint32_t delta,
+    const uint32_t max_weight,
+    const int* edge_destinations,
+    const uint32_t* fixed_weights,
+    const int start_index,
+    const int dest_index,
+    _Atomic uint64_t* labels);
+
+#endif //THREADED_UTILS_H